@@ -0,0 +1,132 @@
+/* lb-async.h
+ *
+ * ========LICENCE========
+ * This file is part of the library LinBox.
+ *
+  * LinBox is free software: you can redistribute it and/or modify
+ * it under the terms of the  GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.	 See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ * ========LICENCE========
+ */
+
+#ifndef __LINBOX_lb_async_H
+#define __LINBOX_lb_async_H
+
+#include <future>
+#include <memory>
+#include <functional>
+#include <exception>
+
+#include <lb-utilities.h>
+#include <lb-element-collection.h>
+#include <lb-blackbox-collection.h>
+
+
+/*********************************************************
+ * Asynchronous driver: the jobs run on a pool of worker *
+ * threads and deliver their results through futures     *
+ *********************************************************/
+
+// definition of a job key
+typedef size_t JobKey;
+
+// limits of a job
+struct JobLimits {
+	double wait;   // seconds the job may stay queued, after which it fails unstarted; 0 for no limit
+	size_t bytes;  // memory accounted to the job in the budget of the pool; 0 to estimate it from the blackbox
+
+	JobLimits(double w = 0., size_t b = 0) : wait(w), bytes(b) {}
+};
+
+
+/*************************************************************
+ * API to start the pool of the asynchronous driver          *
+ * threads: number of workers, 0 for the number of cores     *
+ * budget : bytes of the jobs running together, 0 for none   *
+ * pending: jobs queued or running at most, 0 for no limit   *
+ *************************************************************/
+void LinBoxAsyncInit(size_t threads = 0, size_t budget = 0, size_t pending = 0);
+
+
+/**************************************************
+ * API to wait for all the jobs and stop the pool *
+ **************************************************/
+void LinBoxAsyncEnd();
+
+
+/*****************************************************************
+ * API to cancel a queued job, which fails with lb_runtime_error *
+ * and leaves the queue at once, as does a job past its waiting  *
+ * limit; false if it has already started or finished: a running *
+ * computation is not interrupted                                *
+ *****************************************************************/
+bool lb_cancel(const JobKey &job);
+
+
+/***************************************************
+ * API to get the number of jobs queued or running *
+ ***************************************************/
+size_t lb_pending_jobs();
+
+
+/**************************************************************
+ * API to queue a job: run() is called by a worker, or fail() *
+ * with the reason why the job will not run                   *
+ **************************************************************/
+JobKey submitJob(size_t bytes, const JobLimits &limits,
+		 const std::function<void()> &run,
+		 const std::function<void(std::exception_ptr)> &fail);
+
+
+/***********************************************************
+ * API to run any computation of the driver asynchronously *
+ ***********************************************************/
+template<class T>
+std::future<T> lb_async(JobKey &job, const std::function<T()> &f, size_t bytes = 0, const JobLimits &limits = JobLimits()) {
+	std::shared_ptr<std::promise<T> > result(new std::promise<T>);
+	std::future<T> future = result->get_future();
+	job = submitJob(bytes, limits,
+			[result, f] () {
+				try { result->set_value(f()); }
+				catch (...) { result->set_exception(std::current_exception()); }
+			},
+			[result] (std::exception_ptr e) { result->set_exception(e); });
+	return future;
+}
+
+
+/*******************************************
+ * API for asynchronous rank computation   *
+ * job is the key to cancel the job        *
+ *******************************************/
+std::future<unsigned long> lb_rank_async(JobKey &job, const BlackboxKey &key, const JobLimits &limits = JobLimits());
+std::future<unsigned long> lb_rank_async(const BlackboxKey &key, const JobLimits &limits = JobLimits());
+
+
+/******************************************************
+ * API for asynchronous determinant computation       *
+ * the future delivers the key of the element result  *
+ ******************************************************/
+std::future<EltKey> lb_determinant_async(JobKey &job, const BlackboxKey &key, const JobLimits &limits = JobLimits());
+std::future<EltKey> lb_determinant_async(const BlackboxKey &key, const JobLimits &limits = JobLimits());
+
+
+#endif
+
+// Local Variables:
+// mode: C++
+// tab-width: 4
+// indent-tabs-mode: nil
+// c-basic-offset: 4
+// End:
+// vim:sts=4:sw=4:ts=4:et:sr:cino=>s,f0,{0,g0,(0,\:0,t0,+0,=s
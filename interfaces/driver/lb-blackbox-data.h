@@ -283,6 +283,7 @@ BlackboxAbstract* constructBlackbox_from_stream (const DomainKey &k, std::istrea
  * Function to add an abstract blackbox in linbox hashtable *
  ************************************************************/
 const BlackboxKey& addBlackbox(BlackboxAbstract * v){
+	DriverLock lock;
 
 	std::pair<BlackboxTable::const_iterator, bool> status;
 	status = blackbox_hashtable.insert(std::pair<BlackboxKey, BlackboxAbstract*> (BlackboxKey(v), v));
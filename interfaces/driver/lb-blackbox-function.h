@@ -28,6 +28,7 @@
 
 #include <lb-blackbox-abstract.h>
 #include <lb-blackbox-functor.h>
+#include <lb-garbage.h>
 
 
 /***********************************************************
@@ -50,14 +51,22 @@ public:
 		call(dumbresult,v,f);
 	}
 
-	// call a functor over a blackbox from its key, result is given through 1st parameter
+	// call a functor over a blackbox from its key, result is given through 1st parameter;
+	// the blackbox is pinned, and the lock released unless the caller holds it, during the call
 	template<class Functor, class Result>
 	static void call(Result &res, const BlackboxKey &key, const Functor &functor){
-		BlackboxTable::const_iterator it = blackbox_hashtable.find(key);
-		if (it != blackbox_hashtable.end())
-			BlackboxFunction::call(res, *it, functor);
-		else
-			throw lb_runtime_error("LinBox ERROR: use of a non allocated blackbox \n");// throw an exception
+		PinnedObject pin;
+		BlackboxAbstract *B;
+		{
+			DriverLock lock;
+			BlackboxTable::const_iterator it = blackbox_hashtable.find(key);
+			if (it == blackbox_hashtable.end())
+				throw lb_runtime_error("LinBox ERROR: use of a non allocated blackbox \n");// throw an exception
+			B = it->second;
+			pin.pin(B);
+		}
+		const std::pair<const BlackboxKey, BlackboxAbstract*> blackbox(key, B);
+		BlackboxFunction::call(res, blackbox, functor);
 	}
 
 	// call a functor over a blackbox from its key, no result
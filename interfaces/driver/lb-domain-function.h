@@ -28,6 +28,7 @@
 
 #include <lb-domain-abstract.h>
 #include <lb-domain-functor.h>
+#include <lb-garbage.h>
 
 
 /*********************************************************
@@ -55,6 +56,7 @@ public:
 	// call a functor over a domain from its key, result is given through 1st parameter
 	template <class Functor, class Result>
 	static void call (Result &res, const DomainKey &key, const Functor &functor){
+		DriverLock lock;
 		DomainTable::iterator it = domain_hashtable.find(key);
 		if (it != domain_hashtable.end())
 			DomainFunction::call(res, *it, functor);
@@ -40,6 +40,8 @@
 #include <lb-charpoly.h>
 #include <lb-solve.h>
 
+#include <lb-async.h>
+
 // overload PreconditionFailed to be a real exception
 std::ostringstream PrecondStream;
 void initException(){
@@ -62,6 +64,7 @@ int LinBoxInit(){
  * Close the LinBox Driver *
  ***************************/
 int LinBoxEnd(){
+	LinBoxAsyncEnd();
 	LinBoxCollect();
 	return 0;
 }
@@ -77,12 +80,14 @@ void LinBoxDataInfo(std::ostringstream &out){
 	extern VectorTable        vector_hashtable;
 	extern EltTable          element_hashtable;
 
+	DriverLock lock;
 
 	out<<"LinBox Driver active Data:\n"
 	   <<"   - Domain    : "<<domain_hashtable.size()<<"\n"
 	   <<"   - Element   : "<<element_hashtable.size()<<"\n"
 	   <<"   - Blackbox  : "<<blackbox_hashtable.size()<<"\n"
 	   <<"   - Vector    : "<<vector_hashtable.size()<<"\n"
+	   <<"   - Job       : "<<lb_pending_jobs()<<"\n"
 	   <<"\n";
 }
 
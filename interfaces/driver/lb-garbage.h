@@ -26,11 +26,46 @@
 #define __LINBOX_lb_garbage_H
 
 
+#include <mutex>
 #include <lb-domain-collection.h>
 #include <lb-blackbox-collection.h>
 #include <lb-vector-collection.h>
 #include <lb-element-collection.h>
 
+/*************************************************************
+ * Lock on the tables of the driver, taken by each API call; *
+ * recursive, as API calls use each other                    *
+ *************************************************************/
+std::recursive_mutex& driverMutex();
+
+class DriverLock : public std::lock_guard<std::recursive_mutex> {
+public:
+	DriverLock() : std::lock_guard<std::recursive_mutex>(driverMutex()) {}
+};
+
+/************************************************************
+ * API to keep an object alive while a computation uses it  *
+ * without the lock: deleting a pinned object removes its   *
+ * key at once, and the object when its last pin is dropped *
+ ************************************************************/
+void pinObject(const void *p);
+void unpinObject(const void *p);
+
+class PinnedObject {
+	const void *obj;
+	PinnedObject(const PinnedObject&);
+	PinnedObject& operator=(const PinnedObject&);
+public:
+	PinnedObject(const void *p = 0) : obj(0) { pin(p); }
+	~PinnedObject() { if (obj) unpinObject(obj); }
+
+	void pin(const void *p) {
+		if (obj) unpinObject(obj);
+		obj = p;
+		if (obj) pinObject(obj);
+	}
+};
+
 /***************************************
  * API to delete a domain from ist key *
  ***************************************/
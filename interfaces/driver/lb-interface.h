@@ -38,6 +38,8 @@
 #include <lb-charpoly.h>
 #include <lb-solve.h>
 
+#include <lb-async.h>
+
 // overload PreconditionFailed to be a real exception
 std::ostringstream PrecondStream;
 void initException(){
@@ -59,6 +61,7 @@ void LinBoxInit(){
  * Close the LinBox Driver *
  ***************************/
 void LinBoxEnd(){
+	LinBoxAsyncEnd();
 	LinBoxCollect();
 }
 
@@ -28,6 +28,7 @@
 
 #include <lb-vector-abstract.h>
 #include <lb-vector-functor.h>
+#include <lb-garbage.h>
 
 
 /*********************************************************
@@ -53,6 +54,7 @@ public:
 	// call a functor over a vector from its key, result is given through 1st parameter
 	template<class Functor, class Result>
 	static void call(Result &res, const VectorKey &key, const Functor &functor){
+		DriverLock lock;
 		VectorTable::const_iterator it = vector_hashtable.find(key);
 		if (it != vector_hashtable.end())
 			VectorFunction::call(res, *it, functor);
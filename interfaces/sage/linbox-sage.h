@@ -28,15 +28,20 @@
 #define __LINBOX_sage_H
 
 #include <stddef.h>
+#include <stdint.h>
 
+#ifdef __cplusplus
 #include <cstdlib>
 #include <vector>
+#endif
 
 #ifdef __cplusplus
 #define EXTERN extern "C"
 #else
 #define EXTERN
 #endif
+
+#ifdef __cplusplus
 /*****************************************************************
 
   Sparse over Z/nZ
@@ -53,6 +58,60 @@ unsigned long linbox_modn_sparse_matrix_rank(unsigned int modulus,
 std::vector<unsigned int> linbox_modn_sparse_matrix_solve (unsigned int modulus, size_t numrows,
 						     size_t numcols, void *a, void *b,
 						     int method);
+#endif
+
+/*****************************************************************
+
+  Sparse over Z/pZ from CSR arrays owned by the caller
+
+  The arrays are read in place, never copied nor written, by the
+  Wiedemann method; the elimination, which works in place, copies
+  them first.  p is a prime below 2^31, the values are reduced
+  modulo p.  The functions return LINBOX_CSR_OK, or an error code
+  without writing the result.  The batched functions process the
+  matrices concurrently when LinBox is built with OpenMP, store the
+  code of each matrix in status, if not NULL, and return the number
+  of matrices that failed.
+
+*****************************************************************/
+
+/* type of the values of a linbox_csr_matrix */
+#define LINBOX_CSR_UINT32      0
+#define LINBOX_CSR_UINT64      1
+#define LINBOX_CSR_DOUBLE      2
+
+/* methods */
+#define LINBOX_CSR_ELIMINATION 0
+#define LINBOX_CSR_WIEDEMANN   1
+
+/* return codes */
+#define LINBOX_CSR_OK          0
+#define LINBOX_CSR_EINVAL     -1 /* invalid modulus, type, method, dimensions, offsets or columns */
+#define LINBOX_CSR_EFAIL      -2 /* the computation failed, e.g. an inconsistent system */
+
+struct linbox_csr_matrix {
+	size_t rows, cols;
+	const size_t *start;  /* rows+1 non decreasing offsets of the rows in colid and values */
+	const size_t *colid;  /* column of each entry, below cols; repeated columns add up */
+	const void *values;   /* value of each entry, of type type */
+	int type;
+};
+
+EXTERN int linbox_csr_rank (uint64_t p, const struct linbox_csr_matrix *A, int method, unsigned long *rank);
+
+EXTERN int linbox_csr_det (uint64_t p, const struct linbox_csr_matrix *A, int method, uint64_t *det);
+
+/* a solution x (of A->cols entries) of Ax = b (of A->rows entries) */
+EXTERN int linbox_csr_solve (uint64_t p, const struct linbox_csr_matrix *A, const uint64_t *b, uint64_t *x, int method);
+
+EXTERN size_t linbox_csr_rank_batch (uint64_t p, size_t count, const struct linbox_csr_matrix *A, int method,
+				     unsigned long *rank, int *status);
+
+EXTERN size_t linbox_csr_det_batch (uint64_t p, size_t count, const struct linbox_csr_matrix *A, int method,
+				    uint64_t *det, int *status);
+
+EXTERN size_t linbox_csr_solve_batch (uint64_t p, size_t count, const struct linbox_csr_matrix *A,
+				      const uint64_t *const *b, uint64_t *const *x, int method, int *status);
 
 #endif // __LINBOX_SAGE_H
 
@@ -47,14 +47,16 @@
 #include "linbox/matrix/matrix-domain.h"
 #include "linbox/matrix/matrix-domain.h"
 
-// #include "linbox/blackbox/triplesbb-omp.h"
 #include "linbox/matrix/sparse-matrix.h"
-#include "linbox/blackbox/pascal.h"
+#include "linbox/blackbox/block-apply.h"
 
 namespace LinBox
 {
 
-//Temporary fix to deal with the fact that not all Blackboxes have applyLeft()
+/** Block product \f$M_1 = M_2 M_3\f$ with a blackbox \f$M_2\f$.
+ * Uses the native block apply of the blackbox when it has one (see
+ * BlockApplyTraits), one \c apply per column otherwise.
+ */
 template<class Field,class Block>
 class MulHelper {
 public:
@@ -65,28 +67,7 @@ public:
 		linbox_check( M2.coldim() == M3.rowdim());
 		linbox_check( M1.coldim() == M3.coldim());
 
-		MatrixDomain<Field> MD(F);
-		typename Block::ColIterator        p1 = M1.colBegin();
-		typename Block::ConstColIterator   p3 = M3.colBegin();
-
-		for (; p3 != M3.colEnd(); ++p1,++p3) {
-			M2.apply(*p1,*p3);
-		}
-	}
-
-	static void mul (const Field& F,
-			 Block &M1, const SparseMatrix<Field,SparseMatrixFormat::TPL> &M2, const Block& M3) {
-		M2.applyLeft(M1,M3);
-	}
-
-	static void mul (const Field& F,
-			 Block &M1, const SparseMatrix<Field,SparseMatrixFormat::TPL_omp> &M2, const Block& M3) {
-		M2.applyLeft(M1,M3);
-	}
-
-	static void mul (const Field& F,
-	                 Block &M1, const PascalBlackbox<Field> &M2, const Block& M3) {
-		M2.applyLeft(M1,M3);
+		BlockApplyTraits<Blackbox>::apply(M1,M2,M3);
 	}
 };
 
@@ -0,0 +1,266 @@
+/* linbox/algorithms/blackbox-block-container-pipelined.h
+ *
+ * ========LICENCE========
+ * This file is part of the library LinBox.
+ *
+  * LinBox is free software: you can redistribute it and/or modify
+ * it under the terms of the  GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.	 See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ * ========LICENCE========
+ */
+
+/*! @file algorithms/blackbox-block-container-pipelined.h
+ * @ingroup algorithms
+ * @brief Block Krylov sequence \f$U A^i V\f$ produced ahead of the consumer by a pool of threads.
+ */
+
+#ifndef __LINBOX_blackbox_block_container_pipelined_H
+#define __LINBOX_blackbox_block_container_pipelined_H
+
+#include <ctime>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <exception>
+
+#include "linbox/linbox-config.h"
+#include "linbox/util/debug.h"
+#include "linbox/util/error.h"
+
+#include "linbox/algorithms/blackbox-block-container-base.h"
+#include "linbox/matrix/dense-matrix.h"
+#include "linbox/matrix/matrix-domain.h"
+
+namespace LinBox
+{
+
+	/*! @brief Pipelined block sequence \f$U A^i V\f$.
+	 *
+	 * The columns of \f$V\f$ are split into contiguous slices, one per
+	 * worker thread.  Worker \f$j\f$ iterates \f$V_j \leftarrow A V_j\f$
+	 * and writes \f$U V_j\f$ into the matching columns of a ring of
+	 * \c lookahead sequence slots, while the consumer (typically
+	 * BlockCoppersmithDomain::right_minpoly, which is an online algorithm)
+	 * reads the completed slots in order.  Sequence generation and generator
+	 * computation therefore overlap, and the workers never run more than
+	 * \c lookahead elements ahead of the consumer.
+	 *
+	 * The workers stop when the container is destroyed or stop() is called,
+	 * so an early terminated generator computation does not pay for the
+	 * remainder of the sequence.
+	 *
+	 * @warning the blackbox \c apply must be reentrant: it is called
+	 * concurrently from several threads on the same (const) object.  This
+	 * holds for the SparseMatrix formats, not for blackboxes holding mutable
+	 * temporaries such as Compose.
+	 */
+	template<class _Field, class _Blackbox>
+	class BlackboxBlockContainerPipelined : public BlackboxBlockContainerBase<_Field,_Blackbox> {
+	public:
+		typedef _Field                         Field;
+		typedef typename Field::Element      Element;
+		typedef typename Field::RandIter   RandIter;
+		typedef BlasMatrix<Field>           Block;
+		typedef BlasMatrix<Field>           Value;
+
+		/** Constructor of the sequence from a blackbox, a field and two blocks projection.
+		 * @param D blackbox
+		 * @param F field
+		 * @param U0 left projection (m x N)
+		 * @param V0 right projection (N x n)
+		 * @param numThreads number of workers, 0 for the hardware concurrency
+		 * @param lookahead maximal number of elements computed ahead of the consumer, 0 for a default
+		 */
+		BlackboxBlockContainerPipelined(const _Blackbox *D, const Field &F, const Block &U0, const Block& V0,
+						size_t numThreads = 0, size_t lookahead = 0) :
+			BlackboxBlockContainerBase<Field,_Blackbox> (D, F, U0.rowdim(), V0.coldim())
+		{
+			this->init (U0, V0);
+			_start(numThreads, lookahead);
+		}
+
+		//  constructor of the sequence from a blackbox, a field and two blocks random projection
+		BlackboxBlockContainerPipelined(const _Blackbox *D, const Field &F, size_t m, size_t n,
+						size_t seed = (size_t)time(NULL), size_t numThreads = 0, size_t lookahead = 0) :
+			BlackboxBlockContainerBase<Field, _Blackbox> (D, F, m, n, seed)
+		{
+			this->init (m, n);
+			_start(numThreads, lookahead);
+		}
+
+		~BlackboxBlockContainerPipelined()
+		{
+			stop();
+		}
+
+		/** Terminates the workers.
+		 * Elements already completed can still be read, the iterator must
+		 * not be advanced past them.
+		 */
+		void stop()
+		{
+			{
+				std::lock_guard<std::mutex> lock(_mutex);
+				_stop = true;
+			}
+			_free.notify_all();
+			_ready.notify_all();
+			for (size_t j = 0; j < _workers.size(); ++j)
+				if (_workers[j].joinable())
+					_workers[j].join();
+			_workers.clear();
+		}
+
+		//! number of worker threads (column slices of \f$V\f$)
+		size_t numThreads() const { return _slices.size(); }
+
+		//! number of sequence elements that may be computed ahead of the consumer
+		size_t lookahead() const { return _ring.size(); }
+
+	protected:
+
+		std::vector<Value>               _ring; // slots, element i lives in _ring[i % lookahead]
+		std::vector<size_t>          _ringStep; // index of the element expected in each slot
+		std::vector<size_t>       _ringPending; // slices still to be written in each slot
+		std::vector<std::pair<size_t,size_t> > _slices; // [begin,end) column ranges of V
+		std::vector<std::thread>      _workers;
+		size_t                           _head; // index of the current element
+		size_t                         _loaded; // index held in _value, (size_t)-1 if none
+		bool                             _stop;
+		std::exception_ptr              _error;
+		std::mutex                      _mutex;
+		std::condition_variable         _ready; // a slot has been completed
+		std::condition_variable          _free; // a slot has been recycled
+
+		void _start(size_t numThreads, size_t lookahead)
+		{
+			if (numThreads == 0)
+				numThreads = std::thread::hardware_concurrency();
+			if (numThreads == 0)
+				numThreads = 1;
+			if (numThreads > this->_n)
+				numThreads = this->_n;
+			if (lookahead == 0)
+				lookahead = 2*numThreads+2;
+
+			_head   = 0;
+			_loaded = (size_t)-1; // _value holds U V from init(), but is reloaded from the ring
+			_stop   = false;
+
+			_ring.assign(lookahead, Value(this->field(), this->_m, this->_n));
+			_ringStep.resize(lookahead);
+			_ringPending.assign(lookahead, numThreads);
+			for (size_t k = 0; k < lookahead; ++k)
+				_ringStep[k] = k;
+
+			size_t q = this->_n / numThreads, r = this->_n % numThreads, c0 = 0;
+			for (size_t j = 0; j < numThreads; ++j) {
+				size_t w = q + (j < r ? 1 : 0);
+				_slices.push_back(std::make_pair(c0, c0+w));
+				c0 += w;
+			}
+			for (size_t j = 0; j < numThreads; ++j)
+				_workers.push_back(std::thread(&BlackboxBlockContainerPipelined::_worker, this, j));
+		}
+
+		// computes U A^i V_j for i = 0, 1, ... into the ring
+		void _worker(size_t j)
+		{
+			try {
+				const size_t c0 = _slices[j].first;
+				const size_t w  = _slices[j].second - c0;
+				const size_t L  = _ring.size();
+
+				Block V(this->_blockV, 0, c0, this->_nn, w);
+				Block W(this->field(), this->_nn, w);
+				Block UV(this->field(), this->_m, w);
+				Block *cur = &V, *nxt = &W;
+				BlasMatrixDomain<Field> BMD(this->field());
+
+				for (size_t i = 0; ; ++i) {
+					if (i > 0) {
+						this->Mul(*nxt, *this->_BB, *cur);
+						std::swap(cur, nxt);
+					}
+					BMD.mul(UV, this->_blockU, *cur);
+
+					std::unique_lock<std::mutex> lock(_mutex);
+					while (!_stop && _ringStep[i % L] != i)
+						_free.wait(lock);
+					if (_stop)
+						return;
+					lock.unlock();
+
+					// disjoint columns: no lock needed while writing
+					Value &slot = _ring[i % L];
+					for (size_t k = 0; k < this->_m; ++k)
+						for (size_t l = 0; l < w; ++l)
+							slot.setEntry(k, c0+l, UV.getEntry(k, l));
+
+					lock.lock();
+					if (--_ringPending[i % L] == 0)
+						_ready.notify_all();
+				}
+			}
+			catch (...) {
+				std::lock_guard<std::mutex> lock(_mutex);
+				if (!_error)
+					_error = std::current_exception();
+				_ready.notify_all();
+			}
+		}
+
+		// recycles the slot of the current element and moves to the next one
+		void _launch ()
+		{
+			_wait();
+			const size_t L = _ring.size();
+			{
+				std::lock_guard<std::mutex> lock(_mutex);
+				_ringStep[_head % L]    = _head + L;
+				_ringPending[_head % L] = _slices.size();
+				++_head;
+			}
+			_free.notify_all();
+		}
+
+		// blocks until the current element has been completed by all workers
+		void _wait ()
+		{
+			if (_loaded == _head)
+				return;
+			const size_t L = _ring.size();
+			std::unique_lock<std::mutex> lock(_mutex);
+			while (!_error && !_stop && (_ringStep[_head % L] != _head || _ringPending[_head % L] != 0))
+				_ready.wait(lock);
+			if (_error)
+				std::rethrow_exception(_error);
+			if (_ringStep[_head % L] != _head || _ringPending[_head % L] != 0)
+				throw LinboxError("BlackboxBlockContainerPipelined: element requested after stop()");
+			this->_value = _ring[_head % L];
+			_loaded = _head;
+		}
+	};
+
+}
+
+#endif // __LINBOX_blackbox_block_container_pipelined_H
+
+// Local Variables:
+// mode: C++
+// tab-width: 4
+// indent-tabs-mode: nil
+// c-basic-offset: 4
+// End:
+// vim:sts=4:sw=4:ts=4:et:sr:cino=>s,f0,{0,g0,(0,\:0,t0,+0,=s
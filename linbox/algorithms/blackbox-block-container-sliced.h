@@ -0,0 +1,114 @@
+/* linbox/algorithms/blackbox-block-container-sliced.h
+ *
+ * ========LICENCE========
+ * This file is part of the library LinBox.
+ *
+ * LinBox is free software: you can redistribute it and/or modify
+ * it under the terms of the  GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ * ========LICENCE========
+ */
+
+/*! @file algorithms/blackbox-block-container-sliced.h
+ * @ingroup algorithms
+ * @brief Block Krylov sequence over GF(3) on bit-sliced blocks.
+ */
+
+#ifndef __LINBOX_blackbox_block_container_sliced_H
+#define __LINBOX_blackbox_block_container_sliced_H
+
+#include "linbox/linbox-config.h"
+#include "linbox/util/debug.h"
+
+#include "linbox/algorithms/blackbox-block-container-base.h"
+#include "linbox/matrix/dense-matrix.h"
+#include "linbox/matrix/sliced3/sliced-sparse.h"
+
+namespace LinBox
+{
+
+	/*! @brief Block sequence \f$U A^i V\f$ over GF(3), with sliced blocks.
+	 *
+	 * The iterate \f$A^i V\f$ is kept packed, 64 columns per word, and
+	 * multiplied by the SlicedSparseMatrix copy of the CSR or COO matrix
+	 * \f$A\f$; the projection by \f$U\f$ is a sliced product too, which
+	 * only reads the nonzero entries of \f$U\f$.  The sequence elements
+	 * are unpacked into BlasMatrix over the given field, so the container
+	 * is a drop-in \c Sequence for BlockCoppersmithDomain and
+	 * CoppersmithInvariantFactors.
+	 *
+	 * The field must be a representation of GF(3), e.g.
+	 * Givaro::Modular<double>(3); \f$A\f$ is square.
+	 */
+	template<class _Field, class _Blackbox, class _WordT = uint64_t>
+	class BlackboxBlockContainerSliced : public BlackboxBlockContainerBase<_Field,_Blackbox> {
+	public:
+		typedef _Field                         Field;
+		typedef typename Field::Element      Element;
+		typedef typename Field::RandIter   RandIter;
+		typedef BlasMatrix<Field>           Block;
+		typedef BlasMatrix<Field>           Value;
+		typedef SlicedSparseMatrix<_WordT>  SlicedMatrix;
+		typedef SlicedBlock<_WordT>         SlicedBlock_t;
+
+		//  constructor of the sequence from a blackbox, a field and two blocks projection
+		BlackboxBlockContainerSliced(const _Blackbox *D, const Field &F, const Block &U0, const Block &V0) :
+			BlackboxBlockContainerBase<Field,_Blackbox> (D, F, U0.rowdim(), V0.coldim())
+			, _A(*D), _U(U0)
+		{
+			linbox_check(D->rowdim() == D->coldim());
+			this->init (U0, V0);
+			_X.load(V0);
+		}
+
+		//  constructor of the sequence from a blackbox, a field and two blocks random projection
+		BlackboxBlockContainerSliced(const _Blackbox *D, const Field &F, size_t m, size_t n, size_t seed = (size_t)time(NULL)) :
+			BlackboxBlockContainerBase<Field,_Blackbox> (D, F, m, n, seed)
+			, _A(*D)
+		{
+			linbox_check(D->rowdim() == D->coldim());
+			this->init (m, n);
+			_U = SlicedMatrix(this->_blockU);
+			_X.load(this->_blockV);
+		}
+
+	protected:
+		SlicedMatrix          _A;
+		SlicedMatrix          _U;
+		SlicedBlock_t         _X; // A^i V
+		SlicedBlock_t         _Y;
+		SlicedBlock_t        _UX;
+
+		// launcher of the next sequence element computation
+		void _launch ()
+		{
+			_A.apply(_Y, _X);
+			_X.swap(_Y);
+			_U.apply(_UX, _X);
+			_UX.unload(this->_value);
+		}
+
+		void _wait () {}
+	};
+
+}
+
+#endif // __LINBOX_blackbox_block_container_sliced_H
+
+// Local Variables:
+// mode: C++
+// tab-width: 4
+// indent-tabs-mode: nil
+// c-basic-offset: 4
+// End:
+// vim:sts=4:sw=4:ts=4:et:sr:cino=>s,f0,{0,g0,(0,\:0,t0,+0,=s
@@ -36,6 +36,7 @@
 #include "linbox/algorithms/blackbox-block-container-base.h"
 #include "linbox/matrix/dense-matrix.h"
 #include "linbox/matrix/matrix-domain.h"
+#include "linbox/util/instrument.h"
 
 #define _BBC_TIMING
 
@@ -139,13 +140,13 @@ namespace LinBox
 			tSequence.start();
 #endif
 			if (this->casenumber) {
-                                this->Mul(_blockW,*this->_BB,this->_blockV);
-				_BMD.mul(this->_value, this->_blockU, _blockW);
+				{ LINBOX_INSTRUMENT_SCOPE ("block apply"); this->Mul(_blockW,*this->_BB,this->_blockV); }
+				{ LINBOX_INSTRUMENT_SCOPE ("block projection"); _BMD.mul(this->_value, this->_blockU, _blockW); }
 				this->casenumber = 0;
                         }
 			else {
-                                this->Mul(this->_blockV,*this->_BB,_blockW);
-				_BMD.mul(this->_value, this->_blockU, this->_blockV);
+				{ LINBOX_INSTRUMENT_SCOPE ("block apply"); this->Mul(this->_blockV,*this->_BB,_blockW); }
+				{ LINBOX_INSTRUMENT_SCOPE ("block projection"); _BMD.mul(this->_value, this->_blockU, this->_blockV); }
 				this->casenumber = 1;
 			}
 #ifdef _BBC_TIMING
@@ -33,6 +33,7 @@
 #include "linbox/randiter/archetype.h"
 #include "linbox/algorithms/blackbox-container-base.h"
 #include "linbox/util/timer.h"
+#include "linbox/util/instrument.h"
 
 namespace LinBox
 {
@@ -118,7 +119,7 @@ namespace LinBox
 #ifdef INCLUDE_TIMING
 				_timer.start ();
 #endif // INCLUDE_TIMING
-				this->_BB->apply (this->v, w);  // GV
+				{ LINBOX_INSTRUMENT_SCOPE ("blackbox apply"); this->_BB->apply (this->v, w); }  // GV
 
 #ifdef INCLUDE_TIMING
 				_timer.stop ();
@@ -126,7 +127,7 @@ namespace LinBox
 				_timer.start ();
 #endif // INCLUDE_TIMING
 
-				this->_VD.dot (this->_value, this->u, this->v);  // GV
+				{ LINBOX_INSTRUMENT_SCOPE ("blackbox dot"); this->_VD.dot (this->_value, this->u, this->v); }  // GV
 
 #ifdef INCLUDE_TIMING
 				_timer.stop ();
@@ -139,7 +140,7 @@ namespace LinBox
 #ifdef INCLUDE_TIMING
 				_timer.start ();
 #endif // INCLUDE_TIMING
-				this->_BB->apply (w, this->v);  // GV
+				{ LINBOX_INSTRUMENT_SCOPE ("blackbox apply"); this->_BB->apply (w, this->v); }  // GV
 
 #ifdef INCLUDE_TIMING
 				_timer.stop ();
@@ -147,7 +148,7 @@ namespace LinBox
 				_timer.start ();
 #endif // INCLUDE_TIMING
 
-				this->_VD.dot (this->_value, this->u, w);  // GV
+				{ LINBOX_INSTRUMENT_SCOPE ("blackbox dot"); this->_VD.dot (this->_value, this->u, w); }  // GV
 
 #ifdef INCLUDE_TIMING
 				_timer.stop ();
@@ -27,6 +27,7 @@
 #define __LINBOX_coppersmith_block_domain_H
 
 #include <vector>
+#include <list>
 #include <iostream>
 #include <algorithm>
 #include <iomanip>
@@ -47,6 +48,10 @@ namespace LinBox {
 
 #include "linbox/util/commentator.h"
 
+#ifdef __LINBOX_USE_OPENMP
+#include <omp.h>
+#endif
+
 #define DEFAULT_BLOCK_EARLY_TERM_THRESHOLD 10
 //Preprocessor variables for the state of BM_iterators
 #define DeltaExceeded  4
@@ -241,6 +246,20 @@ EARLY_TERM_THRESHOLD (ett_default)
 			return _size;
 		}
 
+		/** Iterator whose incrementation performs one step of the block
+		 * Berlekamp/Massey algorithm.
+		 *
+		 * The generator coefficients are stored in a single buffer of
+		 * \c _gencap blocks of \c _col rows, coefficient \f$k\f$ in block
+		 * \f$\_gencap-1-k\f$, so the live coefficients
+		 * \f$G_{L-1},\dots,G_0\f$ are contiguous.  The consumed sequence
+		 * elements are stored side by side in \c _seqbuf, so that the
+		 * discrepancy \f$\sum_k S_{t-k} G_k\f$ is one matrix product of a
+		 * slice of \c _seqbuf by the generator.  With OpenMP this product
+		 * is split into one chunk per thread, the partial discrepancies
+		 * being summed by a tree reduction.  All buffers are reused from
+		 * one step to the next and grow geometrically.
+		 */
 		class BM_iterator {
 		public:
 			typedef std::list<Coefficient> value_type;
@@ -251,7 +270,14 @@ EARLY_TERM_THRESHOLD (ett_default)
 			typename BM_Seq::size_type _size;
 			typename BM_Seq::size_type _t;
 			typename BM_Seq::const_iterator _seqel;
-			std::list<Coefficient> _gen;
+			Coefficient _genbuf;                // generator, coefficient k in block _gencap-1-k
+			Coefficient _gentmp;                // scratch for generator * tau
+			size_t _gencap;                     // capacity of _genbuf, in coefficients
+			Coefficient _seqbuf;                // S_0 | S_1 | ... | S_t
+			size_t _seqcap;                     // capacity of _seqbuf, in elements
+			std::vector<Coefficient> _partial;  // partial discrepancies, one per chunk
+			Coefficient _tau;
+			value_type _genlist;                // list view of the generator, see operator*
 			std::vector<size_t> _deg;
 			size_t _delta;
 			size_t _mu;
@@ -331,7 +357,13 @@ EARLY_TERM_THRESHOLD (ett_default)
 			explicit BM_iterator(BM_Seq& s,
                                              unsigned long earlyTermThreshold=DEFAULT_BLOCK_EARLY_TERM_THRESHOLD,
                                              typename BM_Seq::size_type elinit=0) :
-				 _MD(&s.domain()),  _seq(s)
+				 _MD(&s.domain()),  _seq(s),
+				 _genbuf(s.domain().field(), 4*s.coldim(), s.rowdim()+s.coldim()),
+				 _gentmp(s.domain().field(), 4*s.coldim(), s.rowdim()+s.coldim()),
+				 _gencap(4),
+				 _seqbuf(s.domain().field(), s.rowdim(), 4*s.coldim()),
+				 _seqcap(4),
+				 _tau(s.domain().field(), s.rowdim()+s.coldim(), s.rowdim()+s.coldim())
 			{
 				_row = s.rowdim();
 				_col = s.coldim();
@@ -344,11 +376,15 @@ EARLY_TERM_THRESHOLD (ett_default)
                                 _etc=0;
 				for(size_t i = _col; i < _row+_col; ++i)
 					_deg[i] = 1;
-				Coefficient gen1(field(),_col,_row+_col);
+				// G_0 = [ I_col | 0 ]
 				for(size_t i = 0; i<_col; ++i)
-					gen1.setEntry(i,i,field().one);
-				_gen.push_back(gen1);
+					_genbuf.setEntry((_gencap-1)*_col+i,i,field().one);
 				_gensize = 1;
+				size_t numChunks = 1;
+#ifdef __LINBOX_USE_OPENMP
+				numChunks = (size_t)omp_get_max_threads();
+#endif
+				_partial.assign(numChunks, Coefficient(field(),_row,_row+_col));
 				if(_size==0 || _t==_size)
 					_state._state = SequenceExceeded;
 				_sigma = 0;
@@ -359,14 +395,15 @@ EARLY_TERM_THRESHOLD (ett_default)
 			//Copy constructor
 			BM_iterator(const BM_Seq::BM_iterator & it) :
 				_MD(&it.domain()), _seq(it._seq), _size(it._size), _t(it._t),
-				_seqel(it._seqel), _gen(it._gen), _deg(it._deg),
+				_seqel(it._seqel), _genbuf(it._genbuf), _gentmp(it._gentmp),
+				_gencap(it._gencap), _seqbuf(it._seqbuf), _seqcap(it._seqcap),
+				_partial(it._partial), _tau(it._tau), _deg(it._deg),
 				_delta(it._delta), _mu(it._mu), _beta(it._beta),
 				_sigma(it._sigma), _gensize(it._gensize),
 				_row(it._row), _col(it._col),
 				_ett(it._ett), _etc(it._etc), _state(it._state) {}
 
 
-			//Assignment operator not overloaded since BlasMatrix class has overloaded assignment error
 			//Overloaded assignment operator
 			BM_iterator& operator=(const typename BM_Seq::BM_iterator& it)
 			{
@@ -387,9 +424,13 @@ EARLY_TERM_THRESHOLD (ett_default)
 					(*this)._state   = it._state;
 					(*this)._ett     = it._ett;
 					(*this)._etc     = it._etc;
-					_gen.clear();
-					for(typename std::list<Coefficient>::const_iterator git = it._gen.begin(); git != it._gen.end(); ++git)
-						_seq.push_back(*git);
+					_genbuf  = it._genbuf;
+					_gentmp  = it._gentmp;
+					_gencap  = it._gencap;
+					_seqbuf  = it._seqbuf;
+					_seqcap  = it._seqcap;
+					_partial = it._partial;
+					_tau     = it._tau;
 				}
 				return (*this);
 			}
@@ -410,13 +451,107 @@ EARLY_TERM_THRESHOLD (ett_default)
 			}
 		private:
 
-			// Column Copy
-			void ColumnCopy(Coefficient &M, Coefficient &A, size_t i)
+			// first row of coefficient k of the generator in _genbuf
+			size_t genRow(size_t k) const
+			{
+				return (_gencap-1-k)*_col;
+			}
+
+			// Stores S_t in _seqbuf, growing it if needed
+			void pushSequenceElement(const Coefficient &S)
+			{
+				if((size_t)_t >= _seqcap){
+					size_t cap = 2*_seqcap;
+					Coefficient buf(field(),_row,cap*_col);
+					Sub dst(buf,0,0,_row,_seqcap*_col);
+					Sub src(_seqbuf,0,0,_row,_seqcap*_col);
+					domain().copy(dst,src);
+					_seqbuf = buf;
+					_seqcap = cap;
+				}
+				Sub St(_seqbuf,0,(size_t)_t*_col,_row,_col);
+				domain().copy(St,S);
+			}
+
+			// Makes room for L coefficients in _genbuf.  The live
+			// coefficients are moved to the bottom of the new buffer, the
+			// rows above them are zero.
+			void reserveGenerator(size_t L)
 			{
-				size_t rowd = A.rowdim();
-				Sub MC(M,0,i,rowd,1);
-				Sub AC(A,0,i,rowd,1);
-				domain().copy(MC,AC);
+				if(L <= _gencap)
+					return;
+				size_t cap = std::max(2*_gencap, L);
+				Coefficient buf(field(),cap*_col,_row+_col);
+				Sub dst(buf,(cap-_gensize)*_col,0,_gensize*_col,_row+_col);
+				Sub src(_genbuf,genRow(_gensize-1),0,_gensize*_col,_row+_col);
+				domain().copy(dst,src);
+				_genbuf = buf;
+				_gencap = cap;
+			}
+
+			// disc = sum_k S_{t-k} G_k, result in _partial[0]
+			Coefficient& discrepancy()
+			{
+				const size_t L = _gensize;
+				const size_t nc = std::min(_partial.size(), L);
+				const size_t s0 = ((size_t)_t+1-L)*_col; // column of S_{t-L+1}
+				const size_t g0 = genRow(L-1);          // row of G_{L-1}
+				// chunk c pairs S_{t-L+1+i} with G_{L-1-i}, for b_c <= i < b_{c+1}
+#ifdef __LINBOX_USE_OPENMP
+#pragma omp parallel for
+#endif
+				for (long c = 0; c < (long)nc; ++c) {
+					const size_t b0 = (size_t)c*L/nc, b1 = (size_t)(c+1)*L/nc;
+					Sub Sc(_seqbuf,0,s0+b0*_col,_row,(b1-b0)*_col);
+					Sub Gc(_genbuf,g0+b0*_col,0,(b1-b0)*_col,_row+_col);
+					domain().mul(_partial[(size_t)c],Sc,Gc);
+				}
+				// tree reduction of the partial discrepancies
+				for (size_t s = 1; s < nc; s *= 2) {
+#ifdef __LINBOX_USE_OPENMP
+#pragma omp parallel for
+#endif
+					for (long i = 0; i < (long)(nc-s); i += (long)(2*s))
+						domain().addin(_partial[(size_t)i],_partial[(size_t)i+s]);
+				}
+				return _partial[0];
+			}
+
+			// _gentmp = [G_{L-1}; ...; G_0] tau, split in row chunks
+			void updateGenerator()
+			{
+				const size_t L = _gensize;
+				if(_gentmp.rowdim() < L*_col)
+					_gentmp = Coefficient(field(),_gencap*_col,_row+_col);
+				const size_t nc = std::min(_partial.size(), L);
+				const size_t g0 = genRow(L-1);
+#ifdef __LINBOX_USE_OPENMP
+#pragma omp parallel for
+#endif
+				for (long c = 0; c < (long)nc; ++c) {
+					const size_t b0 = (size_t)c*L/nc, b1 = (size_t)(c+1)*L/nc;
+					Sub Gc(_genbuf,g0+b0*_col,0,(b1-b0)*_col,_row+_col);
+					Sub Tc(_gentmp,b0*_col,0,(b1-b0)*_col,_row+_col);
+					domain().mul(Tc,Gc,_tau);
+				}
+			}
+
+			// Copies _gentmp back into the generator of L coefficients while
+			// multiplying the auxiliary columns by z: the generator columns
+			// of G_k and the auxiliary columns of G_{k+1} come from G_k tau.
+			void shiftGenerator(size_t L, bool grown)
+			{
+				Sub Tg(_gentmp,0,0,L*_col,_col);
+				Sub Gg(_genbuf,genRow(L-1),0,L*_col,_col);
+				domain().copy(Gg,Tg);
+				const size_t K = grown ? L : L-1;
+				if (K > 0) {
+					Sub Ta(_gentmp,(L-K)*_col,_col,K*_col,_row);
+					Sub Ga(_genbuf,genRow(K),_col,K*_col,_row);
+					domain().copy(Ga,Ta);
+				}
+				Sub G0aux(_genbuf,genRow(0),_col,_col,_row);
+				G0aux.zero();
 			}
 			// Column Swap
 			void ColumnSwap(Coefficient &M, size_t i, size_t j)
@@ -548,61 +683,31 @@ EARLY_TERM_THRESHOLD (ett_default)
 				if(_t == _size){
 					return *this;
 				}
-				//Initialize the discrepancy
-				Coefficient disc(field(),_row, _row+_col);
-				//Create two iterators, one for seq, and one for gen
-				typename BM_Seq::const_iterator cseqit;
-				typename std::list<Coefficient>::iterator genit;
-				//get a iterator to the seq element to be processed
-				cseqit = _seqel;
+				pushSequenceElement(*_seqel);
 
 				CTimer start1; start1.start();
 				//Compute the discrepancy
-				std::vector<Coefficient*> coeffVec;
-				std::vector<const Coefficient*> seqPtrVec;
-				for(genit = _gen.begin(); genit!=_gen.end(); ++genit){
-					coeffVec.push_back(&(*genit));
-					seqPtrVec.push_back(&(*cseqit));
-					--cseqit;
-				}
-				int numCoeffs=coeffVec.size();
-				std::vector <Coefficient> discComponents;
-				discComponents.reserve(numCoeffs);
-				for (int i=0;i<numCoeffs;++i) {
-					discComponents.push_back(Coefficient(field(),_row,_row+_col));
-				}
-#ifdef __LINBOX_USE_OPENMP
-#pragma omp parallel for
-#endif
-				for (int i=0;i<numCoeffs;++i) {
-					domain().axpyin(discComponents[i],*(seqPtrVec[i]),*(coeffVec[i]));
-				}
-				for (int i=0;i<numCoeffs;++i) {
-					domain().addin(disc,discComponents[i]);
-				}
+				// cost: k*n^3 as a single (n x kn) by (kn x 2n) product,
+				// k being the current generator length
+				Coefficient &disc = discrepancy();
                                 start1.stop();
 				g_time2 += start1.realtime();
 
 				CTimer start2; start2.start();
 				//Compute tau with Algorith3.2
-				Coefficient tau(field(), _row+_col, _row+_col);
+				_tau.zero();
 				Sub primaryDisc(disc,0,0,_row,_col);
 				if (_MD->isZero(primaryDisc)) {
 					--_etc;
 				} else {
 					_etc=_ett;
 				}
-				Algorithm3dot2(tau, disc, _deg, _mu, _sigma, _beta);
+				Algorithm3dot2(_tau, disc, _deg, _mu, _sigma, _beta);
                                 start2.stop();
 				g_time3 += start2.realtime();
 				CTimer start3; start3.start();
 				//Multiply tau into each matrix in the generator
-#ifdef __LINBOX_USE_OPENMP
-#pragma omp parallel for
-#endif
-				for (int i=0;i<numCoeffs;++i) {
-					domain().mulin(*(coeffVec[i]),tau);
-				}
+				updateGenerator();
                                 start3.stop();
 				g_time4 += start3.realtime();
 				//Increment the auxiliary degrees and beta
@@ -610,30 +715,19 @@ EARLY_TERM_THRESHOLD (ett_default)
 					_deg[j]++;
 				++_beta;
 				//Add a zero matrix to the end of the generator if needed.
-				int tmax = (int)_deg[0];
+				const size_t L = _gensize;
+				size_t tmax = _deg[0];
 				for(size_t j = 1; j<_row+_col; ++j)
-					if(tmax < (int)_deg[j])
-						tmax = (int)_deg[j];
-				if(tmax+1 > (int)_gensize){
-					_gen.push_back(Coefficient(field(),_col,_row+_col));
+					if(tmax < _deg[j])
+						tmax = _deg[j];
+				bool grown = false;
+				if(tmax+1 > _gensize){
+					reserveGenerator(_gensize+1);
 					++_gensize;
+					grown = true;
 				}
-				//Mimic multiplication be z in the auxiliary columns
-				typename std::list<Coefficient>::reverse_iterator g1,g2;
-				g1 = _gen.rbegin();
-				g2 = _gen.rbegin();
-				++g1;
-				while(g1!=_gen.rend()){
-					Sub g1aux(*g1,0,_col,_col,_row);
-					Sub g2aux(*g2,0,_col,_col,_row);
-					domain().copy(g2aux,g1aux);
-					++g1;
-					++g2;
-				}
-				genit = _gen.begin();
-				Coefficient z1(field(),_col,_row);
-				Sub genitaux(*genit,0,_col,_col,_row);
-				domain().copy(genitaux,z1);
+				//Mimic multiplication by z in the auxiliary columns
+				shiftGenerator(L, grown);
 				//Increment the t and seqel to the next element
 				++_t;
 				++_seqel;
@@ -660,118 +754,39 @@ EARLY_TERM_THRESHOLD (ett_default)
 
 				return *this;
 			}
-			// Is this working? -AS
+
 			BM_iterator operator++(int)
 			{
-				//Create a copy of this
 				BM_iterator temp(*this);
-
-				//See if a matrix has been pushed on the sequence
-				//if it has, then recompute the seqel since it may
-				//have become corrupt.
-				//Also reset the size to the correct size of the sequence
-				if(_size < _seq.size()){
-					_seqel = _seq.begin();
-					for(int i = 0; i<_t; ++i)
-						++_seqel;
-					_size = _seq.size();
-				}
-				//if the iterator points past the seq elements, do nothing
-				if(_t == _size){
-					return *this;
-				}
-				//Initialize the discrepancy
-				Coefficient disc(field(),_row, _row+_col);
-				//Create two iterators, one for seq, and one for gen
-				typename BM_Seq::const_iterator cseqit;
-				typename std::list<Coefficient>::iterator genit;
-				//get an iterator to the seq element to be processed
-				cseqit = _seqel;
-				//Compute the discrepancy
-				for(genit = _gen.begin(); genit!=_gen.end(); ++genit, cseqit--){
-					domain().axpyin(disc,*cseqit,*genit);
-				} // cost: k*n^3 (nxn matrix muladds where k is current generator length)
-				  // is a reductive addition over independent muls.
-				//Compute tau with Algorith3.2
-				Coefficient tau(field(), _row+_col, _row+_col);
-				Algorithm3dot2(tau, disc, _deg, _mu, _sigma, _beta);
-				  // cost: n^3 for elim on n x about 2n
-				//Multiply tau into each matrix in the generator
-				for(genit = _gen.begin(); genit!=_gen.end(); ++genit){
-					domain().mulin(*genit,tau);
-				} // cost: k*n^3 (nxn matrix muls where k is current generator length)
-				  // is k independent muls with a shared mat tau.
-				//Increment the auxiliary degrees and beta
-				for(size_t j = _col; j <_row+_col; ++j)
-					_deg[j]++;
-				++_beta;
-				//Add a zero matrix to the end of the generator if needed.
-				int tmax = (int)_deg[0];
-				for(size_t j = 1; j<_row+_col; ++j)
-					if(tmax < _deg[j])
-						tmax = (int)_deg[j];
-				if(tmax+1 > _gensize){
-					_gen.push_back(Coefficient(field(),_col,_row+_col));
-					++_gensize;
-				}
-				//Mimic multiplication by z in the auxiliary columns
-				typename std::list<Coefficient>::reverse_iterator g1,g2;
-				g1 = _gen.rbegin();
-				g2 = _gen.rbegin();
-				++g1;
-				while(g1!=_gen.rend()){
-					Sub g1aux(*g1,0,_col,_col,_row);
-					Sub g2aux(*g2,0,_col,_col,_row);
-					domain().copy(g2aux,g1aux);
-					++g1;
-					++g2;
-				}
-				genit = _gen.begin();
-				Coefficient z1(field(),_col,_row);
-				Sub genitaux(*genit,0,_col,_col,_row);
-				domain().copy(genitaux,z1);
-				//Increment the t and seqel to the next element
-				++_t;
-				++_seqel;
-				//Update the state
-				if(/*  _delta < 0 || */ _beta < _delta - _sigma + _mu +1){
-					if(_t == _size)
-						_state._state = SequenceExceeded;
-					else{
-						if(_sigma > _delta /* && _delta >= 0 */)
-							_state._state = DeltaExceeded;
-						else
-							_state._state = GeneratorUnconfirmed;
-					}
-				}
-				else{
-					if(_sigma > _delta)
-						_state._state = DeltaExceeded;
-					else
-						_state._state = GeneratorFound;
-				}
-
+				++(*this);
 				return temp;
 			}
-			//return a reference to the current generator, in its algorithmic reversed form
+			//return a copy of the current generator, in its algorithmic reversed form
 			value_type& operator*()
 			{
-				return _gen;
+				_genlist.clear();
+				for(size_t k = 0; k < _gensize; ++k){
+					Coefficient Gk(field(),_col,_row+_col);
+					Sub src(_genbuf,genRow(k),0,_col,_row+_col);
+					domain().copy(Gk,src);
+					_genlist.push_back(Gk);
+				}
+				return _genlist;
 			}
 			//overload the pointer operator
 			value_type* operator->()
 			{
-				return &_gen;
+				return &(**this);
 			}
 			//Return a vector representing the reversal, by nominal degree, of the current generator
 			std::vector<Coefficient> GetGenerator()
 			{
 				std::vector<Coefficient> revgen(_mu+1, Coefficient(field(),_col,_col));
 				for(size_t i = 0; i<_col; ++i){
-					typename std::list<Coefficient>::iterator genit = _gen.begin();
-					for(int j = 0; j < (int)_deg[i]+1; ++j){
-						ColumnCopy(revgen[_deg[i]-j], *genit,i);
-						++genit;
+					for(size_t j = 0; j < _deg[i]+1; ++j){
+						Sub dst(revgen[_deg[i]-j],0,i,_col,1);
+						Sub src(_genbuf,genRow(j),i,_col,1);
+						domain().copy(dst,src);
 					}
 				}
 				return revgen;
@@ -0,0 +1,436 @@
+/* linbox/algorithms/block-lanczos-kernels.h
+ *
+ * ========LICENCE========
+ * This file is part of the library LinBox.
+ *
+ * LinBox is free software: you can redistribute it and/or modify
+ * it under the terms of the  GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ * ========LICENCE========
+ */
+
+/*! @file algorithms/block-lanczos-kernels.h
+ * @ingroup algorithms
+ * @brief Fused matrix-block kernels of the block Lanczos iteration.
+ *
+ * Each block Lanczos iteration needs \f$AV\f$, \f$V^TAV\f$ and
+ * \f$(AV)^TAV\f$.  Computing them with three separate products reads the
+ * \f$n \times N\f$ blocks three times; the kernels here compute both inner
+ * products in one pass over the rows of \f$V\f$ and \f$AV\f$, with the
+ * \f$N \times N\f$ accumulators kept in cache.
+ */
+
+#ifndef __LINBOX_block_lanczos_kernels_H
+#define __LINBOX_block_lanczos_kernels_H
+
+#include <vector>
+#include <algorithm>
+#include <cstring>
+#include <stdint.h>
+
+#include "linbox/linbox-config.h"
+#include "linbox/integer.h"
+#include "linbox/util/debug.h"
+#include "linbox/field/field-traits.h"
+#include "linbox/field/gf2.h"
+#include "linbox/matrix/densematrix/m4ri-matrix.h"
+#include "linbox/blackbox/block-apply.h"
+#include "linbox/blackbox/transpose.h"
+#include "linbox/blackbox/compose.h"
+
+namespace LinBox
+{
+
+	struct BlockLanczosGF2Kernel;
+
+	template <class _Field>
+	class ZeroOne;
+
+	/** @brief Block applies on packed GF(2) blocks.
+	 *
+	 * \c value is true when \f$AX\f$ and \f$A^TX\f$ can be computed on
+	 * M4RIMatrix blocks: for ZeroOne<GF2>, and for the transposes and
+	 * compositions of such blackboxes, which the block Lanczos
+	 * preconditioners build.
+	 */
+	template <class Blackbox>
+	struct PackedGF2Apply {
+		static const bool value = false;
+	};
+
+	template <>
+	struct PackedGF2Apply<ZeroOne<GF2> > {
+		static const bool value = true;
+
+		template <class Blackbox>
+		static M4RIMatrix &apply (M4RIMatrix &Y, const Blackbox &A, const M4RIMatrix &X)
+		{ return A.applyBlock (Y, X); }
+
+		template <class Blackbox>
+		static M4RIMatrix &applyTranspose (M4RIMatrix &Y, const Blackbox &A, const M4RIMatrix &X)
+		{ return A.applyTransposeBlock (Y, X); }
+	};
+
+	template <class Blackbox>
+	struct PackedGF2Apply<Transpose<Blackbox> > {
+		static const bool value = PackedGF2Apply<Blackbox>::value;
+
+		static M4RIMatrix &apply (M4RIMatrix &Y, const Transpose<Blackbox> &A, const M4RIMatrix &X)
+		{ return PackedGF2Apply<Blackbox>::applyTranspose (Y, *A.getPtr (), X); }
+
+		static M4RIMatrix &applyTranspose (M4RIMatrix &Y, const Transpose<Blackbox> &A, const M4RIMatrix &X)
+		{ return PackedGF2Apply<Blackbox>::apply (Y, *A.getPtr (), X); }
+	};
+
+	template <class Blackbox1, class Blackbox2>
+	struct PackedGF2Apply<Compose<Blackbox1, Blackbox2> > {
+		static const bool value = PackedGF2Apply<Blackbox1>::value && PackedGF2Apply<Blackbox2>::value;
+
+		static M4RIMatrix &apply (M4RIMatrix &Y, const Compose<Blackbox1, Blackbox2> &A, const M4RIMatrix &X)
+		{
+			M4RIMatrix T (X.field (), A.getRightPtr ()->rowdim (), X.coldim ());
+			PackedGF2Apply<Blackbox2>::apply (T, *A.getRightPtr (), X);
+			return PackedGF2Apply<Blackbox1>::apply (Y, *A.getLeftPtr (), T);
+		}
+
+		static M4RIMatrix &applyTranspose (M4RIMatrix &Y, const Compose<Blackbox1, Blackbox2> &A, const M4RIMatrix &X)
+		{
+			M4RIMatrix T (X.field (), A.getLeftPtr ()->coldim (), X.coldim ());
+			PackedGF2Apply<Blackbox1>::applyTranspose (T, *A.getLeftPtr (), X);
+			return PackedGF2Apply<Blackbox2>::applyTranspose (Y, *A.getRightPtr (), T);
+		}
+	};
+
+	/** @brief Fused iteration kernel for block Lanczos over any field.
+	 *
+	 * The products \f$V^TAV\f$ and \f$(AV)^TAV\f$ are accumulated row by
+	 * row of the blocks with delayed reduction (FieldAXPY), the second one
+	 * only on its upper triangle since it is symmetric.  Over GF(2) the
+	 * step works on blocks packed 64 columns to a word (M4RIMatrix): \f$V\f$
+	 * is packed once, \f$AV\f$ is computed packed when PackedGF2Apply
+	 * allows it, the products are those of BlockLanczosGF2Kernel, and
+	 * \f$AV\f$ is unpacked once for the solver.
+	 */
+	template <class Field>
+	class BlockLanczosKernel {
+	public:
+		typedef typename Field::Element Element;
+
+		BlockLanczosKernel (const Field &F) :
+			_field (&F)
+		{
+			integer c;
+			_binary = (F.cardinality (c) == 2);
+		}
+
+		const Field &field () const { return *_field; }
+
+		/** \f$AV \gets A V\f$, \f$VTAV \gets V^T AV\f$ and
+		 * \f$AVTAV \gets (AV)^T AV\f$.
+		 * The block apply uses BlockApplyTraits, so blackboxes with a
+		 * native block apply traverse \f$A\f$ once for the block; over
+		 * GF(2), those of PackedGF2Apply are applied to the packed \f$V\f$.
+		 */
+		template <class Blackbox, class Block, class Matrix>
+		void apply (Block &AV, Matrix &VTAV, Matrix &AVTAV,
+			    const Blackbox &A, const Block &V) const
+		{
+			step (AV, VTAV, AVTAV, A, V, std::integral_constant<bool, PackedGF2Apply<Blackbox>::value> ());
+		}
+
+		/** \f$VTAV \gets V^T W\f$ and \f$AVTAV \gets W^T W\f$, reading
+		 * each row of \f$V\f$ and \f$W\f$ once.
+		 */
+		template <class Block, class Matrix>
+		void gram (Matrix &VTAV, Matrix &AVTAV, const Block &V, const Block &W) const
+		{
+			linbox_check (V.rowdim () == W.rowdim ());
+			linbox_check (V.coldim () == W.coldim ());
+			linbox_check (VTAV.rowdim () == V.coldim () && VTAV.coldim () == V.coldim ());
+			linbox_check (AVTAV.rowdim () == V.coldim () && AVTAV.coldim () == V.coldim ());
+
+			if (_binary) {
+				pack (_PV, V);
+				pack (_PAV, W);
+				gramGF2 (VTAV, AVTAV);
+				return;
+			}
+
+			const size_t N = V.coldim ();
+			if (_g1.size () != N * N) {
+				// built by copy: the generic FieldAXPY is not assignable
+				const FieldAXPY<Field> accu0 (field ());
+				std::vector<FieldAXPY<Field> > (N * N, accu0).swap (_g1);
+				std::vector<FieldAXPY<Field> > (N * N, accu0).swap (_g2);
+			}
+			else
+				for (size_t k = 0; k < N * N; ++k) {
+					_g1[k].reset ();
+					_g2[k].reset ();
+				}
+
+			typename Block::ConstRowIterator vi = V.rowBegin (), wi = W.rowBegin ();
+			for (; vi != V.rowEnd (); ++vi, ++wi) {
+				for (size_t k = 0; k < N; ++k) {
+					const Element &vk = (*vi)[k];
+					const Element &wk = (*wi)[k];
+					if (!field ().isZero (vk))
+						for (size_t j = 0; j < N; ++j)
+							_g1[k * N + j].mulacc (vk, (*wi)[j]);
+					if (!field ().isZero (wk))
+						for (size_t j = k; j < N; ++j)
+							_g2[k * N + j].mulacc (wk, (*wi)[j]);
+				}
+			}
+
+			for (size_t k = 0; k < N; ++k)
+				for (size_t j = 0; j < N; ++j)
+					_g1[k * N + j].get (VTAV.refEntry (k, j));
+			for (size_t k = 0; k < N; ++k) {
+				for (size_t j = k; j < N; ++j)
+					_g2[k * N + j].get (AVTAV.refEntry (k, j));
+				for (size_t j = 0; j < k; ++j)
+					field ().assign (AVTAV.refEntry (k, j), AVTAV.getEntry (j, k));
+			}
+		}
+
+	private:
+		// the field of the packed blocks
+		static const GF2 &packedField ()
+		{
+			static const GF2 F2;
+			return F2;
+		}
+
+		// A has a packed apply, so it is over GF(2): AV is computed from
+		// the packed V and unpacked once.  Only this branch is instantiated
+		// for such blackboxes, whose element wise applies need GF2 vectors.
+		template <class Blackbox, class Block, class Matrix>
+		void step (Block &AV, Matrix &VTAV, Matrix &AVTAV,
+			   const Blackbox &A, const Block &V, std::true_type) const
+		{
+			linbox_check (_binary);
+			pack (_PV, V);
+			if (_PAV.rowdim () != A.rowdim () || _PAV.coldim () != _PV.coldim ())
+				_PAV = M4RIMatrix (packedField (), A.rowdim (), _PV.coldim ());
+			PackedGF2Apply<Blackbox>::apply (_PAV, A, _PV);
+			unpack (AV, _PAV);
+			gramGF2 (VTAV, AVTAV);
+		}
+
+		// AV by BlockApplyTraits, packed for the products over GF(2)
+		template <class Blackbox, class Block, class Matrix>
+		void step (Block &AV, Matrix &VTAV, Matrix &AVTAV,
+			   const Blackbox &A, const Block &V, std::false_type) const
+		{
+			BlockApplyTraits<Blackbox>::apply (AV, A, V);
+			if (_binary) {
+				pack (_PV, V);
+				pack (_PAV, AV);
+				gramGF2 (VTAV, AVTAV);
+				return;
+			}
+			gram (VTAV, AVTAV, V, AV);
+		}
+
+		// P gets the block V over GF(2), row by row
+		template <class Block>
+		void pack (M4RIMatrix &P, const Block &V) const
+		{
+			typedef M4RIMatrix::Word Word;
+			const size_t N = V.coldim ();
+			if (P.rowdim () != V.rowdim () || P.coldim () != N)
+				P = M4RIMatrix (packedField (), V.rowdim (), N);
+			const size_t w = P.rowstride ();
+			typename Block::ConstRowIterator vi = V.rowBegin ();
+			for (size_t i = 0; vi != V.rowEnd (); ++vi, ++i) {
+				Word *p = P.row (i);
+				std::fill (p, p + w, Word (0));
+				for (size_t j = 0; j < N; ++j)
+					if (!field ().isZero ((*vi)[j]))
+						p[j / 64] |= Word (1) << (j % 64);
+			}
+		}
+
+		// the block V gets P, row by row
+		template <class Block>
+		void unpack (Block &V, const M4RIMatrix &P) const
+		{
+			linbox_check (V.rowdim () == P.rowdim () && V.coldim () == P.coldim ());
+			const size_t N = V.coldim ();
+			typename Block::RowIterator vi = V.rowBegin ();
+			for (size_t i = 0; vi != V.rowEnd (); ++vi, ++i) {
+				const M4RIMatrix::Word *p = P.row (i);
+				for (size_t j = 0; j < N; ++j)
+					field ().assign ((*vi)[j], ((p[j / 64] >> (j % 64)) & 1) ? field ().one : field ().zero);
+			}
+		}
+
+		// gram of the packed _PV and _PAV, by slabs of 64 columns;
+		// W_b^T W_b comes with V_b^T W_b from one pass, the other slab
+		// pairs are products
+		template <class Matrix>
+		void gramGF2 (Matrix &VTAV, Matrix &AVTAV) const;
+
+		// M(i0 + k, j0 + j), or M(j0 + j, i0 + k) if transposed, gets bit j of C[k]
+		template <class Matrix>
+		void scatter (Matrix &M, const uint64_t *C, size_t i0, size_t j0, bool transposed) const
+		{
+			const size_t N = M.rowdim ();
+			for (size_t k = 0; k < 64 && i0 + k < N; ++k)
+				for (size_t j = 0; j < 64 && j0 + j < N; ++j) {
+					const Element &e = ((C[k] >> j) & 1) ? field ().one : field ().zero;
+					if (transposed)
+						M.setEntry (j0 + j, i0 + k, e);
+					else
+						M.setEntry (i0 + k, j0 + j, e);
+				}
+		}
+
+		const Field *_field;
+		bool _binary;
+
+		// accumulators, kept between calls to avoid reallocating them
+		mutable std::vector<FieldAXPY<Field> > _g1, _g2;
+		// V and AV packed over GF(2), kept between calls
+		mutable M4RIMatrix _PV, _PAV;
+	};
+
+	/** @brief Block Lanczos kernels over GF(2) with 64-wide packed blocks.
+	 *
+	 * An \f$n \times 64\f$ block is stored as \f$n\f$ words, \p stride words
+	 * apart, bit \f$j\f$ of word \f$i\f$ being the entry \f$(i,j)\f$: a slab
+	 * of 64 columns of an M4RIMatrix has the stride of its rows.  A
+	 * \f$64 \times 64\f$ matrix is 64 contiguous words.  Products use the lookup tables of Montgomery's block
+	 * Lanczos: eight tables of 256 words, one per byte of the packed rows,
+	 * which fit in L1 cache.
+	 */
+	struct BlockLanczosGF2Kernel {
+		typedef uint64_t Word;
+
+		//! \f$VTAV \gets V^T W\f$ and \f$AVTAV \gets W^T W\f$ in one pass over the rows.
+		static void gram (Word *VTAV, Word *AVTAV, const Word *V, const Word *W, size_t n, size_t stride = 1)
+		{
+			Word T1[8][256], T2[8][256];
+			std::memset (T1, 0, sizeof (T1));
+			std::memset (T2, 0, sizeof (T2));
+			for (size_t r = 0; r < n; ++r) {
+				const Word v = V[r * stride], w = W[r * stride];
+				for (size_t k = 0; k < 8; ++k) {
+					T1[k][(v >> (8 * k)) & 0xff] ^= w;
+					T2[k][(w >> (8 * k)) & 0xff] ^= w;
+				}
+			}
+			combine (VTAV, T1);
+			combine (AVTAV, T2);
+		}
+
+		//! \f$C \gets V^T W\f$
+		static void mulTranspose (Word *C, const Word *V, const Word *W, size_t n, size_t stride = 1)
+		{
+			Word T[8][256];
+			std::memset (T, 0, sizeof (T));
+			for (size_t r = 0; r < n; ++r)
+				for (size_t k = 0; k < 8; ++k)
+					T[k][(V[r * stride] >> (8 * k)) & 0xff] ^= W[r * stride];
+			combine (C, T);
+		}
+
+		/** \f$W \gets V M\f$, or \f$W \gets W + V M\f$ if \p accumulate.
+		 * \f$M\f$ is \f$64 \times 64\f$; \p W may be \p V.
+		 */
+		static void mul (Word *W, const Word *V, const Word *M, size_t n, bool accumulate = false)
+		{
+			Word T[8][256];
+			for (size_t k = 0; k < 8; ++k) {
+				T[k][0] = 0;
+				// gray-code-free table: T[b] = T[b without lowest bit] ^ M[lowest bit]
+				for (size_t b = 1; b < 256; ++b) {
+					size_t low = 0;
+					while (!((b >> low) & 1)) ++low;
+					T[k][b] = T[k][b & (b - 1)] ^ M[8 * k + low];
+				}
+			}
+			for (size_t r = 0; r < n; ++r) {
+				const Word v = V[r];
+				Word w = 0;
+				for (size_t k = 0; k < 8; ++k)
+					w ^= T[k][(v >> (8 * k)) & 0xff];
+				W[r] = accumulate ? (W[r] ^ w) : w;
+			}
+		}
+
+	private:
+		// C[8k+b] = sum of T[k][c] over the bytes c having bit b set
+		static void combine (Word *C, Word T[8][256])
+		{
+			for (size_t k = 0; k < 8; ++k)
+				for (size_t b = 0; b < 8; ++b) {
+					Word s = 0;
+					for (size_t c = 0; c < 256; ++c)
+						if ((c >> b) & 1)
+							s ^= T[k][c];
+					C[8 * k + b] = s;
+				}
+		}
+	};
+
+	template <class Field>
+	template <class Matrix>
+	void BlockLanczosKernel<Field>::gramGF2 (Matrix &VTAV, Matrix &AVTAV) const
+	{
+		typedef BlockLanczosGF2Kernel::Word Word;
+		linbox_check (_PV.rowdim () == _PAV.rowdim () && _PV.coldim () == _PAV.coldim ());
+		const size_t n = _PV.rowdim (), S = _PV.rowstride ();
+		if (n == 0) {
+			for (size_t k = 0; k < VTAV.rowdim (); ++k)
+				for (size_t j = 0; j < VTAV.coldim (); ++j) {
+					VTAV.setEntry (k, j, field ().zero);
+					AVTAV.setEntry (k, j, field ().zero);
+				}
+			return;
+		}
+
+		Word C1[64], C2[64];
+		for (size_t b = 0; b < S; ++b) {
+			const Word *Wb = _PAV.row (0) + b;
+			for (size_t a = 0; a < S; ++a) {
+				const Word *Va = _PV.row (0) + a;
+				if (a == b) {
+					BlockLanczosGF2Kernel::gram (C1, C2, Va, Wb, n, S);
+					scatter (AVTAV, C2, 64 * b, 64 * b, false);
+				}
+				else {
+					BlockLanczosGF2Kernel::mulTranspose (C1, Va, Wb, n, S);
+					if (a < b) {
+						BlockLanczosGF2Kernel::mulTranspose (C2, _PAV.row (0) + a, Wb, n, S);
+						scatter (AVTAV, C2, 64 * a, 64 * b, false);
+						scatter (AVTAV, C2, 64 * a, 64 * b, true);
+					}
+				}
+				scatter (VTAV, C1, 64 * a, 64 * b, false);
+			}
+		}
+	}
+
+}
+
+#endif // __LINBOX_block_lanczos_kernels_H
+
+// Local Variables:
+// mode: C++
+// tab-width: 4
+// indent-tabs-mode: nil
+// c-basic-offset: 4
+// End:
+// vim:sts=4:sw=4:ts=4:et:sr:cino=>s,f0,{0,g0,(0,\:0,t0,+0,=s
@@ -38,6 +38,7 @@
 #include "linbox/vector/vector-domain.h"
 #include "linbox/blackbox/archetype.h"
 #include "linbox/solutions/methods.h"
+#include "linbox/algorithms/block-lanczos-kernels.h"
 
 // I'm putting everything inside the LinBox namespace so that I can drop all of
 // this in to LinBox easily at a later date, without any messy porting.
@@ -74,7 +75,7 @@ namespace LinBox
 		 *               options for the solver
 		 */
 		BlockLanczosSolver (const Field &F, const BlockLanczosTraits &traits) :
-			_traits (traits), _field (&F), _VD (F), _MD (F), _randiter (F), _block (traits.blockingFactor ())
+			_traits (traits), _field (&F), _VD (F), _MD (F), _kernel (F), _randiter (F), _block (traits.blockingFactor ())
 		{
 			init_temps ();
 		}
@@ -86,7 +87,7 @@ namespace LinBox
 		 * @param r Random iterator to use for randomization
 		 */
 		BlockLanczosSolver (const Field &F, const BlockLanczosTraits &traits, typename Field::RandIter r) :
-			_traits (traits), _field (&F), _VD (F), _MD (F), _randiter (r), _block (traits.blockingFactor ())
+			_traits (traits), _field (&F), _VD (F), _MD (F), _kernel (F), _randiter (r), _block (traits.blockingFactor ())
 		{
 			init_temps ();
 		}
@@ -214,6 +215,7 @@ namespace LinBox
 		const Field              *_field;
 		VectorDomain<Field>       _VD;
 		MatrixDomain<Field>       _MD;
+		BlockLanczosKernel<Field> _kernel;
 		typename Field::RandIter  _randiter;
 
 		// Temporaries used in the computation
@@ -222,6 +224,7 @@ namespace LinBox
 		Matrix  _AV;               // n x N
 		Matrix  _VTAV;             // N x N
 		Matrix  _Winv[2];          // N x N
+		Matrix  _AVTAV;            // N x N
 		Matrix  _AVTAVSST_VTAV;    // N x N
 		Matrix  _matT;                // N x N
 		Matrix  _DEF;              // N x N
@@ -406,8 +406,9 @@ namespace LinBox
 		for (k = _matV[0].colBegin (); k != _matV[0].colEnd (); ++k)
 			stream >> *k;
 
+		// AV, V^T AV and (AV)^T AV in one pass over the blocks
 		TIMER_START(AV);
-		_MD.blackboxMulLeft (_AV, A, _matV[0]);
+		_kernel.apply (_AV, _VTAV, _AVTAV, A, _matV[0]);
 		TIMER_STOP(AV);
 
 		std::ostream &report = commentator().report (Commentator::LEVEL_IMPORTANT, INTERNAL_DESCRIPTION);
@@ -417,7 +418,6 @@ namespace LinBox
 
 		// Iteration 1
 		TIMER_START(Winv);
-		_MD.mul (_VTAV, transpose (_matV[0]), _AV);
 		Ni = compute_Winv_S (_Winv[0], _vecS, _VTAV);
 		TIMER_STOP(Winv);
 
@@ -443,7 +443,7 @@ namespace LinBox
 		mul_SST (_matV[1], _AV, _vecS);
 
 		TIMER_START(orthogonalization);
-		mul (_AVTAVSST_VTAV, transpose (_AV), _AV, _vecS);
+		mul_SST (_AVTAVSST_VTAV, _AVTAV, _vecS);
 
 		BLTraceReport (report, _MD, "V", 0, _matV[0]);
 		BLTraceReport (report, _MD, "AV", 0, _AV);
@@ -472,8 +472,9 @@ namespace LinBox
 		}
 
 		// Iteration 2
+		// AV, V^T AV and (AV)^T AV in one pass over the blocks
 		TIMER_START(AV);
-		_MD.blackboxMulLeft (_AV, A, _matV[1]);
+		_kernel.apply (_AV, _VTAV, _AVTAV, A, _matV[1]);
 		TIMER_STOP(AV);
 
 #ifdef DETAILED_TRACE
@@ -483,7 +484,6 @@ namespace LinBox
 #endif
 
 		TIMER_START(Winv);
-		_MD.mul (_VTAV, transpose (_matV[1]), _AV);
 		Ni = compute_Winv_S (_Winv[1], _vecS, _VTAV);
 		TIMER_STOP(Winv);
 
@@ -510,7 +510,7 @@ namespace LinBox
 		mul_SST (_matV[2], _AV, _vecS);
 
 		TIMER_START(orthogonalization);
-		mul (_AVTAVSST_VTAV, transpose (_AV), _AV, _vecS);
+		mul_SST (_AVTAVSST_VTAV, _AVTAV, _vecS);
 
 		BLTraceReport (report, _MD, "AV", 1, _AV);
 		BLTraceReport (report, _MD, "V^T A V", 1, _VTAV);
@@ -540,14 +540,10 @@ namespace LinBox
 			int next_j = j + 1;
 			if (next_j > 2) next_j = 0;
 
-			TIMER_START(AV);
-			_MD.blackboxMulLeft (_AV, A, _matV[j]);
-			TIMER_STOP(AV);
-
 			// First compute F_i+1, where we use Winv_i-2; then Winv_i and
 			// Winv_i-2 can share storage, and we don't need the old _VTAV
 			// and _AVTAVSST_VTAV any more. After this, F_i+1 is stored in
-			// _DEF
+			// _DEF. This must precede the kernel, which overwrites _VTAV
 
 			TIMER_START(orthogonalization);
 			_MD.mul (_matT, _VTAV, _Winv[1 - i]);
@@ -556,9 +552,12 @@ namespace LinBox
 			_MD.mulin (_DEF, _AVTAVSST_VTAV);
 			TIMER_STOP(orthogonalization);
 
-			// Now get the next VTAV, Winv, and S_i
+			// Now get AV and the next VTAV in one pass, then Winv and S_i
+			TIMER_START(AV);
+			_kernel.apply (_AV, _VTAV, _AVTAV, A, _matV[j]);
+			TIMER_STOP(AV);
+
 			TIMER_START(Winv);
-			_MD.mul (_VTAV, transpose (_matV[j]), _AV);
 			Ni = compute_Winv_S (_Winv[i], _vecS, _VTAV);
 			TIMER_STOP(Winv);
 
@@ -598,7 +597,7 @@ namespace LinBox
 
 			// Compute the next _AVTAVSST_VTAV
 			TIMER_START(orthogonalization);
-			mul (_AVTAVSST_VTAV, transpose (_AV), _AV, _vecS);
+			mul_SST (_AVTAVSST_VTAV, _AVTAV, _vecS);
 
 			BLTraceReport (report, _MD, "V^T A^2 V", iter, _AVTAVSST_VTAV);
 
@@ -1047,6 +1046,7 @@ namespace LinBox
 		_VTAV.resize (_block, _block);
 		_Winv[0].resize (_block, _block);
 		_Winv[1].resize (_block, _block);
+		_AVTAV.resize (_block, _block);
 		_AVTAVSST_VTAV.resize (_block, _block);
 		_matT.resize (_block, _block);
 		_DEF.resize (_block, _block);
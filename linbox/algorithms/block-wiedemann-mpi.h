@@ -0,0 +1,231 @@
+/* linbox/algorithms/block-wiedemann-mpi.h
+ *
+ * ========LICENCE========
+ * This file is part of the library LinBox.
+ *
+  * LinBox is free software: you can redistribute it and/or modify
+ * it under the terms of the  GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ * ========LICENCE========
+ */
+
+/*! @file algorithms/block-wiedemann-mpi.h
+ * @ingroup algorithms
+ * @brief Block Wiedemann sequence \f$U A^i V\f$ distributed over MPI processes.
+ *
+ * Every process holds a copy of the blackbox and computes the sequence
+ * for a slice of the columns of \f$V\f$.  The slices are streamed to the
+ * process of rank 0, which assembles the matrix series and computes its
+ * minimal generator with OrderBasis.
+ */
+
+#ifndef __LINBOX_block_wiedemann_mpi_H
+#define __LINBOX_block_wiedemann_mpi_H
+
+#include "linbox/util/mpicpp.h"
+
+#ifdef __LINBOX_HAVE_MPI
+
+#include <vector>
+#include <algorithm>
+
+#include "linbox/linbox-config.h"
+#include "linbox/util/debug.h"
+#include "linbox/util/commentator.h"
+#include "linbox/matrix/dense-matrix.h"
+#include "linbox/matrix/polynomial-matrix.h"
+#include "linbox/algorithms/blackbox-block-container-base.h"
+#include "linbox/algorithms/polynomial-matrix/order-basis.h"
+
+#ifndef LINBOX_MPI_BW_TAG
+#define LINBOX_MPI_BW_TAG 17
+#endif
+
+namespace LinBox
+{
+
+	/** @brief Block Wiedemann over MPI, with column slices of \f$V\f$ on each process.
+	 *
+	 * All processes of the communicator must call the same member functions
+	 * with the same arguments (in particular the same \f$U\f$ and \f$V\f$,
+	 * e.g. generated from a common seed).  Results are only meaningful on
+	 * the process of rank 0.
+	 *
+	 * Field elements are sent as raw bytes, so this is meant for word size
+	 * fields (Givaro::Modular<double>, <uint32_t>, ...) with all processes
+	 * on the same architecture, e.g. <code>mpirun -np N</code> on one host.
+	 */
+	template<class _Field, class _Blackbox>
+	class MPIBlockWiedemannSequence {
+	public:
+		typedef _Field                                                    Field;
+		typedef typename Field::Element                                 Element;
+		typedef _Blackbox                                              Blackbox;
+		typedef BlasMatrix<Field>                                         Block;
+		typedef PolynomialMatrix<PMType::matfirst,PMStorage::plain,Field> PMatrix;
+
+	protected:
+		const Blackbox    *_BB;
+		Communicator    *_comm;
+
+	public:
+		MPIBlockWiedemannSequence(const Blackbox &A, Communicator *C) :
+			_BB(&A), _comm(C)
+		{}
+
+		const Field &field() const { return _BB->field(); }
+
+		//! columns [c0,c1) of V handled by process r
+		void slice(size_t &c0, size_t &c1, size_t n, int r) const
+		{
+			size_t np = (size_t)_comm->size();
+			size_t q = n/np, s = n%np;
+			c0 = (size_t)r*q + std::min((size_t)r, s);
+			c1 = c0 + q + ((size_t)r < s ? 1 : 0);
+		}
+
+		/** Computes \f$S_i = U A^i V\f$ for \f$i < length\f$.
+		 * Each process computes the columns of its slice of \f$V\f$ and sends
+		 * \f$U A^i V_j\f$ to rank 0 as soon as it is available; rank 0
+		 * computes its own slice in between receptions.
+		 * @param S matrix series of size \p length, m x n, only filled on rank 0
+		 */
+		void sequence(PMatrix &S, const Block &U, const Block &V, size_t length)
+		{
+			linbox_check(U.coldim() == _BB->rowdim());
+			linbox_check(V.rowdim() == _BB->coldim());
+			const size_t m = U.rowdim(), n = V.coldim(), N = V.rowdim();
+			const int me = _comm->rank();
+
+			size_t c0, c1;
+			slice(c0, c1, n, me);
+			const size_t w = c1 - c0;
+
+			BlasMatrixDomain<Field> BMD(field());
+			Block Vj(field(), N, w), Wj(field(), N, w), UVj(field(), m, w);
+			for (size_t k = 0; k < N; ++k)
+				for (size_t l = 0; l < w; ++l)
+					Vj.setEntry(k, l, V.getEntry(k, c0+l));
+			Block *cur = &Vj, *nxt = &Wj;
+
+			std::vector<Element> buf;
+			for (size_t i = 0; i < length; ++i) {
+				if (i > 0) {
+					if (w > 0) MulHelper<Field,Block>::mul(field(), *nxt, *_BB, *cur);
+					std::swap(cur, nxt);
+				}
+				if (w > 0) BMD.mul(UVj, U, *cur);
+
+				if (me != 0) {
+					buf.resize(m*w);
+					for (size_t k = 0; k < m; ++k)
+						for (size_t l = 0; l < w; ++l)
+							buf[k*w+l] = UVj.getEntry(k, l);
+					if (w > 0)
+						_comm->send(&buf[0], &buf[0]+m*w, 0, LINBOX_MPI_BW_TAG);
+					continue;
+				}
+
+				// rank 0: own slice, then the slices of the others, in order
+				for (size_t k = 0; k < m; ++k)
+					for (size_t l = 0; l < w; ++l)
+						S[i].setEntry(k, c0+l, UVj.getEntry(k, l));
+				for (int r = 1; r < _comm->size(); ++r) {
+					size_t d0, d1;
+					slice(d0, d1, n, r);
+					const size_t wr = d1 - d0;
+					if (wr == 0) continue;
+					buf.resize(m*wr);
+					_comm->recv(&buf[0], &buf[0]+m*wr, r, LINBOX_MPI_BW_TAG);
+					for (size_t k = 0; k < m; ++k)
+						for (size_t l = 0; l < wr; ++l)
+							S[i].setEntry(k, d0+l, buf[k*wr+l]);
+				}
+			}
+		}
+
+		/** Left minimal generator of \f$U A^i V\f$, computed on rank 0.
+		 *
+		 * The series \f$[S(x) ; I_n]\f$ is approximated with OrderBasis at
+		 * order \f$N/m+N/n+2\f$, with shift 0 on the rows of \f$S\f$ and 1 on
+		 * those of the identity; the m rows of smallest degree, restricted
+		 * to their first m columns and reversed, form the generator.
+		 * @param[out] P coefficients of the generator, \f$\sum_k P_k x^k\f$
+		 * @returns the degrees of the rows of the generator (empty if rank != 0)
+		 */
+		std::vector<size_t> left_minpoly(std::vector<Block> &P, const Block &U, const Block &V)
+		{
+			const size_t m = U.rowdim(), n = V.coldim(), N = V.rowdim();
+			const size_t length = N/m + N/n + 2;
+
+			commentator().start ("MPI block Wiedemann sequence", "mpi-bw");
+			PMatrix S(field(), m, n, length);
+			sequence(S, U, V, length);
+			commentator().stop ("done", NULL, "mpi-bw");
+
+			std::vector<size_t> deg;
+			if (_comm->rank() != 0)
+				return deg;
+
+			commentator().start ("Order basis of the block sequence", "mpi-bw-gen");
+			PMatrix Serie(field(), m+n, n, length);
+			for (size_t i = 0; i < length; ++i)
+				for (size_t k = 0; k < m; ++k)
+					for (size_t l = 0; l < n; ++l)
+						Serie[i].setEntry(k, l, S[i].getEntry(k, l));
+			for (size_t l = 0; l < n; ++l)
+				Serie[0].setEntry(m+l, l, field().one);
+
+			std::vector<size_t> shift(m+n, 0);
+			for (size_t i = m; i < m+n; ++i)
+				shift[i] = 1;
+
+			PMatrix Sigma(field(), m+n, m+n, length+1);
+			OrderBasis<Field> SB(field());
+			SB.PM_Basis(Sigma, Serie, length, shift);
+
+			// rows of smallest degree first
+			std::vector<size_t> perm(m+n);
+			for (size_t i = 0; i < m+n; ++i)
+				perm[i] = i;
+			std::stable_sort(perm.begin(), perm.end(),
+					 [&shift](size_t a, size_t b) { return shift[a] < shift[b]; });
+
+			size_t dmax = 0;
+			for (size_t i = 0; i < m; ++i)
+				dmax = std::max(dmax, shift[perm[i]]);
+			P.assign(dmax+1, Block(field(), m, m));
+			deg.resize(m);
+			for (size_t i = 0; i < m; ++i) {
+				const size_t d = deg[i] = shift[perm[i]];
+				for (size_t k = 0; k <= d && k < Sigma.size(); ++k)
+					for (size_t l = 0; l < m; ++l)
+						P[d-k].setEntry(i, l, Sigma[k].getEntry(perm[i], l));
+			}
+			commentator().stop ("done", NULL, "mpi-bw-gen");
+			return deg;
+		}
+	};
+
+}
+
+#endif // __LINBOX_HAVE_MPI
+#endif // __LINBOX_block_wiedemann_mpi_H
+
+// Local Variables:
+// mode: C++
+// tab-width: 4
+// indent-tabs-mode: nil
+// c-basic-offset: 4
+// End:
+// vim:sts=4:sw=4:ts=4:et:sr:cino=>s,f0,{0,g0,(0,\:0,t0,+0,=s
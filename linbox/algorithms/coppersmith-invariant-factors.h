@@ -27,6 +27,8 @@
 
 #include "linbox/algorithms/block-coppersmith-domain.h"
 #include "linbox/algorithms/blackbox-block-container.h"
+#include "linbox/algorithms/blackbox-block-container-pipelined.h"
+#include "linbox/algorithms/blackbox-block-container-sliced.h"
 //#include "linbox/algorithms/alt-blackbox-block-container.h"
 #include "linbox/matrix/random-matrix.h"
 
@@ -42,7 +44,15 @@
 namespace LinBox
 {
 
-template<class Field_,class Blackbox_,class Field2_=Field_>
+/** Invariant factors of a blackbox from its block minimal generator.
+ * The \c Sequence_ parameter selects the block Krylov sequence, e.g.
+ * BlackboxBlockContainerPipelined to overlap the sequence with the
+ * (online) Coppersmith generator computation, or, over GF(3) with a CSR
+ * or COO matrix, BlackboxBlockContainerSliced for 64-wide blocks at the
+ * cost of one scalar matrix-vector product per step.
+ */
+template<class Field_,class Blackbox_,class Field2_=Field_,
+	 class Sequence_=BlackboxBlockContainer<Field_,Blackbox_> >
 class CoppersmithInvariantFactors {
 public:
 	typedef Field_ Field;
@@ -98,7 +108,7 @@ public:
 	size_t computeFactors(PolyRingVector& diag, int earlyTerm=10)
 	{
 		//typedef AltBlackboxBlockContainer<Field,Blackbox,typename MatrixDomain<Field2_>::OwnMatrix > BBC;
-		typedef BlackboxBlockContainer<Field,Blackbox> BBC;
+		typedef Sequence_ BBC;
 		typedef BlockCoppersmithDomain<MatrixDomain<Field2_>,BBC> BCD;
 		BBC blockSeq(M_,F_,U_,V_);
 		MatrixDomain<Field2_> BMD(F_);
@@ -174,6 +184,27 @@ public:
 		return diag.size();
 	}
 
+	/** Rank of the blackbox, n minus the number of invariant factors
+	 * divisible by x (the dimension of the kernel).  With high probability
+	 * it is exact when the kernel has dimension less than the blocking
+	 * factor, otherwise it is an upper bound.
+	 */
+	size_t rank(int earlyTerm=10)
+	{
+		std::vector<PolyElement> diag;
+		computeFactors(diag,earlyTerm);
+
+		PolyDom PD(F_,"x");
+		typename Field::Element c;
+		size_t kernel=0;
+		for (size_t i = 0; i < diag.size(); ++i) {
+			PD.getEntry(c,Givaro::Degree(0),diag[i]);
+			if (F_.isZero(c))
+				++kernel;
+		}
+		return n_-kernel;
+	}
+
 protected:
 
 	Domain MD_;
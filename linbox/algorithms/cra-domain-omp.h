@@ -32,8 +32,6 @@
 
 #ifndef __LINBOX_omp_cra_H
 #define __LINBOX_omp_cra_H
-// commentator is not thread safe
-#define DISABLE_COMMENTATOR
 #include <omp.h>
 #include <set>
 #include "linbox/algorithms/cra-domain-seq.h"
@@ -66,8 +64,8 @@ namespace LinBox
 			 */
 			size_t NN = omp_get_max_threads();
 			//std::cerr << "Blocs: " << NN << " iterations." << std::endl;
-			// commentator().start ("Parallel OMP Givaro::Modular iteration", "mmcrait");
 			if (NN == 1) return Father_t::operator()(res,Iteration,primeiter);
+			commentator().start ("Parallel OMP Givaro::Modular iteration", "mmcrait");
 
 			int coprime =0;
 			int maxnoncoprime = 1000;
@@ -81,6 +79,7 @@ namespace LinBox
 						++coprime;
 						if (coprime > maxnoncoprime) {
 							std::cout << "you are running out of primes. " << maxnoncoprime << " coprime primes found";
+							commentator().stop ("done", NULL, "mmcrait");
 							return this->Builder_.result(res);
 						}
 					}
@@ -98,6 +97,7 @@ namespace LinBox
 
 #pragma omp parallel for
 				for(size_t i=0;i<NN;++i) {
+					LINBOX_INSTRUMENT_SCOPE ("cra iteration");
 					Iteration(ROUNDresidues[i], ROUNDdomains[i]);
 				}
 #pragma omp barrier
@@ -107,7 +107,7 @@ namespace LinBox
 					++this->IterCounter;
 					this->Builder_.progress( ROUNDdomains[i],ROUNDresidues[i]);
 				}
-				// commentator().report(Commentator::LEVEL_IMPORTANT, INTERNAL_DESCRIPTION) << "With prime " << *primeiter << std::endl;
+				commentator().report(Commentator::LEVEL_IMPORTANT, INTERNAL_DESCRIPTION) << "With prime " << *primeiter << std::endl;
 			}
 
 			while( ! this->Builder_.terminated() ) {
@@ -120,6 +120,7 @@ namespace LinBox
 						++coprime;
 						if (coprime > maxnoncoprime) {
 							std::cout << "you are running out of primes. " << maxnoncoprime << " coprime primes found";
+							commentator().stop ("done", NULL, "mmcrait");
 							return this->Builder_.result(res);
 						}
 					}
@@ -137,6 +138,7 @@ namespace LinBox
 
 #pragma omp parallel for
 				for(size_t i=0;i<NN;++i) {
+					LINBOX_INSTRUMENT_SCOPE ("cra iteration");
 					Iteration(ROUNDresidues[i], ROUNDdomains[i]);
 				}
 #pragma omp barrier
@@ -145,7 +147,7 @@ namespace LinBox
 					this->Builder_.progress( ROUNDdomains[i],ROUNDresidues[i]);
 				}
 			}
-			// commentator().stop ("done", NULL, "mmcrait");
+			commentator().stop ("done", NULL, "mmcrait");
 			//std::cerr << "Used: " << this->IterCounter << " primes." << std::endl;
 			return this->Builder_.result(res);
 		}
@@ -156,8 +158,8 @@ namespace LinBox
 			typedef typename CRATemporaryVectorTrait<Function, Domain>::Type_t ElementContainer;
 			size_t NN = omp_get_max_threads();
 			//std::cerr << "Blocs: " << NN << " iterations." << std::endl;
-			// commentator().start ("Parallel OMP Givaro::Modular iteration", "mmcrait");
 			if (NN == 1) return Father_t::operator()(res,Iteration,primeiter);
+			commentator().start ("Parallel OMP Givaro::Modular iteration", "mmcrait");
 
 			int coprime =0;
 			int maxnoncoprime = 1000;
@@ -171,6 +173,7 @@ namespace LinBox
 						++coprime;
 						if (coprime > maxnoncoprime) {
 							std::cout << "you are running out of primes. " << maxnoncoprime << " coprime primes found";
+							commentator().stop ("done", NULL, "mmcrait");
 							return this->Builder_.result(res);
 						}
 					}
@@ -190,6 +193,7 @@ namespace LinBox
 
 #pragma omp parallel for
 				for(size_t i=0;i<NN;++i) {
+					LINBOX_INSTRUMENT_SCOPE ("cra iteration");
 					Iteration(ROUNDresidues[i], ROUNDdomains[i]);
 				}
 #pragma omp barrier
@@ -199,7 +203,7 @@ namespace LinBox
 					++this->IterCounter;
 					this->Builder_.progress( ROUNDdomains[i],ROUNDresidues[i]);
 				}
-				// commentator().report(Commentator::LEVEL_IMPORTANT, INTERNAL_DESCRIPTION) << "With prime " << *primeiter << std::endl;
+				commentator().report(Commentator::LEVEL_IMPORTANT, INTERNAL_DESCRIPTION) << "With prime " << *primeiter << std::endl;
 			}
 
 			while( ! this->Builder_.terminated() ) {
@@ -212,6 +216,7 @@ namespace LinBox
 						++coprime;
 						if (coprime > maxnoncoprime) {
 							std::cout << "you are running out of primes. " << maxnoncoprime << " coprime primes found";
+							commentator().stop ("done", NULL, "mmcrait");
 							return this->Builder_.result(res);
 						}
 					}
@@ -231,6 +236,7 @@ namespace LinBox
 
 #pragma omp parallel for
 				for(size_t i=0;i<NN;++i) {
+					LINBOX_INSTRUMENT_SCOPE ("cra iteration");
 					Iteration(ROUNDresidues[i], ROUNDdomains[i]);
 				}
 #pragma omp barrier
@@ -239,7 +245,7 @@ namespace LinBox
 					this->Builder_.progress( ROUNDdomains[i],ROUNDresidues[i]);
 				}
 			}
-			// commentator().stop ("done", NULL, "mmcrait");
+			commentator().stop ("done", NULL, "mmcrait");
 			//std::cerr << "Used: " << this->IterCounter << " primes." << std::endl;
 			return this->Builder_.result(res);
 		}
@@ -35,8 +35,11 @@
 #include "linbox/solutions/methods.h"
 #include "linbox/vector/blas-vector.h"
 #include <utility>
+#include <vector>
+#include <algorithm>
 #include <stdlib.h>
 #include "linbox/util/commentator.h"
+#include "linbox/util/instrument.h"
 
 namespace LinBox
 {
@@ -160,7 +163,14 @@ namespace LinBox
 #ifdef _LB_CRATIMING
                     Timer chrono; chrono.start();
 #endif
-                    Builder_.initialize( D, Iteration(r, D) );
+                    {
+                        LINBOX_INSTRUMENT_SCOPE ("cra iteration");
+                        Iteration(r, D);
+                    }
+                    {
+                        LINBOX_INSTRUMENT_SCOPE ("cra reconstruction");
+                        Builder_.initialize( D, r );
+                    }
 #ifdef _LB_CRATIMING
                     chrono.stop();
                     std::clog << "1st iter : " << chrono << std::endl;
@@ -190,12 +200,85 @@ namespace LinBox
                     ++primeiter; ++nbprimes;
 
 					auto r = CRAResidue<ResultType>::create(D);
-                    Builder_.progress( D, Iteration(r, D) );
+                    {
+                        LINBOX_INSTRUMENT_SCOPE ("cra iteration");
+                        Iteration(r, D);
+                    }
+                    {
+                        LINBOX_INSTRUMENT_SCOPE ("cra reconstruction");
+                        Builder_.progress( D, r );
+                    }
                 }
                 Builder_.result(res);
 				return Builder_.terminated();
             }
 
+            /** \brief The \ref CRA loop, k primes per iteration.
+             *
+             * As operator()(res, Iteration, primeiter), but \p Iteration
+             * is called as \c Iteration(r, D) with a vector of \p k
+             * distinct prime domains \p D, and fills the vector \p r of
+             * their \p k residues.  This lets one pass over the data
+             * serve several primes, as with MultiModSparseMatrix.  All
+             * the \p k residues are given to the builder.
+             *
+             * @warning  We won't detect bad primes.
+             */
+		template<class ResultType, class Function, class PrimeIterator>
+		ResultType& batch (ResultType& res, Function& Iteration, PrimeIterator& primeiter, size_t k)
+            {
+                typedef typename CRAResidue<ResultType>::template ResidueType<Domain> Residue;
+                commentator().start ("Givaro::Modular batched iteration", "mmcrabat");
+                if (k == 0) k = 1;
+                int coprime = 0;
+                const int maxnoncoprime = 1000;
+                std::vector<Domain> D;
+                std::vector<Residue> r;
+                while (IterCounter == 0 || ! Builder_.terminated()) {
+                    std::vector<Integer> primes;
+                    while (primes.size() < k) {
+                        if (Builder_.noncoprime(*primeiter)
+                            || std::find(primes.begin(), primes.end(), Integer(*primeiter)) != primes.end()) {
+                            ++primeiter;
+                            if (++coprime > maxnoncoprime) {
+                                commentator().report(Commentator::LEVEL_ALWAYS,INTERNAL_ERROR) << "you are running out of primes. " << IterCounter << " used and " << maxnoncoprime << " coprime primes tried for a new one.";
+                                Builder_.result(res);
+                                commentator().stop ("done", NULL, "mmcrabat");
+                                return res; // the error should indicate the result is wrong
+                            }
+                            continue;
+                        }
+                        coprime = 0;
+                        primes.push_back(*primeiter);
+                        ++primeiter;
+                    }
+                    commentator().report(Commentator::LEVEL_IMPORTANT, INTERNAL_DESCRIPTION) << "With " << k << " primes from " << primes[0] << std::endl;
+
+                    // the residues refer to their domain: D is complete before they are built
+                    D.clear(); D.reserve(k);
+                    for (size_t l = 0; l < k; ++l)
+                        D.push_back(Domain(primes[l]));
+                    r.clear(); r.reserve(k);
+                    for (size_t l = 0; l < k; ++l)
+                        r.push_back(CRAResidue<ResultType>::create(D[l]));
+
+                    {
+                        LINBOX_INSTRUMENT_SCOPE ("cra iteration");
+                        Iteration(r, D);
+                    }
+                    LINBOX_INSTRUMENT_SCOPE ("cra reconstruction");
+                    for (size_t l = 0; l < k; ++l, ++IterCounter) {
+                        if (IterCounter == 0)
+                            Builder_.initialize(D[l], r[l]);
+                        else
+                            Builder_.progress(D[l], r[l]);
+                    }
+                }
+                Builder_.result(res);
+                commentator().stop ("done", NULL, "mmcrabat");
+                return res;
+            }
+
 		template<class Param>
 		bool changeFactor(const Param& p)
             {
@@ -37,6 +37,8 @@
 #include "linbox/vector/vector-domain.h"
 #include "linbox/algorithms/gauss.h"
 #include "linbox/blackbox/zo-gf2.h"
+#include "linbox/matrix/densematrix/m4ri-matrix.h"
+#include "linbox/matrix/matrixdomain/matrix-domain-m4ri.h"
 
 /** @file algorithms/gauss-gf2.h
  * @brief  Gauss elimination and applications for sparse matrices on \f$F_2\f$.
@@ -56,20 +58,45 @@ namespace LinBox
 		// Preferred Matrix type
 		using Matrix=ZeroOne<GF2>;
 
+	private:
+		double        _denseDensity;
+		size_t         _denseMinDim;
+
 	public:
 
 		/** \brief The field parameter is the domain  over which to perform computations.
 		 */
-		GaussDomain (const Field &) {}
+		GaussDomain (const Field &) :
+			_denseDensity (__LINBOX_GAUSS_DENSE_SWITCH__)
+			, _denseMinDim (__LINBOX_GAUSS_DENSE_MINDIM__)
+		{}
 
 		//Copy constructor
 		///
-		GaussDomain (const GaussDomain &)  {}
+		GaussDomain (const GaussDomain &Mat) :
+			_denseDensity (Mat._denseDensity)
+			, _denseMinDim (Mat._denseMinDim)
+		{}
 
 		/** accessor for the field of computation.
 		*/
 		const Field &field () const { return *(new GF2()); }
 
+		/** \brief Threshold of the sparse to dense switch.
+		 *
+		 * As in the generic GaussDomain, except that the remaining
+		 * submatrix is packed in an M4RIMatrix and eliminated by
+		 * M4RIMatrixDomain.
+		 */
+		void setDenseSwitch (double density, size_t minDim = __LINBOX_GAUSS_DENSE_MINDIM__)
+		{
+			_denseDensity = density;
+			_denseMinDim = minDim;
+		}
+
+		//! density threshold of the sparse to dense switch
+		double denseSwitch () const { return _denseDensity; }
+
 		/** @name rank
 		  Callers of the different rank routines
 		  @li  The "in" suffix indicates in place computation
@@ -233,6 +260,30 @@ namespace LinBox
 		template <class Vector>
 		void SparseFindPivotBinary (Vector &lignepivot, unsigned long &indcol, long &indpermut, Element& determinant) const;
 
+		bool switchToDense (size_t nnz, size_t m, size_t n) const
+		{
+			return (m >= _denseMinDim) && (n >= _denseMinDim)
+				&& (double(nnz) > _denseDensity * double(m) * double(n));
+		}
+
+		//------------------------------------------
+		// Dense end of the elimination: rows k.. and
+		// columns Rank.. are packed and eliminated by PLE.
+		// U is written back in the rows k.., the column
+		// permutation is applied to P and to the rows < k.
+		// If L is given, the row exchanges and the multipliers
+		// are recorded in invQ and L, as in QLUPin.
+		//------------------------------------------
+		template <class SparseSeqMatrix, class Perm>
+		unsigned long& DenseLinearPivotingBinary (unsigned long &Rank,
+							  SparseSeqMatrix &LigneA,
+							  Perm &P,
+							  unsigned long k,
+							  unsigned long Ni,
+							  unsigned long Nj,
+							  SparseSeqMatrix *LigneL = NULL,
+							  std::deque<std::pair<size_t,size_t> > *invQ = NULL) const;
+
 	};
 } // namespace LinBox
 
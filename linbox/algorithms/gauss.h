@@ -47,8 +47,27 @@
 #include "linbox/field/archetype.h"
 #include "linbox/field/gf2.h"
 #include "linbox/matrix/sparse-matrix.h"
+#include "linbox/vector/sparse-accumulator.h"
 #include "linbox/matrix/archetype.h"
 #include "linbox/solutions/methods.h"
+#include <givaro/ring-interface.h>
+#include <type_traits>
+#include <deque>
+#include <vector>
+
+// Density of the remaining submatrix above which the elimination
+// is finished with dense PLUQ (see GaussDomain::setDenseSwitch)
+#ifndef __LINBOX_GAUSS_DENSE_SWITCH__
+#define __LINBOX_GAUSS_DENSE_SWITCH__ 0.1
+#endif
+// Smallest remaining row and column dimensions for the dense switch
+#ifndef __LINBOX_GAUSS_DENSE_MINDIM__
+#define __LINBOX_GAUSS_DENSE_MINDIM__ 64
+#endif
+// 0 to build the eliminations without their dense end over FFLAS-FFPACK
+#ifndef __LINBOX_GAUSS_DENSE_PLUQ__
+#define __LINBOX_GAUSS_DENSE_PLUQ__ 1
+#endif
 
 /** @file algorithms/gauss.h
  * @brief  Gauss elimination and applications for sparse matrices.
@@ -76,6 +95,12 @@ namespace LinBox
 
 	private:
 		const Field         *_field;
+		double        _denseDensity;
+		size_t         _denseMinDim;
+
+		// dense PLUQ is only available over FFLAS-FFPACK fields
+		typedef std::integral_constant<bool, (__LINBOX_GAUSS_DENSE_PLUQ__ != 0)
+			&& std::is_base_of<Givaro::FiniteRingInterface<Element>,_Field>::value> HasFFLAS;
 
 	public:
 
@@ -84,18 +109,39 @@ namespace LinBox
 		 */
 		GaussDomain (const Field &F) :
 			_field (&F)
+			, _denseDensity (__LINBOX_GAUSS_DENSE_SWITCH__)
+			, _denseMinDim (__LINBOX_GAUSS_DENSE_MINDIM__)
 		{}
 
 		//Copy constructor
 		///
 		GaussDomain (const GaussDomain &Mat) :
 			_field (Mat._field)
+			, _denseDensity (Mat._denseDensity)
+			, _denseMinDim (Mat._denseMinDim)
 		{}
 
 		/** accessor for the field of computation
 		*/
 		const Field &field () const { return *_field; }
 
+		/** \brief Threshold of the sparse to dense switch.
+		 *
+		 * Fill-in makes the remaining submatrix denser at each step.  When
+		 * its density exceeds \p density, and both its dimensions are at
+		 * least \p minDim, rank, det, solve and nullspace finish the
+		 * elimination with a dense PLUQ (FFLAS-FFPACK fields only).
+		 * A density of 1 or more disables the switch.
+		 */
+		void setDenseSwitch (double density, size_t minDim = __LINBOX_GAUSS_DENSE_MINDIM__)
+		{
+			_denseDensity = density;
+			_denseMinDim = minDim;
+		}
+
+		//! density threshold of the sparse to dense switch
+		double denseSwitch () const { return _denseDensity; }
+
 		/** @name rank
 		  Callers of the different rank routines\\
 		  -/ The "in" suffix indicates in place computation\\
@@ -243,6 +289,54 @@ namespace LinBox
 						     unsigned long Nj) const;
 
 
+		/** \brief Sparse Gaussian elimination with Markowitz pivoting.
+
+		  The pivot minimizes \f$(r_i-1)(c_j-1)\f$ over the rows of the
+		  __LINBOX_MARKOWITZ_SEARCH__ columns of smallest count \f$c_j\f$,
+		  found through a priority queue.  Fill-in is reported to the
+		  commentator.  In place; past the dense switch, what is left is
+		  handed to InPlaceLinearPivoting.
+		  */
+		template <class _Matrix>
+		unsigned long& MarkowitzPivoting(unsigned long &rank,
+						 Element& determinant,
+						 _Matrix        &A,
+						 unsigned long Ni,
+						 unsigned long Nj) const;
+
+		/** \brief Structured Gaussian elimination.
+
+		  Columns with more than \f$\max(16,\sqrt{N_i})\f$ entries are
+		  heavy and never pivoted on.  Singleton columns, columns of
+		  weight 2 (if the pivot row is short) and rows with one light
+		  entry are eliminated until none is left; the remaining, much
+		  smaller, matrix is eliminated by InPlaceLinearPivoting.  In place.
+		  */
+		template <class _Matrix>
+		unsigned long& StructuredPivoting(unsigned long &rank,
+						  Element& determinant,
+						  _Matrix        &A,
+						  unsigned long Ni,
+						  unsigned long Nj) const;
+
+
+		/** \brief Sparse Gaussian elimination by sets of independent pivots.
+
+		  Each step chooses, in the rows by increasing size, pivots
+		  no two of which share a row or a column of the active part,
+		  nor have an entry in the column of another; all the other
+		  rows are then reduced by the whole set, in parallel with
+		  OpenMP, each thread using a dense accumulator.  In place; past
+		  the dense switch, what is left is handed to InPlaceLinearPivoting.
+		  */
+		template <class _Matrix>
+		unsigned long& ParallelPivoting(unsigned long &rank,
+						Element& determinant,
+						_Matrix        &A,
+						unsigned long Ni,
+						unsigned long Nj) const;
+
+
 		/** \brief Sparse Gaussian elimination without reordering.
 
 		  Gaussian elimination is done on a copy of the matrix.
@@ -299,6 +393,24 @@ Using : FindPivot and LU
 				const long &indpermut,
 				D                   &columns) const;
 
+		// Same, the row being updated in the dense accumulator spa,
+		// kept for the whole elimination
+		template <class Vector, class D>
+		void eliminate (Vector              &lignecourante,
+				const Vector        &lignepivot,
+				const unsigned long &indcol,
+				const long &indpermut,
+				D                   &columns,
+				SparseAccumulator<Field> &spa) const;
+
+		template <class Vector, class D>
+		void eliminate (Vector              &lignecourante,
+				const Vector        &lignepivot,
+				const unsigned long &indcol,
+				const long &indpermut,
+				D                   &columns,
+				SparseAccumulator<Field> *spa) const;
+
 		template <class Vector>
 		void permute (Vector              &lignecourante,
 			      const unsigned long &indcol,
@@ -371,6 +483,72 @@ Using : FindPivot and LU
 				      unsigned long Nj) const;
 
         
+		// Eliminates the active part of W after Markowitz or SGE pivots
+		// on the rows pr and columns pc; completes rank and determinant
+		template <class Work>
+		unsigned long& RemainderPivoting(unsigned long &rank,
+						 Element& determinant,
+						 Work &W,
+						 std::vector<size_t> &pr,
+						 std::vector<size_t> &pc,
+						 unsigned long Ni,
+						 unsigned long Nj) const;
+
+		// true if the remaining m x n submatrix, with nnz non zero
+		// entries, is to be eliminated densely
+		bool switchToDense (size_t nnz, size_t m, size_t n) const
+		{
+			return (m >= _denseMinDim) && (n >= _denseMinDim)
+				&& (double(nnz) > _denseDensity * double(m) * double(n));
+		}
+
+		// switchToDense at step k of QLUPin or InPlaceLinearPivoting,
+		// over FFLAS-FFPACK fields, reported when it switches
+		bool switchToDenseAt (size_t k, size_t nnz, size_t m, size_t n) const
+		{
+			if (! (HasFFLAS::value && switchToDense (nnz, m, n)))
+				return false;
+			commentator().report (Commentator::LEVEL_NORMAL, PARTIAL_RESULT)
+			<< "Dense switch at step " << k << ": " << nnz << " elements in "
+			<< m << 'x' << n << std::endl;
+			return true;
+		}
+
+		// Dense end of InPlaceLinearPivoting: rows k.. and columns
+		// Rank.. are eliminated by PLUQ, updating rank and determinant
+		template <class _Matrix>
+		unsigned long& DenseLinearPivoting(unsigned long &rank,
+						   Element& determinant,
+						   _Matrix        &A,
+						   unsigned long k,
+						   unsigned long Ni,
+						   unsigned long Nj,
+						   std::true_type) const;
+		template <class _Matrix>
+		unsigned long& DenseLinearPivoting(unsigned long &rank,
+						   Element&, _Matrix&,
+						   unsigned long, unsigned long, unsigned long,
+						   std::false_type) const
+		{ return rank; }
+
+		// Same as the latter, but U is written back in the rows k..
+		// and the column permutation is applied to P and to the rows < k
+		template <class _Matrix, class Perm>
+		unsigned long& DenseLinearPivoting(unsigned long &rank,
+						   Element& determinant,
+						   _Matrix        &A,
+						   Perm          &P,
+						   unsigned long k,
+						   unsigned long Ni,
+						   unsigned long Nj,
+						   std::true_type) const;
+		template <class _Matrix, class Perm>
+		unsigned long& DenseLinearPivoting(unsigned long &rank,
+						   Element&, _Matrix&, Perm&,
+						   unsigned long, unsigned long, unsigned long,
+						   std::false_type) const
+		{ return rank; }
+
 		template <class _Matrix, class Perm, bool hasFFLAS>
         struct Continuation {
             unsigned long& operator()(
@@ -395,6 +573,8 @@ Using : FindPivot and LU
 #include "linbox/algorithms/gauss/gauss-nullspace.inl"
 #include "linbox/algorithms/gauss/gauss-rank.inl"
 #include "linbox/algorithms/gauss/gauss-det.inl"
+#include "linbox/algorithms/gauss/gauss-markowitz.inl"
+#include "linbox/algorithms/gauss/gauss-parallel.inl"
 
 #endif // __LINBOX_gauss_H
 
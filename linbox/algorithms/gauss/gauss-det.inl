@@ -39,10 +39,22 @@ namespace LinBox
 				   SparseEliminationTraits::PivotStrategy   reord)  const
 	{
 		unsigned long Rank;
-		if (reord == SparseEliminationTraits::PIVOT_NONE)
+		switch (reord) {
+		case SparseEliminationTraits::PIVOT_NONE:
 			NoReordering(Rank, determinant, A,  Ni, Nj);
-		else
+			break;
+		case SparseEliminationTraits::PIVOT_MARKOWITZ:
+			MarkowitzPivoting(Rank, determinant, A, Ni, Nj);
+			break;
+		case SparseEliminationTraits::PIVOT_SGE:
+			StructuredPivoting(Rank, determinant, A, Ni, Nj);
+			break;
+		case SparseEliminationTraits::PIVOT_PARALLEL:
+			ParallelPivoting(Rank, determinant, A, Ni, Nj);
+			break;
+		default:
 			InPlaceLinearPivoting(Rank, determinant, A, Ni, Nj);
+		}
 		return determinant;
 	}
 
@@ -125,6 +125,31 @@ namespace LinBox
 					const long &indpermut,
 					D                   &columns) const
 	{
+		eliminate (lignecourante, lignepivot, indcol, indpermut, columns,
+			   (SparseAccumulator<Field> *)0);
+	}
+
+	template <class _Field>
+	template <class Vector, class D> inline void
+	GaussDomain<_Field>::eliminate (Vector              &lignecourante,
+					const Vector        &lignepivot,
+					const unsigned long &indcol,
+					const long &indpermut,
+					D                   &columns,
+					SparseAccumulator<Field> &spa) const
+	{
+		eliminate (lignecourante, lignepivot, indcol, indpermut, columns, &spa);
+	}
+
+	template <class _Field>
+	template <class Vector, class D> inline void
+	GaussDomain<_Field>::eliminate (Vector              &lignecourante,
+					const Vector        &lignepivot,
+					const unsigned long &indcol,
+					const long &indpermut,
+					D                   &columns,
+					SparseAccumulator<Field> *spa) const
+	{
 
 		typedef typename Vector::value_type E;
 		typedef typename E::first_type E1;
@@ -181,6 +206,23 @@ namespace LinBox
 					// -------------------------------------------
 					// Elimination
 					unsigned long npiv = lignepivot.size ();
+					if (spa) {
+						// A[i,k] <-- - A[i,k] / A[k,k]
+						Element headcoeff;
+						field().divin (field().neg (headcoeff, lignecourante[(size_t)j_head].second),
+							       lignepivot[0].second);
+						unsigned long l = 0;
+						for (; l < npiv; l++)
+							if (lignepivot[l].first > k) break;
+
+						// the head vanishes, its column count is
+						// updated by gather
+						spa->scatter (lignecourante);
+						spa->cancel ((size_t)lignecourante[(size_t)j_head].first);
+						spa->axpy (headcoeff, lignepivot, l);
+						spa->gather (lignecourante, columns);
+						return;
+					}
 					Vector construit (nj + npiv);
 
 					// construit : <-- j
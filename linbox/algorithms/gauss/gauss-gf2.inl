@@ -30,6 +30,7 @@
 #include "linbox/algorithms/gauss.h"
 #include "linbox/util/commentator.h"
 #include <utility>
+#include <algorithm>
 
 #ifdef __LINBOX_ALL__ //BB: ???
 #ifndef __LINBOX_COUNT__
@@ -74,13 +75,18 @@ namespace LinBox
 
 
 		// assignment of LigneA with the domain object
-		for (unsigned long jj = 0; jj < Ni; ++jj)
+		// nnz is the number of elements in the rows k..Ni-1
+		size_t nnz = 0;
+		for (unsigned long jj = 0; jj < Ni; ++jj) {
+			nnz += LigneA[jj].size ();
 			for (unsigned long k = 0; k < LigneA[jj].size (); k++)
 				++col_density[LigneA[jj][(size_t)k]];
+		}
 
 		long last = (long)Ni - 1;
 		long c;
 		Rank = 0;
+		bool dense = false;
 
 #ifdef __LINBOX_OFTEN__
 		long sstep = last/40;
@@ -92,6 +98,12 @@ namespace LinBox
 
 		typename SparseSeqMatrix::iterator LigneA_k = LigneA.begin();
 		for (long k = 0; k < last; ++k, ++LigneA_k) {
+			if (switchToDense(nnz, Ni-(size_t)k, Nj-Rank)) {
+				DenseLinearPivotingBinary (Rank, LigneA, P, (size_t)k, Ni, Nj);
+				dense = true;
+				break;
+			}
+
 			long p = k, s = 0;
 
 #ifdef __LINBOX_FILLIN__
@@ -149,9 +161,12 @@ namespace LinBox
 							permuteBinary( LigneA[(size_t)ll], Rank, c);
 					}
 					long npiv=(long)LigneA_k->size();
+					nnz -= (size_t)npiv;
 					for (ll = k+1; ll < static_cast<long>(Ni); ++ll) {
 						bool elim=false;
+						nnz -= LigneA[(size_t)ll].size ();
 						eliminateBinary (elim, LigneA[(size_t)ll], *LigneA_k, Rank, c, (size_t)npiv, col_density);
+						nnz += LigneA[(size_t)ll].size ();
 					}
 				}
 
@@ -163,12 +178,14 @@ namespace LinBox
 			// LigneA.write(rep << "U:= ", Tag::FileFormat::Maple) << std::endl;
 		}//for k
 
-		SparseFindPivotBinary ( LigneA[(size_t)last], Rank, c, determinant);
-		if (c != -1) {
-			if ( c != (static_cast<long>(Rank)-1) ) {
-				P.permute(Rank-1,(size_t)c);
-				for (long ll=0      ; ll < last ; ++ll)
-					permuteBinary( LigneA[(size_t)ll], Rank, c);
+		if (! dense) {
+			SparseFindPivotBinary ( LigneA[(size_t)last], Rank, c, determinant);
+			if (c != -1) {
+				if ( c != (static_cast<long>(Rank)-1) ) {
+					P.permute(Rank-1,(size_t)c);
+					for (long ll=0      ; ll < last ; ++ll)
+						permuteBinary( LigneA[(size_t)ll], Rank, c);
+				}
 			}
 		}
 
@@ -251,13 +268,18 @@ namespace LinBox
 		std::deque<std::pair<size_t,size_t> > invQ;
 
 		// assignment of LigneA with the domain object
-		for (unsigned long jj = 0; jj < Ni; ++jj)
+		// nnz is the number of elements in the rows k..Ni-1
+		size_t nnz = 0;
+		for (unsigned long jj = 0; jj < Ni; ++jj) {
+			nnz += LigneA[jj].size ();
 			for (unsigned long k = 0; k < LigneA[jj].size (); k++)
 				++col_density[LigneA[jj][(size_t)k]];
+		}
 
 		long last = (long)Ni - 1;
 		long c;
 		Rank = 0;
+		bool dense = false;
 
 #ifdef __LINBOX_OFTEN__
 		long sstep = last/40;
@@ -269,6 +291,12 @@ namespace LinBox
 
 		typename SparseSeqMatrix::iterator LigneA_k = LigneA.begin();
 		for (long k = 0; k < last; ++k, ++LigneA_k) {
+			if (switchToDense(nnz, Ni-(size_t)k, Nj-Rank)) {
+				DenseLinearPivotingBinary (Rank, LigneA, P, (size_t)k, Ni, Nj, &LigneL, &invQ);
+				dense = true;
+				break;
+			}
+
 			long p = k, s = 0;
 
 #ifdef __LINBOX_FILLIN__
@@ -328,9 +356,12 @@ namespace LinBox
 							permuteBinary( LigneA[(size_t)ll], Rank, c);
 					}
 					long npiv=(long)LigneA_k->size();
+					nnz -= (size_t)npiv;
 					for (ll = k+1; ll < static_cast<long>(Ni); ++ll) {
 						E hc; hc=Rank-1; bool elim=false;
+						nnz -= LigneA[(size_t)ll].size ();
 						eliminateBinary (elim, LigneA[(size_t)ll], *LigneA_k, Rank, c, (size_t)npiv, col_density);
+						nnz += LigneA[(size_t)ll].size ();
 						if(elim) LigneL[(size_t)ll].push_back(hc);
 					}
 				}
@@ -345,17 +376,18 @@ namespace LinBox
 			//  LigneA.write(rep << "U:= ", Tag::FileFormat::Maple) << std::endl;
 		}//for k
 
-		SparseFindPivotBinary ( LigneA[(size_t)last], Rank, c, determinant);
-		if (c != -1) {
-			if ( c != (static_cast<long>(Rank)-1) ) {
-				P.permute(Rank-1,(size_t)c);
-				for (long ll=0      ; ll < last ; ++ll)
-					permuteBinary( LigneA[(size_t)ll], Rank, c);
+		if (! dense) {
+			SparseFindPivotBinary ( LigneA[(size_t)last], Rank, c, determinant);
+			if (c != -1) {
+				if ( c != (static_cast<long>(Rank)-1) ) {
+					P.permute(Rank-1,(size_t)c);
+					for (long ll=0      ; ll < last ; ++ll)
+						permuteBinary( LigneA[(size_t)ll], Rank, c);
+				}
 			}
+			LigneL[(size_t)last].push_back((size_t)last);
 		}
 
-		LigneL[(size_t)last].push_back((size_t)last);
-
 #ifdef __LINBOX_COUNT__
 		nbelem += LigneA[(size_t)last].size ();
 		commentator().report (Commentator::LEVEL_NORMAL, PARTIAL_RESULT)
@@ -400,6 +432,76 @@ namespace LinBox
 	}
 
 
+	template <class SparseSeqMatrix, class Perm> inline unsigned long&
+	GaussDomain<GF2>::DenseLinearPivotingBinary (unsigned long &Rank,
+						     SparseSeqMatrix &LigneA,
+						     Perm &P,
+						     unsigned long k,
+						     unsigned long Ni,
+						     unsigned long Nj,
+						     SparseSeqMatrix *LigneL,
+						     std::deque<std::pair<size_t,size_t> > *invQ) const
+	{
+		typedef typename SparseSeqMatrix::value_type Vector;
+		typedef typename Vector::value_type E;
+
+		// The rows k.. have no element left in the columns < Rank
+		const size_t sNi = Ni-k, sNj = Nj-Rank;
+		commentator().report (Commentator::LEVEL_NORMAL, PARTIAL_RESULT)
+		<< "Dense switch at step " << k << ": " << sNi << 'x' << sNj << " remaining" << std::endl;
+
+		GF2 F2;
+		M4RIMatrix A (F2, sNi, sNj);
+		for (size_t di = k; di < Ni; ++di) {
+			for (size_t dj = 0; dj < LigneA[di].size (); ++dj)
+				A.setEntry (di-k, (size_t)LigneA[di][dj]-Rank, true);
+			LigneA[di].resize (0);
+		}
+
+		std::vector<size_t> P2, Q2;
+		const size_t R2 = M4RIMatrixDomain (F2).ple (A, P2, Q2);
+
+		if (LigneL != NULL) {
+			// PLE exchanges rows as the sparse steps do, one pivot at a time
+			for (size_t i = 0; i < R2; ++i)
+				if (P2[i] != i) {
+					invQ->push_front (std::pair<size_t,size_t> (k+i, k+P2[i]));
+					std::swap ((*LigneL)[k+i], (*LigneL)[k+P2[i]]);
+				}
+			// multipliers are in the pivot columns, below the pivots
+			for (size_t i = 0; i < sNi; ++i) {
+				for (size_t j = 0; j < R2 && j < i; ++j)
+					if (A.getEntry (i, Q2[j]))
+						(*LigneL)[k+i].push_back ((E)(Rank+j));
+				(*LigneL)[k+i].push_back ((E)(k+i));
+			}
+		}
+
+		// pivot i is moved to the column Rank+i
+		std::vector<size_t> pos (sNj), col (sNj);
+		for (size_t j = 0; j < sNj; ++j)
+			pos[j] = col[j] = j;
+		for (size_t i = 0; i < R2; ++i)
+			if (Q2[i] != i) {
+				pos[col[i]] = Q2[i];
+				pos[col[Q2[i]]] = i;
+				std::swap (col[i], col[Q2[i]]);
+				P.permute (Rank+i, Rank+Q2[i]);
+				for (size_t l = 0; l < k; ++l)
+					permuteBinary (LigneA[l], Rank+i+1, (long)(Rank+Q2[i]));
+			}
+
+		for (size_t i = 0; i < R2; ++i) {
+			Vector &row = LigneA[k+i];
+			for (size_t j = Q2[i]; j < sNj; ++j)
+				if (A.getEntry (i, j))
+					row.push_back ((E)(Rank+pos[j]));
+			std::sort (row.begin (), row.end ());
+		}
+
+		return Rank += R2;
+	}
+
 } // namespace LinBox
 
 #endif // __LINBOX_gauss_gf2_INL
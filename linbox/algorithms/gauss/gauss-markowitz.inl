@@ -0,0 +1,460 @@
+/* linbox/algorithms/gauss/gauss-markowitz.inl
+ *
+ * ========LICENCE========
+ * This file is part of the library LinBox.
+ *
+ * LinBox is free software: you can redistribute it and/or modify
+ * it under the terms of the  GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ * ========LICENCE========
+ *.
+ *
+ * Markowitz pivoting and structured Gaussian elimination
+ */
+#ifndef __LINBOX_gauss_markowitz_INL
+#define __LINBOX_gauss_markowitz_INL
+
+#include <vector>
+#include <queue>
+#include <functional>
+#include <algorithm>
+#include <cmath>
+
+// Number of columns of smallest count examined for a Markowitz pivot
+#ifndef __LINBOX_MARKOWITZ_SEARCH__
+#define __LINBOX_MARKOWITZ_SEARCH__ 4
+#endif
+
+// Longest pivot row merged into the other row of a column of weight 2
+#ifndef __LINBOX_SGE_MERGE__
+#define __LINBOX_SGE_MERGE__ 16
+#endif
+
+namespace LinBox
+{
+	/* Right-looking elimination state shared by Markowitz pivoting and
+	 * structured Gaussian elimination: the rows of A, the number of active
+	 * entries per column and, per column, the rows which may have an entry
+	 * in it.  These lists are only cleaned up when read, so entries
+	 * cancelled by an elimination cost nothing.
+	 */
+	template <class Field, class _Matrix>
+	class GaussMarkowitzWork {
+	public:
+		typedef typename Field::Element Element;
+		typedef _Matrix                  Matrix;
+		typedef typename _Matrix::Row   Row;
+		typedef typename Row::value_type  E;
+
+		GaussMarkowitzWork (const Field &F, _Matrix &A, size_t Ni, size_t Nj) :
+			_field (&F), _A (A),
+			_count (Nj, 0), _rows (Nj), _heavy (Nj, false),
+			_rowActive (Ni, true), _colActive (Nj, true),
+			_nRows (Ni), _nCols (Nj),
+			_rowStamp (Ni, 0), _colStamp (Nj, 0), _time (0), _ptime (0),
+			_nnz (0), _fill (0)
+		{
+			for (size_t i = 0; i < Ni; ++i) {
+				_nnz += _A[i].size ();
+				for (size_t k = 0; k < _A[i].size (); ++k) {
+					++_count[(size_t)_A[i][k].first];
+					_rows[(size_t)_A[i][k].first].push_back (i);
+				}
+			}
+			_nnz0 = _nnz;
+		}
+
+		const Field &field () const { return *_field; }
+
+		Row &row (size_t i) { return _A[i]; }
+		size_t count (size_t j) const { return _count[j]; }
+		bool rowActive (size_t i) const { return _rowActive[i]; }
+		bool colActive (size_t j) const { return _colActive[j]; }
+		size_t activeRows () const { return _nRows; }
+		size_t activeCols () const { return _nCols; }
+
+		//! heavy columns never hold a pivot
+		bool heavy (size_t j) const { return _heavy[j]; }
+		void setHeavy (size_t j) { _heavy[j] = true; }
+
+		//! entries in the active part, at start, and created by eliminations
+		size_t nnz () const { return _nnz; }
+		size_t initialNnz () const { return _nnz0; }
+		size_t fill () const { return _fill; }
+
+		// position of column j in row i, or the row size
+		size_t find (size_t i, size_t j) const
+		{
+			const Row &r = _A[i];
+			size_t lo = 0, hi = r.size ();
+			while (lo < hi) {
+				const size_t mid = (lo + hi) / 2;
+				if ((size_t)r[mid].first < j) lo = mid + 1;
+				else hi = mid;
+			}
+			return (lo < r.size () && (size_t)r[lo].first == j) ? lo : r.size ();
+		}
+
+		// active rows having an entry in column j
+		const std::vector<size_t> &rowsOf (size_t j)
+		{
+			++_time;
+			std::vector<size_t> &L = _rows[j];
+			size_t n = 0;
+			for (size_t t = 0; t < L.size (); ++t) {
+				const size_t i = L[t];
+				if (_rowActive[i] && (_rowStamp[i] != _time) && (find (i, j) < _A[i].size ())) {
+					_rowStamp[i] = _time;
+					L[n++] = i;
+				}
+			}
+			L.resize (n);
+			return L;
+		}
+
+		/* Pivot on (i,j): the other rows of column j are reduced by row i,
+		 * then row i and column j leave the active part.  The columns whose
+		 * count changed are listed in touched().
+		 */
+		void pivot (size_t i, size_t j, Element &determinant)
+		{
+			++_ptime;
+			_touched.clear ();
+			const std::vector<size_t> col (rowsOf (j));
+			const Row &piv = _A[i];
+			const Element &p = piv[find (i, j)].second;
+			field ().mulin (determinant, p);
+			Element inv;
+			field ().inv (inv, p);
+
+			for (size_t t = 0; t < col.size (); ++t) {
+				const size_t l = col[t];
+				if (l == i) continue;
+				Element m;
+				field ().mul (m, _A[l][find (l, j)].second, inv);
+				field ().negin (m);
+				axpy (l, m, i, j);
+			}
+
+			_rowActive[i] = false; --_nRows;
+			_colActive[j] = false; --_nCols;
+			for (size_t k = 0; k < piv.size (); ++k) {
+				--_count[(size_t)piv[k].first];
+				touch ((size_t)piv[k].first);
+			}
+			_nnz -= piv.size ();
+		}
+
+		const std::vector<size_t> &touched () const { return _touched; }
+
+	protected:
+		// row l += m row i, the entry in column j cancelling
+		void axpy (size_t l, const Element &m, size_t i, size_t j)
+		{
+			Row &r = _A[l];
+			const Row &p = _A[i];
+			Row res;
+			res.reserve (r.size () + p.size ());
+			size_t a = 0, b = 0;
+			while ((a < r.size ()) || (b < p.size ())) {
+				if ((b == p.size ()) || ((a < r.size ()) && (r[a].first < p[b].first)))
+					res.push_back (r[a++]);
+				else if ((a == r.size ()) || (p[b].first < r[a].first)) {
+					// fill-in
+					const size_t c = (size_t)p[b].first;
+					E e (p[b]);
+					field ().mul (e.second, m, p[b].second);
+					res.push_back (e);
+					++_count[c]; ++_nnz; ++_fill;
+					_rows[c].push_back (l);
+					touch (c);
+					++b;
+				}
+				else {
+					const size_t c = (size_t)r[a].first;
+					E e (r[a]);
+					if (c != j)
+						field ().axpyin (e.second, m, p[b].second);
+					if ((c == j) || field ().isZero (e.second)) {
+						--_count[c]; --_nnz;
+						touch (c);
+					}
+					else
+						res.push_back (e);
+					++a; ++b;
+				}
+			}
+			std::swap (r, res);
+		}
+
+		void touch (size_t c)
+		{
+			if (_colStamp[c] != _ptime) {
+				_colStamp[c] = _ptime;
+				_touched.push_back (c);
+			}
+		}
+
+		const Field                       *_field;
+		_Matrix                               &_A;
+		std::vector<size_t>               _count;
+		std::vector<std::vector<size_t> >  _rows;
+		std::vector<bool>                 _heavy;
+		std::vector<bool>             _rowActive;
+		std::vector<bool>             _colActive;
+		size_t                    _nRows, _nCols;
+		std::vector<size_t>            _rowStamp;
+		std::vector<size_t>            _colStamp;
+		size_t                     _time, _ptime;
+		std::vector<size_t>             _touched;
+		size_t                       _nnz, _nnz0;
+		size_t                             _fill;
+	};
+
+	// true if the permutation k -> p[k] is odd
+	inline bool oddPermutation (const std::vector<size_t> &p)
+	{
+		std::vector<bool> seen (p.size (), false);
+		bool odd = false;
+		for (size_t k = 0; k < p.size (); ++k) {
+			if (seen[k]) continue;
+			size_t len = 0;
+			for (size_t t = k; !seen[t]; t = p[t]) {
+				seen[t] = true;
+				++len;
+			}
+			if (!(len & 1)) odd = !odd;
+		}
+		return odd;
+	}
+
+	template <class _Field>
+	template <class _Matrix> inline unsigned long&
+	GaussDomain<_Field>::MarkowitzPivoting (unsigned long &Rank,
+						Element        &determinant,
+						_Matrix         &LigneA,
+						unsigned long   Ni,
+						unsigned long   Nj) const
+	{
+		typedef std::pair<size_t,size_t> Key; // (column count, column)
+
+		commentator().start ("Markowitz Gaussian elimination", "Markowitz", Ni);
+		field().write( commentator().report (Commentator::LEVEL_NORMAL, INTERNAL_DESCRIPTION)
+			       << "Gaussian elimination on " << Ni << " x " << Nj << " matrix, over: ") << std::endl;
+
+		GaussMarkowitzWork<_Field,_Matrix> W (field(), LigneA, Ni, Nj);
+		std::priority_queue<Key, std::vector<Key>, std::greater<Key> > heap;
+		for (size_t j = 0; j < Nj; ++j)
+			if (W.count (j)) heap.push (Key (W.count (j), j));
+
+		std::vector<size_t> pr, pc; // pivot rows and columns, in order
+		field().assign(determinant,field().one);
+		Rank = 0;
+
+		while (! (HasFFLAS::value && switchToDense (W.nnz (), W.activeRows (), W.activeCols ()))) {
+			// smallest (row count - 1) x (column count - 1) over the rows of
+			// the __LINBOX_MARKOWITZ_SEARCH__ sparsest columns
+			std::vector<size_t> seen;
+			size_t best = (size_t)-1, pi = 0, pj = Nj;
+			while (!heap.empty () && (seen.size () < __LINBOX_MARKOWITZ_SEARCH__)) {
+				const Key key = heap.top ();
+				heap.pop ();
+				const size_t j = key.second;
+				if (!W.colActive (j) || (key.first != W.count (j)) || (W.count (j) == 0)
+				    || (std::find (seen.begin (), seen.end (), j) != seen.end ()))
+					continue; // stale, or empty for good
+				seen.push_back (j);
+				const std::vector<size_t> &L = W.rowsOf (j);
+				for (size_t t = 0; t < L.size (); ++t) {
+					const size_t cost = (W.row (L[t]).size () - 1) * (W.count (j) - 1);
+					if (cost < best) {
+						best = cost; pi = L[t]; pj = j;
+					}
+				}
+				if (best == 0) break;
+			}
+			for (size_t t = 0; t < seen.size (); ++t)
+				if (seen[t] != pj) heap.push (Key (W.count (seen[t]), seen[t]));
+			if (pj == Nj) break;
+
+			W.pivot (pi, pj, determinant);
+			pr.push_back (pi);
+			pc.push_back (pj);
+			++Rank;
+			for (size_t t = 0; t < W.touched ().size (); ++t) {
+				const size_t c = W.touched ()[t];
+				if (W.colActive (c) && W.count (c))
+					heap.push (Key (W.count (c), c));
+			}
+			if (! (Rank % 1000)) commentator().progress ((long)Rank);
+		}
+
+		commentator().report (Commentator::LEVEL_NORMAL, PARTIAL_RESULT)
+		<< "Markowitz: " << Rank << " pivots, fill-in " << W.fill ()
+		<< ", " << W.nnz () << " elements left (" << W.initialNnz () << " at start)" << std::endl;
+
+		RemainderPivoting (Rank, determinant, W, pr, pc, Ni, Nj);
+
+		commentator().report (Commentator::LEVEL_NORMAL, PARTIAL_RESULT)
+		<< "Rank : " << Rank << std::endl;
+		commentator().stop ("done", 0, "Markowitz");
+		return Rank;
+	}
+
+	template <class _Field>
+	template <class _Matrix> inline unsigned long&
+	GaussDomain<_Field>::StructuredPivoting (unsigned long &Rank,
+						 Element        &determinant,
+						 _Matrix         &LigneA,
+						 unsigned long   Ni,
+						 unsigned long   Nj) const
+	{
+		commentator().start ("Structured Gaussian elimination", "SGE", Ni);
+		field().write( commentator().report (Commentator::LEVEL_NORMAL, INTERNAL_DESCRIPTION)
+			       << "Structured Gaussian elimination on " << Ni << " x " << Nj << " matrix, over: ") << std::endl;
+
+		GaussMarkowitzWork<_Field,_Matrix> W (field(), LigneA, Ni, Nj);
+		std::vector<size_t> pr, pc;
+		field().assign(determinant,field().one);
+		Rank = 0;
+
+		// heavy columns are left to the elimination of the remainder
+		const size_t heavy = std::max ((size_t)16, (size_t)std::sqrt ((double)Ni));
+		size_t nheavy = 0;
+		for (size_t j = 0; j < Nj; ++j)
+			if (W.count (j) > heavy) {
+				W.setHeavy (j);
+				++nheavy;
+			}
+
+		bool changed = true;
+		while (changed) {
+			changed = false;
+			// singleton columns, no fill-in; columns of weight 2 are merged
+			for (size_t j = 0; j < Nj; ++j) {
+				if (!W.colActive (j) || W.heavy (j)) continue;
+				const size_t cj = W.count (j);
+				if ((cj == 0) || (cj > 2)) continue;
+				const std::vector<size_t> &L = W.rowsOf (j);
+				size_t i = L[0];
+				if ((cj == 2) && (W.row (L[1]).size () < W.row (i).size ()))
+					i = L[1];
+				if ((cj == 1) || (W.row (i).size () <= __LINBOX_SGE_MERGE__)) {
+					W.pivot (i, j, determinant);
+					pr.push_back (i); pc.push_back (j);
+					++Rank;
+					changed = true;
+				}
+			}
+			// rows with a single light entry, fill-in only in heavy columns
+			for (size_t i = 0; i < Ni; ++i) {
+				if (!W.rowActive (i)) continue;
+				const typename _Matrix::Row &r = W.row (i);
+				size_t light = 0, j = 0;
+				for (size_t k = 0; (k < r.size ()) && (light < 2); ++k)
+					if (!W.heavy ((size_t)r[k].first)) {
+						++light;
+						j = (size_t)r[k].first;
+					}
+				if (light == 1) {
+					W.pivot (i, j, determinant);
+					pr.push_back (i); pc.push_back (j);
+					++Rank;
+					changed = true;
+				}
+			}
+		}
+
+		commentator().report (Commentator::LEVEL_NORMAL, PARTIAL_RESULT)
+		<< "SGE: " << Rank << " pivots, " << nheavy << " heavy columns, "
+		<< W.activeRows () << " x " << W.activeCols () << " left with "
+		<< W.nnz () << " elements (" << W.initialNnz () << " at start, fill-in "
+		<< W.fill () << ")" << std::endl;
+
+		RemainderPivoting (Rank, determinant, W, pr, pc, Ni, Nj);
+
+		commentator().report (Commentator::LEVEL_NORMAL, PARTIAL_RESULT)
+		<< "Rank : " << Rank << std::endl;
+		commentator().stop ("done", 0, "SGE");
+		return Rank;
+	}
+
+	template <class _Field>
+	template <class Work> inline unsigned long&
+	GaussDomain<_Field>::RemainderPivoting (unsigned long &Rank,
+						Element        &determinant,
+						Work            &W,
+						std::vector<size_t> &pr,
+						std::vector<size_t> &pc,
+						unsigned long   Ni,
+						unsigned long   Nj) const
+	{
+		typedef typename Work::Matrix _Matrix;
+		typedef typename _Matrix::Row Vector;
+		typedef typename Vector::value_type E;
+
+		// active rows and columns, in their order
+		std::vector<size_t> R, C, index (Nj);
+		for (size_t i = 0; i < Ni; ++i)
+			if (W.rowActive (i)) R.push_back (i);
+		for (size_t j = 0; j < Nj; ++j)
+			if (W.colActive (j)) {
+				index[j] = C.size ();
+				C.push_back (j);
+			}
+
+		Element d2;
+		unsigned long r2 = 0;
+		if (W.nnz ()) {
+			_Matrix S (field(), R.size (), C.size ());
+			for (size_t t = 0; t < R.size (); ++t) {
+				Vector &src = W.row (R[t]);
+				Vector &dst = S[t];
+				dst.reserve (src.size ());
+				for (size_t k = 0; k < src.size (); ++k) {
+					E e (src[k]);
+					e.first = (typename E::first_type) index[(size_t)src[k].first];
+					dst.push_back (e);
+				}
+				Vector ().swap (src);
+			}
+			InPlaceLinearPivoting (r2, d2, S, R.size (), C.size ());
+		}
+		else
+			field().assign (d2, (R.empty () && C.empty ()) ? field().one : field().zero);
+		Rank += r2;
+
+		if ((Rank < Ni) || (Rank < Nj))
+			field().assign (determinant, field().zero);
+		else {
+			// pivots first, then the remainder, in both permutations
+			pr.insert (pr.end (), R.begin (), R.end ());
+			pc.insert (pc.end (), C.begin (), C.end ());
+			field().mulin (determinant, d2);
+			if (oddPermutation (pr) != oddPermutation (pc))
+				field().negin (determinant);
+		}
+		return Rank;
+	}
+
+} // namespace LinBox
+
+#endif // __LINBOX_gauss_markowitz_INL
+
+// Local Variables:
+// mode: C++
+// tab-width: 4
+// indent-tabs-mode: nil
+// c-basic-offset: 4
+// End:
+// vim:sts=4:sw=4:ts=4:et:sr:cino=>s,f0,{0,g0,(0,\:0,t0,+0,=s
@@ -0,0 +1,254 @@
+/* linbox/algorithms/gauss/gauss-parallel.inl
+ *
+ * ========LICENCE========
+ * This file is part of the library LinBox.
+ *
+ * LinBox is free software: you can redistribute it and/or modify
+ * it under the terms of the  GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ * ========LICENCE========
+ *.
+ *
+ * Right-looking elimination by sets of independent pivots
+ */
+#ifndef __LINBOX_gauss_parallel_INL
+#define __LINBOX_gauss_parallel_INL
+
+#include <vector>
+#include <algorithm>
+
+// A pivot joins a set if its Markowitz cost is at most this factor
+// times the cost of the first pivot of the set
+#ifndef __LINBOX_PARALLEL_PIVOT_COST__
+#define __LINBOX_PARALLEL_PIVOT_COST__ 4
+#endif
+
+namespace LinBox
+{
+	/* Set of structurally independent pivots of the active rows of a
+	 * sparse matrix: no pivot row has an entry in the column of another
+	 * pivot, so all the other rows can be reduced by all the pivots at
+	 * once, each row independently of the others.
+	 */
+	class IndependentPivots {
+	public:
+		IndependentPivots (size_t Nj) :
+			_pivotOf (Nj, -1), _blocked (Nj, false)
+		{}
+
+		/* Pivots (row, position of the pivot in the row) chosen in the
+		 * rows, visited by increasing size; count gives the number of
+		 * active entries per column and usable(e) tells whether the
+		 * value e can be a pivot.
+		 */
+		template <class Matrix, class Usable>
+		size_t select (const Matrix &A, std::vector<size_t> &rows,
+			       const std::vector<size_t> &count, Usable usable)
+		{
+			clear (A);
+			std::stable_sort (rows.begin (), rows.end (),
+					  [&A] (size_t a, size_t b) { return A[a].size () < A[b].size (); });
+			size_t best = 0;
+			for (size_t t = 0; t < rows.size (); ++t) {
+				const typename Matrix::Row &r = A[rows[t]];
+				bool free = r.size () > 0;
+				for (size_t k = 0; free && (k < r.size ()); ++k)
+					free = _pivotOf[(size_t)r[k].first] < 0;
+				if (!free) continue;
+
+				size_t pk = r.size ();
+				for (size_t k = 0; k < r.size (); ++k) {
+					const size_t c = (size_t)r[k].first;
+					if (!_blocked[c] && usable (r[k].second)
+					    && ((pk == r.size ()) || (count[c] < count[(size_t)r[pk].first])))
+						pk = k;
+				}
+				if (pk == r.size ()) continue;
+
+				const size_t cost = (r.size () - 1) * (count[(size_t)r[pk].first] - 1);
+				if (_piv.empty ())
+					best = cost;
+				else if (cost > __LINBOX_PARALLEL_PIVOT_COST__ * std::max (best, (size_t)1))
+					continue;
+
+				_pivotOf[(size_t)r[pk].first] = (long)_piv.size ();
+				_piv.push_back (std::pair<size_t,size_t> (rows[t], pk));
+				for (size_t k = 0; k < r.size (); ++k)
+					_blocked[(size_t)r[k].first] = true;
+			}
+			return _piv.size ();
+		}
+
+		size_t size () const { return _piv.size (); }
+		size_t row (size_t k) const { return _piv[k].first; }
+		size_t position (size_t k) const { return _piv[k].second; }
+
+		//! index of the pivot in column c, or -1
+		long pivotOf (size_t c) const { return _pivotOf[c]; }
+
+		//! empties the set; to be called before the pivot rows are modified
+		template <class Matrix>
+		void clear (const Matrix &A)
+		{
+			for (size_t k = 0; k < _piv.size (); ++k) {
+				const typename Matrix::Row &r = A[_piv[k].first];
+				for (size_t t = 0; t < r.size (); ++t) {
+					_blocked[(size_t)r[t].first] = false;
+					_pivotOf[(size_t)r[t].first] = -1;
+				}
+			}
+			_piv.clear ();
+		}
+
+	protected:
+		std::vector<long>                     _pivotOf;
+		std::vector<bool>                     _blocked;
+		std::vector<std::pair<size_t,size_t> >    _piv;
+	};
+
+	// Active part of the matrix, as seen by RemainderPivoting
+	template <class _Matrix>
+	struct GaussParallelWork {
+		typedef _Matrix Matrix;
+
+		GaussParallelWork (_Matrix &A, size_t Ni, size_t Nj) :
+			_A (A), _rowActive (Ni, true), _colActive (Nj, true), _nnz (0)
+		{}
+
+		typename _Matrix::Row &row (size_t i) { return _A[i]; }
+		bool rowActive (size_t i) const { return _rowActive[i]; }
+		bool colActive (size_t j) const { return _colActive[j]; }
+		size_t nnz () const { return _nnz; }
+
+		_Matrix                      &_A;
+		std::vector<bool>     _rowActive;
+		std::vector<bool>     _colActive;
+		size_t                      _nnz;
+	};
+
+	template <class _Field>
+	template <class _Matrix> inline unsigned long&
+	GaussDomain<_Field>::ParallelPivoting (unsigned long &Rank,
+					       Element        &determinant,
+					       _Matrix         &LigneA,
+					       unsigned long   Ni,
+					       unsigned long   Nj) const
+	{
+		typedef typename _Matrix::Row Vector;
+
+		commentator().start ("Gaussian elimination by independent pivots", "PIGE", Ni);
+		field().write( commentator().report (Commentator::LEVEL_NORMAL, INTERNAL_DESCRIPTION)
+			       << "Gaussian elimination on " << Ni << " x " << Nj << " matrix, over: ") << std::endl;
+
+		GaussParallelWork<_Matrix> W (LigneA, Ni, Nj);
+		IndependentPivots P (Nj);
+		std::vector<size_t> count (Nj), active, pr, pc;
+		std::vector<Element> inv;
+		size_t nRows = Ni, nCols = Nj, steps = 0;
+		field().assign(determinant,field().one);
+		Rank = 0;
+		const _Field &F = field();
+
+		for (;;) {
+			// active rows and column counts
+			active.clear ();
+			std::fill (count.begin (), count.end (), 0);
+			W._nnz = 0;
+			for (size_t i = 0; i < Ni; ++i)
+				if (W.rowActive (i)) {
+					active.push_back (i);
+					W._nnz += LigneA[i].size ();
+					for (size_t k = 0; k < LigneA[i].size (); ++k)
+						++count[(size_t)LigneA[i][k].first];
+				}
+			if (!W.nnz () || (HasFFLAS::value && switchToDense (W.nnz (), nRows, nCols)))
+				break;
+
+			P.select (LigneA, active, count, [] (const Element &) { return true; });
+			++steps;
+			inv.resize (P.size ());
+			for (size_t k = 0; k < P.size (); ++k) {
+				const size_t i = P.row (k);
+				const typename Vector::value_type &e = LigneA[i][P.position (k)];
+				F.mulin (determinant, e.second);
+				F.inv (inv[k], e.second);
+				pr.push_back (i);
+				pc.push_back ((size_t)e.first);
+				W._rowActive[i] = false;
+				W._colActive[(size_t)e.first] = false;
+			}
+			Rank += P.size ();
+			nRows -= P.size ();
+			nCols -= P.size ();
+			commentator().progress ((long)Rank);
+
+			// the other rows, each with its own dense accumulator
+#ifdef __LINBOX_USE_OPENMP
+#pragma omp parallel
+#endif
+			{
+				SparseAccumulator<_Field> spa (F, Nj);
+#ifdef __LINBOX_USE_OPENMP
+#pragma omp for schedule (dynamic, 64)
+#endif
+				for (long t = 0; t < (long)active.size (); ++t) {
+					const size_t l = active[(size_t)t];
+					if (!W.rowActive (l)) continue;
+					Vector &row = LigneA[l];
+					bool hit = false;
+					for (size_t k = 0; !hit && (k < row.size ()); ++k)
+						hit = P.pivotOf ((size_t)row[k].first) >= 0;
+					if (!hit) continue;
+
+					// entries in pivot columns are not changed by the
+					// other pivots of the set
+					spa.scatter (row);
+					for (size_t k = 0; k < row.size (); ++k) {
+						const long q = P.pivotOf ((size_t)row[k].first);
+						if (q < 0) continue;
+						Element m;
+						F.mul (m, row[k].second, inv[(size_t)q]);
+						F.negin (m);
+						spa.axpy (m, LigneA[P.row ((size_t)q)]);
+					}
+					for (size_t k = 0; k < row.size (); ++k)
+						if (P.pivotOf ((size_t)row[k].first) >= 0)
+							spa.cancel ((size_t)row[k].first);
+					spa.gather (row);
+				}
+			}
+		}
+
+		commentator().report (Commentator::LEVEL_NORMAL, PARTIAL_RESULT)
+		<< "Independent pivots: " << Rank << " in " << steps << " steps, "
+		<< W.nnz () << " elements left" << std::endl;
+
+		RemainderPivoting (Rank, determinant, W, pr, pc, Ni, Nj);
+
+		commentator().report (Commentator::LEVEL_NORMAL, PARTIAL_RESULT)
+		<< "Rank : " << Rank << std::endl;
+		commentator().stop ("done", 0, "PIGE");
+		return Rank;
+	}
+
+} // namespace LinBox
+
+#endif // __LINBOX_gauss_parallel_INL
+
+// Local Variables:
+// mode: C++
+// tab-width: 4
+// indent-tabs-mode: nil
+// c-basic-offset: 4
+// End:
+// vim:sts=4:sw=4:ts=4:et:sr:cino=>s,f0,{0,g0,(0,\:0,t0,+0,=s
@@ -39,10 +39,18 @@ namespace LinBox
 				    SparseEliminationTraits::PivotStrategy   reord)  const
 	{
 		Element determinant;
-		if (reord == SparseEliminationTraits::PIVOT_NONE)
+		switch (reord) {
+		case SparseEliminationTraits::PIVOT_NONE:
 			return NoReordering(Rank, determinant, A,  Ni, Nj);
-		else
+		case SparseEliminationTraits::PIVOT_MARKOWITZ:
+			return MarkowitzPivoting(Rank, determinant, A, Ni, Nj);
+		case SparseEliminationTraits::PIVOT_SGE:
+			return StructuredPivoting(Rank, determinant, A, Ni, Nj);
+		case SparseEliminationTraits::PIVOT_PARALLEL:
+			return ParallelPivoting(Rank, determinant, A, Ni, Nj);
+		default:
 			return InPlaceLinearPivoting(Rank, determinant, A, Ni, Nj);
+		}
 	}
 
 
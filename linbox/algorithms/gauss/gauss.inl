@@ -45,13 +45,9 @@
 #define __LINBOX_FILLIN__
 #endif
 
-#ifdef __LINBOX_SpD_SWITCH__
-#include <linbox/matrix/dense-matrix.h>
-#include <numeric>
-#  ifndef __LINBOX_SpD_MAXSPARSITY__
-// Sparsity less than 1% --> switch to dense
-#  define __LINBOX_SpD_MAXSPARSITY__ 0.01
-#  endif
+#if __LINBOX_GAUSS_DENSE_PLUQ__
+#include "linbox/matrix/dense-matrix.h"
+#include <fflas-ffpack/ffpack/ffpack.h>
 #endif
 
 namespace LinBox
@@ -102,9 +98,13 @@ namespace LinBox
         std::deque<std::pair<size_t,size_t> > invQ;
 
         // assignment of LigneA with the domain object
-        for (unsigned long jj = 0; jj < Ni; ++jj)
+        // nnz is the number of elements in the rows k..Ni-1
+        size_t nnz = 0;
+        for (unsigned long jj = 0; jj < Ni; ++jj) {
+            nnz += LigneA[(size_t)jj].size ();
             for (unsigned long k = 0; k < LigneA[(size_t)jj].size (); k++)
                 ++col_density[LigneA[(size_t)jj][k].first];
+        }
 
         const long last = (long)Ni - 1;
         long c;
@@ -127,15 +127,9 @@ namespace LinBox
         typename _Matrix::RowIterator LigneA_k = LigneA.rowBegin(), LigneA_p;
         for (long k = 0; k < last; ++k, ++LigneA_k) {
             
-#ifdef __LINBOX_SpD_MAXSPARSITY__
-            
-            if (accumulate(col_density.begin()+Rank,col_density.end(),0)>(Ni*Nj*__LINBOX_SpD_MAXSPARSITY__)) {
-#  ifdef _LB_DEBUG
-                std::cerr << "Dense switch: " << accumulate(col_density.begin()+Rank,col_density.end(),0) << '>' << Ni << '*' << Nj << '*' << __LINBOX_SpD_MAXSPARSITY__ << std::endl;
-#  endif
-                degeneratedense=std::is_base_of<Givaro::FiniteRingInterface<Element>,_Field>::value && true; break;
+            if (switchToDenseAt((size_t)k, nnz, Ni-(size_t)k, Nj-Rank)) {
+                degeneratedense=true; break;
             }
-#endif
             
             long p = k, s = 0;
 
@@ -193,10 +187,13 @@ namespace LinBox
                             permute( LigneA[(size_t)ll], Rank, c);
                     }
                     long npiv=(long)LigneA_k->size();
+                    nnz -= (size_t)npiv;
                     for (ll = k+1; ll < static_cast<long>(Ni); ++ll) {
                         E hc;
                         hc.first=(unsigned)Rank-1;
+                        nnz -= LigneA[(size_t)ll].size ();
                         eliminate (hc.second, LigneA[(size_t)ll], *LigneA_k, Rank, c, (size_t)npiv, col_density);
+                        nnz += LigneA[(size_t)ll].size ();
                         if(! field().isZero(hc.second)) LigneL[(size_t)ll].push_back(hc);
                     }
                 }
@@ -232,8 +229,7 @@ namespace LinBox
 //             E one((unsigned)last,field().one);
 //             LigneL[(size_t)last].push_back(one);
 //         }
-        Continuation<_Matrix,Perm,
-            std::is_base_of<Givaro::FiniteRingInterface<Element>,_Field>::value>
+        Continuation<_Matrix,Perm,HasFFLAS::value>
             ()(*this, Rank,determinant,invQ,LigneL,LigneA,P,Ni,Nj,degeneratedense);
 
 #ifdef __LINBOX_COUNT__
@@ -332,6 +328,7 @@ namespace LinBox
             }
     };
     
+#if __LINBOX_GAUSS_DENSE_PLUQ__
     template <class _Field>
     template <class _Matrix, class Perm> 
     struct GaussDomain<_Field>::Continuation<_Matrix,Perm,true> {
@@ -443,7 +440,7 @@ namespace LinBox
             for(size_t j=0; j<i; ++j)
                 if (!this->field().isZero(A.getEntry(i,j)))
                     dLigneL[Rank+i].push_back(std::pair<size_t, Element>(Rank+j,A.getEntry(i,j)));
-        for(size_t i=0; i<R2; ++i)
+        for(size_t i=0; i<sNi; ++i)
             dLigneL[Rank+i].push_back(std::pair<size_t, Element>(Rank+i,this->field().one));
 
 
@@ -485,6 +482,95 @@ namespace LinBox
     }
     
 
+    template <class _Field>
+    template <class _Matrix> inline unsigned long&
+    GaussDomain<_Field>::DenseLinearPivoting (unsigned long &Rank,
+                     Element       &determinant,
+                     _Matrix        &LigneA,
+                     unsigned long k,
+                     unsigned long Ni,
+                     unsigned long Nj,
+                     std::true_type) const
+    {
+        // The rows k.. have no element left in the columns < Rank
+        const size_t sNi=Ni-k, sNj=Nj-Rank;
+
+        BlasMatrix<_Field> A(field(), sNi, sNj);
+        for(size_t di=k;di<Ni;++di) {
+            for(size_t dj=0;dj<LigneA[di].size();++dj)
+                A.setEntry(di-k,LigneA[di][dj].first-Rank, LigneA[di][dj].second);
+            LigneA[di].resize(0);
+        }
+
+        size_t *P2 = FFLAS::fflas_new<size_t>(sNi);
+        size_t *Q2 = FFLAS::fflas_new<size_t>(sNj);
+        size_t R2 = FFPACK::PLUQ(field(), FFLAS::FflasNonUnit, sNi, sNj, A.getPointer(), sNj, P2, Q2);
+
+        // determinant of the remaining part (only used when R2=sNi=sNj)
+        for(size_t i=0; i<R2; ++i) {
+            field().mulin(determinant,A.getEntry(i,i));
+            if (i != P2[i]) field().negin(determinant);
+            if (i != Q2[i]) field().negin(determinant);
+        }
+
+        FFLAS::fflas_delete(P2);
+        FFLAS::fflas_delete(Q2);
+        return Rank+=R2;
+    }
+
+    template <class _Field>
+    template <class _Matrix, class Perm> inline unsigned long&
+    GaussDomain<_Field>::DenseLinearPivoting (unsigned long &Rank,
+                     Element       &determinant,
+                     _Matrix        &LigneA,
+                     Perm          &P,
+                     unsigned long k,
+                     unsigned long Ni,
+                     unsigned long Nj,
+                     std::true_type) const
+    {
+        typedef typename _Matrix::Row        Vector;
+        typedef typename Vector::value_type E;
+
+        const size_t sNi=Ni-k, sNj=Nj-Rank;
+
+        BlasMatrix<_Field> A(field(), sNi, sNj);
+        for(size_t di=k;di<Ni;++di) {
+            for(size_t dj=0;dj<LigneA[di].size();++dj)
+                A.setEntry(di-k,LigneA[di][dj].first-Rank, LigneA[di][dj].second);
+            LigneA[di].resize(0);
+        }
+
+        size_t *P2 = FFLAS::fflas_new<size_t>(sNi);
+        size_t *Q2 = FFLAS::fflas_new<size_t>(sNj);
+        size_t R2 = FFPACK::PLUQ(field(), FFLAS::FflasNonUnit, sNi, sNj, A.getPointer(), sNj, P2, Q2);
+
+        for(size_t i=0; i<R2; ++i) {
+            field().mulin(determinant,A.getEntry(i,i));
+            if (i != P2[i]) field().negin(determinant);
+            if (i != Q2[i]) field().negin(determinant);
+        }
+
+            // U2 in the rows k..k+R2-1, its columns are in the order of Q2
+        for(size_t i=0; i<R2; ++i)
+            for(size_t j=i; j<sNj; ++j)
+                if (!field().isZero(A.getEntry(i,j)))
+                    LigneA[k+i].push_back(E((unsigned)(Rank+j),A.getEntry(i,j)));
+
+            // same column order for P and the rows above
+        for(size_t j=0; j<sNj; ++j)
+            if (j != Q2[j]) {
+                P.permute(Rank+j,Rank+Q2[j]);
+                for(size_t l=0; l<k; ++l)
+                    permute( LigneA[l], Rank+j+1, (long)(Rank+Q2[j]));
+            }
+
+        FFLAS::fflas_delete(P2);
+        FFLAS::fflas_delete(Q2);
+        return Rank+=R2;
+    }
+#endif // __LINBOX_GAUSS_DENSE_PLUQ__
+
     template <class _Field>
     template <class _Matrix> inline unsigned long&
     GaussDomain<_Field>::InPlaceLinearPivoting (unsigned long &Rank,
@@ -513,15 +599,22 @@ namespace LinBox
 
         // allocation of the column density
         std::vector<size_t> col_density (Nj);
+        // row updates, kept for the whole elimination
+        SparseAccumulator<Field> spa (field(), Nj);
 
         // assignment of LigneA with the domain object
-        for (unsigned long jj = 0; jj < Ni; ++jj)
+        // nnz is the number of elements in the rows k..Ni-1
+        size_t nnz = 0;
+        for (unsigned long jj = 0; jj < Ni; ++jj) {
+            nnz += LigneA[(size_t)jj].size ();
             for (unsigned long k = 0; k < LigneA[(size_t)jj].size (); k++)
                 ++col_density[LigneA[(size_t)jj][k].first];
+        }
 
         const long last = (long)Ni - 1;
         long c;
         Rank = 0;
+        bool dense = false;
 
 #ifdef __LINBOX_OFTEN__
         long sstep = last/40;
@@ -531,6 +624,12 @@ namespace LinBox
 #endif
         // Elimination steps with reordering
         for (long k = 0; k < last; ++k) {
+            if (switchToDenseAt((size_t)k, nnz, Ni-(size_t)k, Nj-Rank)) {
+                DenseLinearPivoting (Rank, determinant, LigneA, (size_t)k, Ni, Nj, HasFFLAS());
+                dense = true;
+                break;
+            }
+
             long p = k, s = (long)LigneA[(size_t)k].size ();
 
 #ifdef __LINBOX_FILLIN__
@@ -576,9 +675,13 @@ namespace LinBox
 
                 SparseFindPivot (LigneA[(size_t)k], Rank, c, col_density, determinant);
                 //                     LigneA.write(std::cerr << "PIV, k:" << k << ", Rank:" << Rank << ", c:" << c)<<std::endl;
+                nnz -= LigneA[(size_t)k].size ();
                 if (c != -1) {
-                    for (l = (unsigned long)k + 1; l < (unsigned long)Ni; ++l)
-                        eliminate (LigneA[(size_t)l], LigneA[(size_t)k], Rank, c, col_density);
+                    for (l = (unsigned long)k + 1; l < (unsigned long)Ni; ++l) {
+                        nnz -= LigneA[(size_t)l].size ();
+                        eliminate (LigneA[(size_t)l], LigneA[(size_t)k], Rank, c, col_density, spa);
+                        nnz += LigneA[(size_t)l].size ();
+                    }
                 }
 
                 //                     LigneA.write(std::cerr << "AFT " )<<std::endl;
@@ -590,7 +693,8 @@ namespace LinBox
 
         }//for k
 
-        SparseFindPivot (LigneA[(size_t)last], Rank, c, determinant);
+        if (! dense)
+            SparseFindPivot (LigneA[(size_t)last], Rank, c, determinant);
 
 #ifdef __LINBOX_COUNT__
         nbelem += LigneA[(size_t)last].size ();
@@ -653,15 +757,22 @@ namespace LinBox
         field().assign(determinant,field().one);
         // allocation of the column density
         std::vector<size_t> col_density (Nj);
+        // row updates, kept for the whole elimination
+        SparseAccumulator<Field> spa (field(), Nj);
 
         // assignment of LigneA with the domain object
-        for (unsigned long jj = 0; jj < Ni; ++jj)
+        // nnz is the number of elements in the rows k..Ni-1
+        size_t nnz = 0;
+        for (unsigned long jj = 0; jj < Ni; ++jj) {
+            nnz += LigneA[(size_t)jj].size ();
             for (unsigned long k = 0; k < LigneA[(size_t)jj].size (); k++)
                 ++col_density[LigneA[(size_t)jj][k].first];
+        }
 
         const long last = (long)Ni - 1;
         long c;
         Rank = 0;
+        bool dense = false;
 
 #ifdef __LINBOX_OFTEN__
         long sstep = last/40;
@@ -671,6 +782,12 @@ namespace LinBox
 #endif
         // Elimination steps with reordering
         for (long k = 0; k < last; ++k) {
+            if (switchToDenseAt((size_t)k, nnz, Ni-(size_t)k, Nj-Rank)) {
+                DenseLinearPivoting (Rank, determinant, LigneA, P, (size_t)k, Ni, Nj, HasFFLAS());
+                dense = true;
+                break;
+            }
+
             long p = k, s =(long) LigneA[(size_t)k].size ();
 
 #ifdef __LINBOX_FILLIN__
@@ -726,9 +843,13 @@ namespace LinBox
                     for (long ll=0; ll < k ; ++ll)
                         permute( LigneA[(size_t)ll], Rank, c);
 
-                    for (l = (unsigned long)k + 1; l < (unsigned long)Ni; ++l)
-                        eliminate (LigneA[(size_t)l], LigneA[(size_t)k], Rank, c, col_density);
+                    for (l = (unsigned long)k + 1; l < (unsigned long)Ni; ++l) {
+                        nnz -= LigneA[(size_t)l].size ();
+                        eliminate (LigneA[(size_t)l], LigneA[(size_t)k], Rank, c, col_density, spa);
+                        nnz += LigneA[(size_t)l].size ();
+                    }
                 }
+                nnz -= LigneA[(size_t)k].size ();
 
                 //                     LigneA.write(std::cerr << "AFT " )<<std::endl;
 #ifdef __LINBOX_COUNT__
@@ -738,11 +859,13 @@ namespace LinBox
 
         }//for k
 
-        SparseFindPivot (LigneA[(size_t)last], Rank, c, determinant);
-        if ( (c != -1) && (c != (static_cast<long>(Rank)-1) ) ) {
-            P.permute(Rank-1,(size_t)c);
-            for (long ll=0; ll < last ; ++ll)
-                permute( LigneA[(size_t)ll], Rank, c);
+        if (! dense) {
+            SparseFindPivot (LigneA[(size_t)last], Rank, c, determinant);
+            if ( (c != -1) && (c != (static_cast<long>(Rank)-1) ) ) {
+                P.permute(Rank-1,(size_t)c);
+                for (long ll=0; ll < last ; ++ll)
+                    permute( LigneA[(size_t)ll], Rank, c);
+            }
         }
 
 
@@ -35,6 +35,7 @@
 
 #include "linbox/linbox-config.h"
 #include "linbox/util/debug.h"
+#include "linbox/util/instrument.h"
 
 #include "linbox/blackbox/apply.h"
 #include "linbox/algorithms/blackbox-container.h"
@@ -459,7 +460,7 @@ namespace LinBox
 				linbox_check (digit.size() == _lc._matA.coldim());
 #endif
 				// compute next p-adic digit
-				_lc.nextdigit(digit,_res);
+				{ LINBOX_INSTRUMENT_SCOPE ("lifting digit"); _lc.nextdigit(digit,_res); }
 #ifdef RSTIMING
 				_lc.tRingApply.start();
 #endif
@@ -477,7 +478,7 @@ namespace LinBox
 
 				// compute v2 = _matA * digit
 				IVector v2 (_lc.ring(),_lc._matA.rowdim());
-				_lc._MAD.applyV(v2,digit, _res);
+				{ LINBOX_INSTRUMENT_SCOPE ("lifting apply"); _lc._MAD.applyV(v2,digit, _res); }
 
 #ifdef DEBUG_LC
 
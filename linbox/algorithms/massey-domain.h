@@ -52,6 +52,7 @@
 #include "linbox/vector/subvector.h"
 #include "linbox/vector/vector-domain.h"
 #include "linbox/util/timer.h"
+#include "linbox/util/instrument.h"
 
 namespace LinBox
 {
@@ -200,6 +201,7 @@ namespace LinBox
 		template<class Polynomial>
 		long massey (Polynomial &C, bool full_poly = false)
 		{
+			LINBOX_INSTRUMENT_SCOPE ("berlekamp/massey");
 			//              const long ni = _container->n_row (), nj = _container->n_col ();
 			//              const long n = MIN(ni,nj);
 			const long END = _container->size () + (full_poly ? DEFAULT_ADDITIONAL_ITERATION:0);
@@ -30,6 +30,10 @@
 
 #include "givaro/random-integer.h"
 #include "linbox/randiter/random-prime.h"
+#include "linbox/field/multimod-field.h"
+#include "linbox/matrix/densematrix/blas-matrix-multimod.h"
+
+#include <set>
 
 
 namespace LinBox { namespace BLAS3 { namespace Protected {
@@ -175,6 +179,54 @@ namespace LinBox { namespace BLAS3 {
 		return C;
 
 	}
+
+	/** Integer matrix product in a residue number system.
+	 * A and B are reduced modulo enough primes for the symmetric
+	 * reconstruction of C, each conversion being one product of
+	 * doubles (MultiModConversion); the modular products are then done
+	 * all at once on BlasMatrix<MultiModDouble>, in parallel over the
+	 * primes.
+	 */
+	template<class _Rep>
+	BlasMatrix<Givaro::ZRing<Integer>,_Rep> &
+	mul (BlasMatrix<Givaro::ZRing<Integer>,_Rep>& C,
+	     const BlasMatrix<Givaro::ZRing<Integer>,_Rep>& A,
+	     const BlasMatrix<Givaro::ZRing<Integer>,_Rep>& B,
+	     const mulMethod::CRA &)
+	{
+		linbox_check(A.coldim() == B.rowdim());
+		linbox_check(C.rowdim() == A.rowdim());
+		linbox_check(C.coldim() == B.coldim());
+		const size_t m = A.rowdim(), k = A.coldim(), n = B.coldim();
+		if (!m || !n)
+			return C;
+
+		integer mA, mB ;
+		BlasMatrixDomain<Givaro::ZRing<Integer> > BMD(A.field());
+		BMD.Magnitude(mA,A);
+		BMD.Magnitude(mB,B);
+
+		// primes until M > 2 |C|_max
+		typedef Givaro::Modular<double> ModularField ;
+		const integer bound = 2 * mA * mB * (integer)(uint64_t)std::max(k,(size_t)1) + 1;
+		PrimeIterator<IteratorCategories::HeuristicTag> genprime(FieldTraits<ModularField>::bestBitSize(k));
+		std::vector<integer> primes;
+		std::set<integer> seen;
+		integer M = 1;
+		while (M <= bound) {
+			if (seen.insert(*genprime).second) {
+				primes.push_back(*genprime);
+				M *= primes.back();
+			}
+			++genprime;
+		}
+
+		const MultiModDouble F(primes);
+		BlasMatrix<MultiModDouble> Ar(F,A), Br(F,B), Cr(F,m,n);
+		BlasMatrixDomain<MultiModDouble>(F).mul(Cr,Ar,Br);
+		Cr.convert(C);
+		return C;
+	}
 } // BLAS3
 } // LinBox
 
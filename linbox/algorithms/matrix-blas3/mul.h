@@ -186,6 +186,14 @@ namespace LinBox {
 			 const DenseIntMat& B,
 			 const mulMethod::CRA & );
 
+	//! multimodular product of dense integer matrices
+	template<class _Rep>
+		BlasMatrix<Givaro::ZRing<Integer>,_Rep> &
+		mul (BlasMatrix<Givaro::ZRing<Integer>,_Rep>& C,
+			 const BlasMatrix<Givaro::ZRing<Integer>,_Rep>& A,
+			 const BlasMatrix<Givaro::ZRing<Integer>,_Rep>& B,
+			 const mulMethod::CRA & );
+
 	}
 }
 #include "linbox/algorithms/matrix-blas3/mul-cra.inl"
@@ -38,6 +38,7 @@
 #include "linbox/vector/vector-domain.h"
 #include "linbox/blackbox/archetype.h"
 #include "linbox/solutions/methods.h"
+#include "linbox/algorithms/block-lanczos-kernels.h"
 #include "linbox/matrix/dense-matrix.h"
 
 // I'm putting everything inside the LinBox namespace so that I can drop all of
@@ -75,7 +76,7 @@ namespace LinBox
 		 *               options for the solver
 		 */
 		MGBlockLanczosSolver (const Field &F, const BlockLanczosTraits &traits) :
-			_traits (traits), _field (&F), _VD (F), _MD (F), _randiter (F)
+			_traits (traits), _field (&F), _VD (F), _MD (F), _kernel (F), _randiter (F)
 			,_AV(F)
 			, _block (traits.blockingFactor ())
 		{
@@ -89,7 +90,7 @@ namespace LinBox
 		 * @param r Random iterator to use for randomization
 		 */
 		MGBlockLanczosSolver (const Field &F, const BlockLanczosTraits &traits, typename Field::RandIter r) :
-			_traits (traits), _field (&F), _VD (F), _MD (F), _randiter (r)
+			_traits (traits), _field (&F), _VD (F), _MD (F), _kernel (F), _randiter (r)
 			,_AV(F)
 			, _block (traits.blockingFactor ())
 		{
@@ -230,6 +231,7 @@ namespace LinBox
 		const Field              *_field;
 		VectorDomain<Field>       _VD;
 		MatrixDomain<Field>       _MD;
+		BlockLanczosKernel<Field> _kernel;
 		typename Field::RandIter  _randiter;
 
 		// Temporaries used in the computation
@@ -240,6 +242,7 @@ namespace LinBox
 		Matrix  _VTAV;             // N x N
 		// Matrix  _Winv[2];          // N x N
 		std::vector<Matrix> _Winv ;
+		Matrix  _AVTAV;            // N x N
 		Matrix  _AVTAVSST_VTAV;    // N x N
 		Matrix  _matT;                // N x N
 		Matrix  _DEF;              // N x N
@@ -555,8 +555,9 @@ namespace LinBox
 		for (k = _matV[0].colBegin (); k != _matV[0].colEnd (); ++k)
 			stream >> *k;
 
+		// AV, V^T AV and (AV)^T AV in one pass over the blocks
 		TIMER_START(AV);
-		_MD.blackboxMulLeft (_AV, A, _matV[0]);
+		_kernel.apply (_AV, _VTAV, _AVTAV, A, _matV[0]);
 		TIMER_STOP(AV);
 
 		std::ostream &report = commentator().report (Commentator::LEVEL_IMPORTANT, INTERNAL_DESCRIPTION);
@@ -565,9 +566,6 @@ namespace LinBox
 		std::fill (_vecS.begin (), _vecS.end (), true);
 
 		// Iteration 1
-		TIMER_START(innerProducts);
-		_MD.mul (_VTAV, transpose (_matV[0]), _AV);
-		TIMER_STOP(innerProducts);
 
 		TIMER_START(Winv);
 		Ni = (size_t)compute_Winv_S (_Winv[0], _vecS, _VTAV);
@@ -601,7 +599,7 @@ namespace LinBox
 		TIMER_STOP(Vnext);
 
 		TIMER_START(innerProducts);
-		mul (_AVTAVSST_VTAV, transpose (_AV), _AV, _vecS);
+		mul_SST (_AVTAVSST_VTAV, _AVTAV, _vecS);
 		TIMER_STOP(innerProducts);
 
 		//	MGBLTraceReport (report, _MD, "V", 0, _matV[0]);
@@ -636,8 +634,9 @@ namespace LinBox
 		}
 
 		// Iteration 2
+		// AV, V^T AV and (AV)^T AV in one pass over the blocks
 		TIMER_START(AV);
-		_MD.blackboxMulLeft (_AV, A, _matV[1]);
+		_kernel.apply (_AV, _VTAV, _AVTAV, A, _matV[1]);
 		TIMER_STOP(AV);
 
 #ifdef MGBL_DETAILED_TRACE
@@ -646,10 +645,6 @@ namespace LinBox
 		_MD.copy (AV1_backup, _AV);
 #endif
 
-		TIMER_START(innerProducts);
-		_MD.mul (_VTAV, transpose (_matV[1]), _AV);
-		TIMER_STOP(innerProducts);
-
 		TIMER_START(Winv);
 		Ni = (size_t)compute_Winv_S (_Winv[1], _vecS, _VTAV);
 		TIMER_STOP(Winv);
@@ -679,7 +674,7 @@ namespace LinBox
 		TIMER_STOP(Vnext);
 
 		TIMER_START(innerProducts);
-		mul (_AVTAVSST_VTAV, transpose (_AV), _AV, _vecS);
+		mul_SST (_AVTAVSST_VTAV, _AVTAV, _vecS);
 		TIMER_STOP(innerProducts);
 
 		//	MGBLTraceReport (report, _MD, "AV", 1, _AV);
@@ -717,14 +712,10 @@ namespace LinBox
 			int next_j = j + 1;
 			if (next_j > 2) next_j = 0;
 
-			TIMER_START(AV);
-			_MD.blackboxMulLeft (_AV, A, _matV[j]);
-			TIMER_STOP(AV);
-
 			// First compute F_i+1, where we use Winv_i-2; then Winv_i and
 			// Winv_i-2 can share storage, and we don't need the old _VTAV
 			// and _AVTAVSST_VTAV any more. After this, F_i+1 is stored in
-			// _DEF
+			// _DEF. This must precede the inner products, which overwrite _VTAV
 
 			TIMER_START(orthogonalization);
 			_MD.mul (_matT, _VTAV, _Winv[1 - i]);
@@ -733,10 +724,10 @@ namespace LinBox
 			_MD.mulin (_DEF, _AVTAVSST_VTAV);
 			TIMER_STOP(orthogonalization);
 
-			// Now get the next VTAV, Winv, and S_i
-			TIMER_START(innerProducts);
-			_MD.mul (_VTAV, transpose (_matV[j]), _AV);
-			TIMER_STOP(innerProducts);
+			// Now get AV and the next VTAV and (AV)^T AV in one pass, then Winv and S_i
+			TIMER_START(AV);
+			_kernel.apply (_AV, _VTAV, _AVTAV, A, _matV[j]);
+			TIMER_STOP(AV);
 
 			TIMER_START(Winv);
 			Ni = (size_t)compute_Winv_S (_Winv[i], _vecS, _VTAV);
@@ -778,7 +769,7 @@ namespace LinBox
 
 			// Compute the next _AVTAVSST_VTAV
 			TIMER_START(innerProducts);
-			mul (_AVTAVSST_VTAV, transpose (_AV), _AV, _vecS);
+			mul_SST (_AVTAVSST_VTAV, _AVTAV, _vecS);
 			TIMER_STOP(innerProducts);
 
 			MGBLTraceReport (report, _MD, "V^T A^2 V", (size_t)iter, _AVTAVSST_VTAV);
@@ -1239,6 +1230,7 @@ namespace LinBox
 		_VTAV.resize (_block, _block);
 		_Winv[0].resize (_block, _block);
 		_Winv[1].resize (_block, _block);
+		_AVTAV.resize (_block, _block);
 		_AVTAVSST_VTAV.resize (_block, _block);
 		_matT.resize (_block, _block);
 		_DEF.resize (_block, _block);
@@ -0,0 +1,274 @@
+/* linbox/algorithms/multimod-wiedemann.h
+ *
+ * ========LICENCE========
+ * This file is part of the library LinBox.
+ *
+ * LinBox is free software: you can redistribute it and/or modify
+ * it under the terms of the  GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ * ========LICENCE========
+ */
+
+/*! @file algorithms/multimod-wiedemann.h
+ * @ingroup algorithms
+ * @brief Scalar Wiedemann modulo several primes with one apply per step.
+ *
+ * The Krylov sequences \f$u^T B^i v\f$ modulo k primes are produced
+ * together by an operator applying B to k interleaved vectors, such as
+ * MultiModSparseMatrix::apply, then Berlekamp/Massey runs on each.
+ * MultiModMinpoly and MultiModDet are the iterations of the batched
+ * ChineseRemainder loop (ChineseRemainderSeq::batch) for the minimal
+ * polynomial and the determinant of an integer sparse matrix.
+ */
+
+#ifndef __LINBOX_multimod_wiedemann_H
+#define __LINBOX_multimod_wiedemann_H
+
+#include <vector>
+#include <random>
+#include <functional>
+
+#include "linbox/integer.h"
+#include "linbox/vector/blas-vector.h"
+#include "linbox/algorithms/massey-domain.h"
+#include "linbox/blackbox/multimod-sparse.h"
+
+namespace LinBox
+{
+
+	/** @brief Projected Krylov sequences modulo several primes.
+	 * \ingroup algorithms
+	 *
+	 * The operator is called as op(y, x) with k interleaved vectors.
+	 * The terms are produced on demand by extend(), which resumes where
+	 * the previous call stopped.
+	 */
+	class MultiModKrylov {
+	public:
+		typedef MultiModSparseMatrix::Vector Vector;
+		typedef MultiModSparseMatrix::Moduli Moduli;
+		typedef std::function<void (Vector&, const Vector&)> Operator;
+
+		MultiModKrylov (const Operator& op, size_t dim, const Moduli& P, uint64_t seed) :
+			_op (op), _P (P), _u (dim * P.size()), _v (dim * P.size()), _s (P.size())
+		{
+			std::mt19937_64 g (seed);
+			const size_t k = _P.size();
+			for (size_t i = 0; i < _u.size(); ++i) {
+				_u[i] = g() % _P[i % k];
+				_v[i] = g() % _P[i % k];
+			}
+		}
+
+		const Moduli& moduli () const { return _P; }
+		size_t length () const { return _s.empty() ? 0 : _s[0].size(); }
+
+		//! the terms modulo P[l]
+		const std::vector<uint64_t>& sequence (size_t l) const { return _s[l]; }
+
+		//! computes the terms up to length, with one apply per term
+		void extend (size_t length)
+		{
+			const size_t k = _P.size();
+			std::vector<uint64_t> acc (k);
+			while (this->length() < length) {
+				if (this->length() > 0) {
+					_op (_w, _v);
+					_v. swap (_w);
+				}
+				std::fill (acc.begin(), acc.end(), 0);
+				for (size_t i = 0; i < _u.size(); i += k)
+					for (size_t l = 0; l < k; ++l)
+						MultiModSparseMatrix::addmul (acc[l], _u[i+l], _v[i+l], _P[l]);
+				for (size_t l = 0; l < k; ++l)
+					_s[l]. push_back (acc[l] % _P[l]);
+			}
+		}
+
+	protected:
+		Operator                              _op;
+		Moduli                                 _P;
+		Vector                         _u, _v, _w;
+		std::vector<std::vector<uint64_t> >    _s;
+	};
+
+	/** Minimal polynomials of the sequences of K over the fields F (of
+	 * characteristics K.moduli()).  The sequences are extended, by
+	 * doubling, until each has at least twice its degree plus early
+	 * terms, or max terms.
+	 */
+	template <class Field>
+	void multiModMinpoly (std::vector<BlasVector<Field> >& phi, MultiModKrylov& K,
+			      const std::vector<Field>& F, size_t max, unsigned long early = DEFAULT_EARLY_TERM_THRESHOLD)
+	{
+		typedef std::vector<typename Field::Element> Sequence;
+		const size_t k = F.size();
+		size_t length = std::min (max, 2 * (size_t)early + 2);
+		phi. clear();
+		for (size_t l = 0; l < k; ++l)
+			phi. push_back (BlasVector<Field> (F[l]));
+		for (;;) {
+			K. extend (length);
+			bool done = true;
+			for (size_t l = 0; l < k; ++l) {
+				Sequence seq (length);
+				for (size_t i = 0; i < length; ++i)
+					F[l]. init (seq[i], (int64_t)K.sequence(l)[i]);
+				MasseyDomain<Field, Sequence> MD (&seq, F[l], early);
+				unsigned long rk;
+				MD. minpoly (phi[l], rk, false);
+				if (2 * (phi[l].size() - 1) + early > length)
+					done = false;
+			}
+			if (done || length >= max) return;
+			length = std::min (max, 2 * length);
+		}
+	}
+
+	//! the moduli of the fields F
+	template <class Field>
+	MultiModSparseMatrix::Moduli& multiModModuli (MultiModSparseMatrix::Moduli& P, const std::vector<Field>& F)
+	{
+		P. resize (F.size());
+		integer c;
+		for (size_t l = 0; l < F.size(); ++l) {
+			F[l]. characteristic (c);
+			P[l] = (uint64_t)c;
+			linbox_check (P[l] < (UINT64_C(1) << 31));
+		}
+		return P;
+	}
+
+	/** @brief Minimal polynomial of an integer sparse matrix modulo k primes.
+	 * \ingroup algorithms
+	 * Iteration of ChineseRemainderSeq::batch.  As with the iteration
+	 * one prime at a time, bad primes and unlucky projections are not
+	 * detected.
+	 */
+	struct MultiModMinpoly {
+		const MultiModSparseMatrix &A;
+		unsigned long early;
+		mutable std::mt19937_64 seeds;
+
+		//! seed of the projections, 0 for a random seed
+		MultiModMinpoly (const MultiModSparseMatrix& B, unsigned long e = DEFAULT_EARLY_TERM_THRESHOLD, uint64_t seed = 0) :
+			A(B), early(e), seeds(seed ? seed : (uint64_t)std::random_device{}())
+		{}
+
+		template <class Polynomial, class Field>
+		std::vector<Polynomial>& operator() (std::vector<Polynomial>& P, const std::vector<Field>& F) const
+		{
+			MultiModSparseMatrix::Moduli Q;
+			multiModModuli (Q, F);
+			const MultiModSparseMatrix &B = A;
+			MultiModKrylov K ([&B, &Q] (MultiModSparseMatrix::Vector& y, const MultiModSparseMatrix::Vector& x) {
+				B. apply (y, x, Q);
+			}, A.rowdim(), Q, seeds());
+			std::vector<BlasVector<Field> > phi;
+			multiModMinpoly (phi, K, F, 2 * A.rowdim() + 2, early);
+			for (size_t l = 0; l < F.size(); ++l) {
+				P[l]. resize (phi[l].size());
+				for (size_t i = 0; i < phi[l].size(); ++i)
+					F[l]. assign (P[l][i], phi[l][i]);
+			}
+			return P;
+		}
+	};
+
+	/** @brief Determinant of an integer sparse matrix modulo k primes.
+	 * \ingroup algorithms
+	 * Iteration of ChineseRemainderSeq::batch.  As the Wiedemann
+	 * determinant over a field, it computes the minimal polynomial of AD
+	 * for a random diagonal D, here with small integer entries shared by
+	 * the k primes, and starts again for the primes where its degree is
+	 * less than the order while its constant coefficient is not zero.
+	 */
+	struct MultiModDet {
+		const MultiModSparseMatrix &A;
+		unsigned long early;
+		mutable std::mt19937_64 seeds;
+
+		//! seed of the projections, 0 for a random seed
+		MultiModDet (const MultiModSparseMatrix& B, unsigned long e = DEFAULT_EARLY_TERM_THRESHOLD, uint64_t seed = 0) :
+			A(B), early(e), seeds(seed ? seed : (uint64_t)std::random_device{}())
+		{}
+
+		template <class Element, class Field>
+		std::vector<Element>& operator() (std::vector<Element>& d, const std::vector<Field>& F) const
+		{
+			const size_t n = A.rowdim();
+			std::vector<size_t> todo;
+			for (size_t l = 0; l < F.size(); ++l)
+				todo. push_back (l);
+			while (! todo.empty()) {
+				std::vector<Field> G;
+				for (size_t t = 0; t < todo.size(); ++t)
+					G. push_back (F[todo[t]]);
+				MultiModSparseMatrix::Moduli Q;
+				multiModModuli (Q, G);
+				const size_t k = Q.size();
+
+				// D with entries in [1, 2^20), residues interleaved
+				std::vector<uint64_t> D (n * k);
+				for (size_t i = 0; i < n; ++i) {
+					const uint64_t e = 1 + seeds() % ((UINT64_C(1) << 20) - 1);
+					for (size_t l = 0; l < k; ++l)
+						D[i*k+l] = e % Q[l];
+				}
+				const MultiModSparseMatrix &B = A;
+				MultiModSparseMatrix::Vector t;
+				MultiModKrylov K ([&B, &Q, &D, &t, k] (MultiModSparseMatrix::Vector& y, const MultiModSparseMatrix::Vector& x) {
+					t. resize (x.size());
+					for (size_t i = 0; i < x.size(); ++i)
+						t[i] = (D[i] * x[i]) % Q[i % k];
+					B. apply (y, t, Q);
+				}, n, Q, seeds());
+				std::vector<BlasVector<Field> > phi;
+				multiModMinpoly (phi, K, G, 2 * n + 2, early);
+
+				std::vector<size_t> again;
+				for (size_t l = 0; l < k; ++l) {
+					const Field& Fl = G[l];
+					typename Field::Element pi, e;
+					Fl. assign (pi, Fl.one);
+					for (size_t i = 0; i < n; ++i)
+						Fl. mulin (pi, Fl. init (e, (int64_t)D[i*k+l]));
+					if (Fl. isZero (pi) || (phi[l].size() < n + 1 && ! Fl. isZero (phi[l][0]))) {
+						again. push_back (todo[l]);
+						continue;
+					}
+					Element& dl = d[todo[l]];
+					if (phi[l].size() < n + 1)
+						Fl. assign (dl, Fl.zero);
+					else {
+						Fl. div (dl, phi[l][0], pi);
+						if (n & 1) Fl. negin (dl);
+					}
+				}
+				todo. swap (again);
+			}
+			return d;
+		}
+	};
+
+}
+
+#endif // __LINBOX_multimod_wiedemann_H
+
+// Local Variables:
+// mode: C++
+// tab-width: 4
+// indent-tabs-mode: nil
+// c-basic-offset: 4
+// End:
+// vim:sts=4:sw=4:ts=4:et:sr:cino=>s,f0,{0,g0,(0,\:0,t0,+0,=s
@@ -28,11 +28,29 @@
 /*! @file algorithms/smith-form-adaptive.h
  * @ingroup algorithms
  * Implement the adaptive algorithm for Smith form computation
+ *
+ * The independent parts run concurrently on a BoundedTaskPool: the rank
+ * and the degree of the minimal polynomial of \f$AA^T\f$, then the local
+ * Smith forms at the small primes together with the rough part.  Each of
+ * these copies A over some ring; memoryBudget() bounds the bytes of the
+ * copies alive at once.  The parts that report to the commentator, the
+ * degree and the rough part, run on the calling thread, the others on
+ * the pool's threads.
  */
 
 #include <vector>
+#include <string>
+#include <iostream>
+#include <mutex>
 #include "linbox/integer.h"
 #include "linbox/matrix/dense-matrix.h"
+#include "linbox/util/commentator.h"
+#include "linbox/util/bounded-task-pool.h"
+
+#ifndef LINBOX_SMITH_FORM_ADAPTIVE_BUDGET
+//! default of SmithFormAdaptive::memoryBudget(), in bytes (0: no bound)
+#define LINBOX_SMITH_FORM_ADAPTIVE_BUDGET 0
+#endif
 
 namespace LinBox
 {
@@ -44,22 +62,31 @@ namespace LinBox
 
 		static const int NPrime;// = 25;
 
+		/// Bytes of the copies of the matrix alive at once in the parallel parts, 0 for no bound.
+		static size_t &memoryBudget () { static size_t b = LINBOX_SMITH_FORM_ADAPTIVE_BUDGET; return b; }
+
+		/// Threads of the parallel parts, 0 for the default of BoundedTaskPool.
+		static size_t &numThreads () { static size_t t = 0; return t; }
+
 		/* Compute the local smith form at prime p, when modular (p^e) fits in long
 		 * Should work with SparseMatrix and BlasMatrix
 		 */
 		template <class Matrix>
-		static void compute_local_long (BlasVector<Givaro::ZRing<Integer> >& s, const Matrix& A, int64_t p, int64_t e);
+		static void compute_local_long (BlasVector<Givaro::ZRing<Integer> >& s, const Matrix& A, int64_t p, int64_t e,
+						std::ostream& report = commentator().report (Commentator::LEVEL_IMPORTANT, PROGRESS_REPORT));
 
 		/* Compute the local smith form at prime p, when modular (p^e) doesnot fit in int64_t
 		 * Should work with SparseMatrix and BlasMatrix
 		 */
 		template <class Matrix>
-		static void compute_local_big (BlasVector<Givaro::ZRing<Integer> >& s, const Matrix& A, int64_t p, int64_t e);
+		static void compute_local_big (BlasVector<Givaro::ZRing<Integer> >& s, const Matrix& A, int64_t p, int64_t e,
+					       std::ostream& report = commentator().report (Commentator::LEVEL_IMPORTANT, PROGRESS_REPORT));
 
 		/* Compute the local smith form at prime p
 		*/
 		template <class Matrix>
-		static void compute_local (BlasVector<Givaro::ZRing<Integer> >& s, const Matrix& A, int64_t p, int64_t e);
+		static void compute_local (BlasVector<Givaro::ZRing<Integer> >& s, const Matrix& A, int64_t p, int64_t e,
+					   std::ostream& report = commentator().report (Commentator::LEVEL_IMPORTANT, PROGRESS_REPORT));
 
 		/* Compute the k-smooth part of the invariant factor, where k = 100.
 		 * @param sev is the exponent part ...
@@ -74,7 +101,8 @@ namespace LinBox
 		 * Should work with BlasMatrix
 		 */
 		template <class Matrix>
-		static void smithFormRough  (BlasVector<Givaro::ZRing<Integer> >& s, const Matrix& A, integer m );
+		static void smithFormRough  (BlasVector<Givaro::ZRing<Integer> >& s, const Matrix& A, integer m,
+					     std::ostream& report = commentator().report (Commentator::LEVEL_IMPORTANT, PROGRESS_REPORT));
 
 		/* Compute the Smith form via valence algorithms
 		 * Compute the local Smith form at each possible prime
@@ -98,6 +126,55 @@ namespace LinBox
 		template <class IRing, class _Rep>
 		static void smithForm (BlasVector<Givaro::ZRing<Integer> >& s, const BlasMatrix<IRing, _Rep>& A);
 
+	protected:
+
+		/* Local Smith form at p, mod p^(base+extra), extra doubling until
+		 * it agrees with the rank r.  Run as a job of pool, the charge
+		 * of the job follows the modulus.
+		 */
+		template <class Matrix>
+		static void localSmithForm (BlasVector<Givaro::ZRing<Integer> >& local, const Matrix& A, long r,
+					    int64_t p, int64_t base, int64_t extra, std::ostream& report,
+					    BoundedTaskPool* pool = 0);
+
+		/* Modulus of the copy of A for the local Smith form mod p^e (0: Local2_32) */
+		static integer localModulus (int64_t p, int64_t e);
+
+		/* Submits the local Smith forms at the primes with extra[i] > 0,
+		 * into locals[i], with their reports into msgs[i].
+		 */
+		template <class Matrix>
+		static void submitLocalSmithForms (BoundedTaskPool& pool, std::vector<BlasVector<Givaro::ZRing<Integer> > >& locals,
+						   std::vector<std::string>& msgs, const Matrix& A, long r,
+						   const std::vector<int64_t>& base, const std::vector<int64_t>& extra);
+
+		/* s[0..r) = 1, s[r..) = 0, times the local Smith forms */
+		static void combineLocal (BlasVector<Givaro::ZRing<Integer> >& s, long r, size_t order,
+					  const std::vector<BlasVector<Givaro::ZRing<Integer> > >& locals,
+					  const std::vector<int64_t>& extra);
+
+		/* Bytes of a copy of A over a ring of modulus m (0: a word size field) */
+		template <class Matrix>
+		static size_t copyBytes (const Matrix& A, const integer& m);
+
+		/* Budget of a pool while the calling thread holds bytes of memoryBudget() */
+		static size_t poolBudget (size_t bytes);
+
+		/* Rank of A over a random prime field and degree of the minimal
+		 * polynomial of AA^T, concurrently.
+		 */
+		template <class Matrix>
+		static void rankAndDegree (unsigned long& r, size_t& degree, const Matrix& A);
+
+		/* NTL moduli are global: the NTL computations are serialized */
+		static std::mutex &ntlMutex () { static std::mutex m; return m; }
+
+		/* Rough and smooth parts, concurrently. */
+		template <class Matrix, class RMatrix>
+		static void smoothAndRough (BlasVector<Givaro::ZRing<Integer> >& smooth, BlasVector<Givaro::ZRing<Integer> >& rough,
+					    const Matrix& A, const RMatrix& DA, long r, const std::vector<int64_t>& sev,
+					    const integer& bonus);
+
 	};
 	const int64_t SmithFormAdaptive::prime[] = {2, 3, 5, 7, 11, 13, 17, 19, 23, 29, 31, 37, 41, 43, 47, 53, 59, 61, 67, 71, 73, 79, 83, 89, 97};
 	const int SmithFormAdaptive::NPrime = 25;
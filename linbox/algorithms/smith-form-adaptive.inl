@@ -28,6 +28,9 @@
 
 #include <cmath>
 #include <vector>
+#include <string>
+#include <sstream>
+#include <mutex>
 #include <givaro/modular-int32.h>
 
 #include "linbox/linbox-config.h"
@@ -61,10 +64,9 @@ namespace LinBox
 	/* Compute the local smith form at prime p, when modular (p^e) fits in long
 	*/
 	template <class Matrix>
-	void SmithFormAdaptive::compute_local_long (BlasVector<Givaro::ZRing<Integer> >& s, const Matrix& A, int64_t p, int64_t e)
+	void SmithFormAdaptive::compute_local_long (BlasVector<Givaro::ZRing<Integer> >& s, const Matrix& A, int64_t p, int64_t e,
+						    std::ostream& report)
 	{
-		std::ostream& report = commentator().report (Commentator::LEVEL_IMPORTANT, PROGRESS_REPORT);
-
 		int order = (int)(A. rowdim() < A. coldim() ? A. rowdim() : A. coldim());
 		linbox_check ((s. size() >= (unsigned long)order) && (p > 0) && ( e >= 0));
 		if (e == 0) return;
@@ -151,10 +153,11 @@ namespace LinBox
 	/* Compute the local smith form at prime p, when modular (p^e) doesnot fit in long
 	*/
 	template <class Matrix>
-	void SmithFormAdaptive::compute_local_big (BlasVector<Givaro::ZRing<Integer> >& s, const Matrix& A, int64_t p, int64_t e)
+	void SmithFormAdaptive::compute_local_big (BlasVector<Givaro::ZRing<Integer> >& s, const Matrix& A, int64_t p, int64_t e,
+						   std::ostream& report)
 	{
-
-		std::ostream& report = commentator().report (Commentator::LEVEL_IMPORTANT, PROGRESS_REPORT);
+		// the modulus of NTL is global
+		std::lock_guard<std::mutex> lock (ntlMutex());
 		int order = (int)(A. rowdim() < A. coldim() ? A. rowdim() : A. coldim());
 		linbox_check ((s. size() >= (unsigned long) order) && (p > 0) && ( e >= 0));
 		integer T; T = order; T <<= 20; T = pow (T, (int) sqrt((double)order));
@@ -182,7 +185,8 @@ namespace LinBox
 	}
 #else
 	template <class Matrix>
-	void SmithFormAdaptive::compute_local_big (BlasVector<Givaro::ZRing<Integer> >& s, const Matrix& A, int64_t p, int64_t e)
+	void SmithFormAdaptive::compute_local_big (BlasVector<Givaro::ZRing<Integer> >& s, const Matrix& A, int64_t p, int64_t e,
+						   std::ostream& report)
 	{
 		throw(LinBoxError("you need NTL to use SmithFormAdaptive",LB_FILE_LOC));
 	}
@@ -192,66 +196,222 @@ namespace LinBox
 	/* Compute the local smith form at prime p
 	*/
 	template <class Matrix>
-	void SmithFormAdaptive::compute_local (BlasVector<Givaro::ZRing<Integer> >& s, const Matrix& A, int64_t p, int64_t e)
+	void SmithFormAdaptive::compute_local (BlasVector<Givaro::ZRing<Integer> >& s, const Matrix& A, int64_t p, int64_t e,
+					       std::ostream& report)
 	{
 
 		linbox_check ((p > 0) && ( e >= 0));
 		integer m = 1; int i = 0; for ( i = 0; i < e; ++ i) m *= p;
 		if (((p == 2) && (e <= 32)) || (m <= FieldTraits<PIRModular<int32_t> >::maxModulus()))
-			compute_local_long (s, A, p, e);
+			compute_local_long (s, A, p, e, report);
 		else
-			compute_local_big (s, A, p, e);
+			compute_local_big (s, A, p, e, report);
 
 		// normalize the answer
 		for (BlasVector<Givaro::ZRing<Integer> >::iterator p_it = s. begin(); p_it != s. end(); ++ p_it)
 			*p_it = gcd (*p_it, m);
 	}
 
+	/* Local Smith form at p, mod p^(base+extra), extra doubling until
+	 * it agrees with the rank r.
+	 */
+	template <class Matrix>
+	void SmithFormAdaptive::localSmithForm (BlasVector<Givaro::ZRing<Integer> >& local, const Matrix& A, long r,
+						int64_t p, int64_t base, int64_t extra, std::ostream& report,
+						BoundedTaskPool* pool)
+	{
+		const long order = (long)(A. rowdim() < A. coldim() ? A. rowdim() : A. coldim());
+		for (;; extra *= 2) {
+			integer m = 1;
+			for (int64_t i = 0; i < base + extra; ++ i) m *= p;
+			report << "   Compute the local smith form mod " << p <<"^" << base + extra << std::endl;
+			compute_local (local, A, p, base + extra, report);
+			//check
+			report << "   Check if it agrees with the rank: ";
+			if ((local[(size_t)r-1] % m != 0 ) && ((r == order) ||(local[(size_t)r] % m == 0))) {report << "yes.\n"; return;}
+			report << "no. \n";
+			// the copy mod p^(base+2 extra) may be larger, e.g. over NTL past 2^32
+			if (pool != 0)
+				pool-> recharge (copyBytes (A, localModulus (p, base + 2 * extra)));
+		}
+	}
+
+	/* Modulus of the copy of A for the local Smith form mod p^e
+	*/
+	inline integer SmithFormAdaptive::localModulus (int64_t p, int64_t e)
+	{
+		// 2^e, e <= 32, is handled over Local2_32
+		integer m = 0;
+		if ((p != 2) || (e > 32)) {
+			m = 1;
+			for (int64_t k = 0; k < e; ++ k) m *= p;
+		}
+		return m;
+	}
+
+	/* Bytes of a copy of A over a ring of modulus m (0: a word size ring)
+	*/
+	template <class Matrix>
+	size_t SmithFormAdaptive::copyBytes (const Matrix& A, const integer& m)
+	{
+		size_t e = sizeof(int32_t);
+		if (m > FieldTraits<PIRModular<int32_t> >::maxModulus())
+			// an NTL::ZZ_p: a pointer to a header and the limbs
+			e = 3 * sizeof(void*) + 8 * ((m.bitsize() + 63) / 64);
+		return A. rowdim() * A. coldim() * e;
+	}
+
+	template <class Matrix>
+	void SmithFormAdaptive::submitLocalSmithForms (BoundedTaskPool& pool, std::vector<BlasVector<Givaro::ZRing<Integer> > >& locals,
+						       std::vector<std::string>& msgs, const Matrix& A, long r,
+						       const std::vector<int64_t>& base, const std::vector<int64_t>& extra)
+	{
+		for (size_t i = 0; i < (size_t)NPrime; ++ i) {
+			if (extra[i] <= 0) continue;
+			const int64_t p = prime[i], b = base[i], x = extra[i];
+			BlasVector<Givaro::ZRing<Integer> > *local = &locals[i];
+			std::string *msg = &msgs[i];
+			BoundedTaskPool *P = &pool;
+			pool. submit (copyBytes (A, localModulus (p, b + x)), [local, msg, &A, r, p, b, x, P] () {
+				std::ostringstream os;
+				localSmithForm (*local, A, r, p, b, x, os, P);
+				*msg = os. str();
+			});
+		}
+	}
+
+	inline void SmithFormAdaptive::combineLocal (BlasVector<Givaro::ZRing<Integer> >& s, long r, size_t order,
+						     const std::vector<BlasVector<Givaro::ZRing<Integer> > >& locals,
+						     const std::vector<int64_t>& extra)
+	{
+		BlasVector<Givaro::ZRing<Integer> >::iterator s_p;
+		for (s_p = s. begin(); s_p != s. begin() +(ptrdiff_t) r; ++ s_p)
+			*s_p = 1;
+		for (; s_p != s. end(); ++ s_p)
+			*s_p = 0;
+		if (r == 0) return;
+		for (size_t i = 0; i < locals. size(); ++ i) {
+			if (extra[i] <= 0) continue;
+			for (size_t j = 0; j < order; ++ j)
+				s[j] *= locals[i][j];
+		}
+	}
+
 	/* Compute the k-smooth part of the invariant factor, where k = 100.
 	 * @param sev is the exponent part ...
-	 * By local smith form and rank computation
+	 * By local smith form and rank computation, concurrently at each prime
 	 * r >= 2;
 	 */
 	template <class Matrix>
 	void SmithFormAdaptive::smithFormSmooth (BlasVector<Givaro::ZRing<Integer> >& s, const Matrix& A, long r, const std::vector<int64_t>& sev)
 	{
 		Givaro::ZRing<Integer> Z;
-		//....
 		std::ostream& report = commentator().report (Commentator::LEVEL_IMPORTANT, PROGRESS_REPORT);
 		report << "Computation the k-smooth part of the invariant factors starts(via local and rank):" << std::endl;
-		int order = (int)(A. rowdim() < A. coldim() ? A. rowdim() : A. coldim());
-		linbox_check (s. size() >= (unsigned long)order);
-		std::vector<int64_t>::const_iterator sev_p; const int64_t* prime_p; BlasVector<Givaro::ZRing<Integer> >::iterator s_p;
-		BlasVector<Givaro::ZRing<Integer> > local(Z,(size_t)order);
-		BlasVector<Givaro::ZRing<Integer> >::iterator local_p;
+		size_t order = (A. rowdim() < A. coldim() ? A. rowdim() : A. coldim());
+		linbox_check (s. size() >= order);
+
+		std::vector<int64_t> base (sev. begin(), sev. begin() + NPrime), extra ((size_t)NPrime, 1);
+		for (size_t i = 0; i < (size_t)NPrime; ++ i)
+			if ((prime[i] == 2) && (base[i] < 32))
+				extra[i] = 32 - base[i];
+
+		std::vector<BlasVector<Givaro::ZRing<Integer> > > locals ((size_t)NPrime, BlasVector<Givaro::ZRing<Integer> >(Z, order));
+		std::vector<std::string> msgs ((size_t)NPrime);
+		if (r > 0) {
+			BoundedTaskPool pool (numThreads(), memoryBudget());
+			submitLocalSmithForms (pool, locals, msgs, A, r, base, extra);
+			pool. wait();
+		}
+		for (size_t i = 0; i < msgs. size(); ++ i)
+			report << msgs[i];
+		combineLocal (s, r, order, locals, extra);
+		report << "Computation of the smooth part is done.\n";
 
-		for (s_p = s. begin(); s_p != s. begin() +(ptrdiff_t) r; ++ s_p)
-			*s_p = 1;
-		for (; s_p != s. end(); ++ s_p)
-			*s_p = 0;
-		if (r == 0) return;
+	}
+
+	/* Budget of the pool while the calling thread holds bytes of it
+	*/
+	inline size_t SmithFormAdaptive::poolBudget (size_t bytes)
+	{
+		const size_t b = memoryBudget();
+		if (b == 0) return 0;
+		// 1: the jobs run one at a time
+		return (bytes < b) ? b - bytes : 1;
+	}
 
-		for (sev_p = sev. begin(), prime_p = prime; sev_p != sev. begin() +(ptrdiff_t) NPrime; ++ sev_p, ++ prime_p) {
-			int extra = 1;
-			do {
-
-				if ((*prime_p == 2) && (*sev_p < 32))
-					extra =  32 -(int) *sev_p;
-				integer m = 1;
-				for (int i = 0; i < *sev_p + extra; ++ i) m *= * prime_p;
-				report << "   Compute the local smith form mod " << *prime_p <<"^" << *sev_p + extra << std::endl;
-				compute_local (local, A, *prime_p, *sev_p + extra);
-				//check
-				report << "   Check if it agrees with the rank: ";
-				if ((local[(size_t)r-1] % m != 0 ) && ((r == order) ||(local[(size_t)r] % m == 0))) {report << "yes.\n"; break;}
-				report << "no. \n";
-				extra *= 2;
-			} while (true);
-			for (s_p = s. begin(), local_p = local. begin(); s_p != s. begin() +(ptrdiff_t) order; ++ s_p, ++ local_p)
-				*s_p *= *local_p;
+	/* Rank of A over a random prime field and degree of the minimal
+	 * polynomial of AA^T over another one, concurrently.  The primes are
+	 * chosen here, the random generators are not shared by the threads.
+	 * The valence reports to the commentator: the degree is computed on
+	 * the calling thread, the rank on the pool.
+	 */
+	template <class Matrix>
+	void SmithFormAdaptive::rankAndDegree (unsigned long& r, size_t& degree, const Matrix& A)
+	{
+		typedef Givaro::Modular<int32_t> Field;
+		typedef typename Matrix::Field Ring;
+		PrimeIterator<IteratorCategories::HeuristicTag> genprime(FieldTraits<Field>::bestBitSize(A.coldim()));
+		const Field Fr (*genprime);
+		++ genprime;
+		const Field Fv (*genprime);
+
+		const size_t bytes = copyBytes (A, 0);
+		BoundedTaskPool pool (1, poolBudget (bytes));
+		pool. submit (bytes, [&r, &A, &Fr] () {
+			MatrixRank<Ring, Field> MR;
+			BlasMatrix<Field> Ap (Fr, A.rowdim(), A.coldim());
+			MatrixHom::map (Ap, A);
+			r = (unsigned long) MR. rankIn (Ap);
+		});
+		// one thread in all: the rank first
+		if (numThreads() == 1) pool. wait();
+		{
+			typename MatrixHomTrait<Matrix, Field>::value_type Ap(Fv, A.rowdim(), A.coldim());
+			MatrixHom::map (Ap, A);
+			Field::Element v;
+			Valence::one_valence (v, degree, Ap);
 		}
-		report << "Computation of the smooth part is done.\n";
+		pool. wait();
+	}
 
+	/* Rough part on DA and smooth part on A, concurrently.  The rough
+	 * part may report to the commentator (SmithFormBinary): it runs on
+	 * the calling thread, the local Smith forms on the pool.
+	*/
+	template <class Matrix, class RMatrix>
+	void SmithFormAdaptive::smoothAndRough (BlasVector<Givaro::ZRing<Integer> >& smooth, BlasVector<Givaro::ZRing<Integer> >& rough,
+						const Matrix& A, const RMatrix& DA, long r, const std::vector<int64_t>& sev,
+						const integer& bonus)
+	{
+		Givaro::ZRing<Integer> Z;
+		std::ostream& report = commentator().report (Commentator::LEVEL_IMPORTANT, PROGRESS_REPORT);
+		report << "Computation of the k-smooth and k-rough parts of the invariant factors starts, concurrently:" << std::endl;
+		size_t order = (A. rowdim() < A. coldim() ? A. rowdim() : A. coldim());
+
+		std::vector<int64_t> base (sev. begin(), sev. begin() + NPrime), extra ((size_t)NPrime, 1);
+		for (size_t i = 0; i < (size_t)NPrime; ++ i)
+			if ((prime[i] == 2) && (base[i] < 32))
+				extra[i] = 32 - base[i];
+
+		std::vector<BlasVector<Givaro::ZRing<Integer> > > locals ((size_t)NPrime, BlasVector<Givaro::ZRing<Integer> >(Z, order));
+		std::vector<std::string> msgs ((size_t)NPrime);
+		std::string roughMsg;
+		{
+			BoundedTaskPool pool (numThreads(), poolBudget (copyBytes (DA, bonus)));
+			if (r > 0)
+				submitLocalSmithForms (pool, locals, msgs, A, r, base, extra);
+			// one thread in all: the local Smith forms first
+			if (numThreads() == 1) pool. wait();
+			std::ostringstream os;
+			smithFormRough (rough, DA, bonus, os);
+			roughMsg = os. str();
+			pool. wait();
+		}
+		for (size_t i = 0; i < msgs. size(); ++ i)
+			report << msgs[i];
+		report << roughMsg;
+		combineLocal (smooth, r, order, locals, extra);
 	}
 
 
@@ -260,10 +420,9 @@ namespace LinBox
 	 * By EGV+ algorithm or Iliopoulos' algorithm for Smith form.
 	 */
 	template <class Matrix>
-	void SmithFormAdaptive::smithFormRough  (BlasVector<Givaro::ZRing<Integer> >& s, const Matrix& A, integer m)
+	void SmithFormAdaptive::smithFormRough  (BlasVector<Givaro::ZRing<Integer> >& s, const Matrix& A, integer m,
+						 std::ostream& report)
 	{
-
-		std::ostream& report = commentator().report (Commentator::LEVEL_IMPORTANT, PROGRESS_REPORT);
 		report << "Compuation of the k-rough part f the invariant factors starts(via EGV+ or Iliopolous):\n";
 		int order = (int)(A. rowdim() < A. coldim() ? A. rowdim() : A. coldim());
 		integer T; T = order; T <<= 20; T = pow (T, (int) sqrt((double)order));
@@ -303,6 +462,8 @@ namespace LinBox
 		}
 		else {
 			report << "    Elimination start:\n";
+			// the modulus of NTL is global
+			std::lock_guard<std::mutex> lock (ntlMutex());
 			PIR_ntl_ZZ_p R (m);
 			BlasMatrix<PIR_ntl_ZZ_p> A_ilio(R, A.rowdim(), A.coldim());
 			MatrixHom::map (A_ilio, A);
@@ -316,14 +477,15 @@ namespace LinBox
 	}
 #else
 	template <class Matrix>
-	void SmithFormAdaptive::smithFormRough  (BlasVector<Givaro::ZRing<Integer> >& s, const Matrix& A, integer m)
+	void SmithFormAdaptive::smithFormRough  (BlasVector<Givaro::ZRing<Integer> >& s, const Matrix& A, integer m,
+						 std::ostream& report)
 	{
 		throw(LinBoxError("you need NTL to use SmithFormAdaptive",LB_FILE_LOC));
 	}
 #endif
 
 	/* Compute the Smith form via valence algorithms
-	 * Compute the local Smtih form at each possible prime
+	 * Compute the local Smtih form at each possible prime, concurrently
 	 * r >= 2;
 	 */
 	template <class Matrix>
@@ -333,47 +495,31 @@ namespace LinBox
 		Givaro::ZRing<Integer> Z;
 		std::ostream& report = commentator().report (Commentator::LEVEL_IMPORTANT, PROGRESS_REPORT);
 		report << "Computation the local smith form at each possible prime:\n";
-		int order = (int)(A. rowdim() < A. coldim() ? A. rowdim() : A. coldim());
-		linbox_check (s. size() >= (unsigned long)order);
-
-		std::vector<int64_t>::const_iterator sev_p;
-		const int64_t* prime_p;
-
-		BlasVector<Givaro::ZRing<Integer> >::iterator s_p;
-		BlasVector<Givaro::ZRing<Integer> > local(Z,(size_t)order);
-
-		BlasVector<Givaro::ZRing<Integer> >::iterator local_p;
-
-		for (s_p = s. begin(); s_p != s. begin() +(ptrdiff_t) r; ++ s_p)
-			*s_p = 1;
-		for (; s_p != s. end(); ++ s_p)
-			*s_p = 0;
-		if (r == 0) return;
-
-		for (sev_p = sev. begin(), prime_p = prime; sev_p != sev. begin() +(ptrdiff_t) NPrime; ++ sev_p, ++ prime_p) {
-			if (*sev_p <= 0) continue;
-			//only compute the local Smith form at each possible prime
-			int extra = 2;
-			if (*prime_p == 2) extra = 32;
+		size_t order = (A. rowdim() < A. coldim() ? A. rowdim() : A. coldim());
+		linbox_check (s. size() >= order);
+
+		//only compute the local Smith form at each possible prime
+		std::vector<int64_t> base ((size_t)NPrime, 0), extra ((size_t)NPrime, 0);
+		for (size_t i = 0; i < (size_t)NPrime; ++ i) {
+			if (sev[i] <= 0) continue;
+			if (prime[i] == 2) extra[i] = 32;
 			else {
 				// cheating here, try to use the max word size modular
 				double log_max_mod = log((double) FieldTraits<PIRModular<int32_t> >:: maxModulus() - 1) ;
-				extra = (int)(floor(log_max_mod / log (double(*prime_p))));
+				extra[i] = (int64_t)(floor(log_max_mod / log (double(prime[i]))));
 			}
-			do {
-				integer m = 1;
-				for (int i = 0; i < extra; ++ i) m *= * prime_p;
-				report << "   Compute the local smith form mod " << *prime_p <<"^" << extra << std::endl;
-				compute_local (local, A, *prime_p, extra);
-				//check
-				report << "   Check if it agrees with the rank: ";
-				if ((local[(size_t)r-1] % m != 0 ) && ((r == order) ||(local[(size_t)r] % m == 0))) {report << "yes.\n"; break;}
-				report << "no. \n";
-				extra *= 2;
-			} while (true);
-			for (s_p = s. begin(), local_p = local. begin(); s_p != s. begin() +(ptrdiff_t) order; ++ s_p, ++ local_p)
-				*s_p *= *local_p;
 		}
+
+		std::vector<BlasVector<Givaro::ZRing<Integer> > > locals ((size_t)NPrime, BlasVector<Givaro::ZRing<Integer> >(Z, order));
+		std::vector<std::string> msgs ((size_t)NPrime);
+		if (r > 0) {
+			BoundedTaskPool pool (numThreads(), memoryBudget());
+			submitLocalSmithForms (pool, locals, msgs, A, r, base, extra);
+			pool. wait();
+		}
+		for (size_t i = 0; i < msgs. size(); ++ i)
+			report << msgs[i];
+		combineLocal (s, r, order, locals, extra);
 		report << "Computation of the smith form done.\n";
 
 	}
@@ -392,31 +538,24 @@ namespace LinBox
 		std::ostream& report = commentator().report (Commentator::LEVEL_IMPORTANT, PROGRESS_REPORT);
 		report << "Computation of the invariant factors starts (via an adaptive alg):" << std::endl;
 
-		// compute the rank over a random prime field.
+		// compute the rank over a random prime field,
+		// and the degree of min poly of AA^T.
 		int order = (A. rowdim() < A. coldim()) ? (int)A. rowdim() : (int)A. coldim();
-		report << "Computation of the rank starts:\n";
+		report << "Computation of the rank and of the degree of min poly of AA^T starts:\n";
 		typedef typename Matrix::Field Ring;
-		unsigned long r;
-		MatrixRank<Ring, Givaro::Modular<int32_t> > MR;
-		r = MR. rank (A);
+		unsigned long r; size_t degree;
+		rankAndDegree (r, degree, A);
 		report << "   Matrix rank over a random prime field: " << r << '\n';
 		report << "Computation of the rank finished.\n";
 		const int64_t* prime_p;
 		std::vector<int64_t> e(NPrime); std::vector<int64_t>::iterator e_p;
 
-		report <<"   Compute the degree of min poly of AA^T: \n";
-		typedef Givaro::Modular<int32_t> Field;
-		integer Val; Field::Element v; unsigned long degree;
-        PrimeIterator<IteratorCategories::HeuristicTag> genprime(FieldTraits<Field>::bestBitSize(A.coldim()));
-		Field F (*genprime);
-		typename MatrixHomTrait<Matrix, Field>::value_type Ap(F, A.rowdim(), A.coldim());
-		MatrixHom::map (Ap, A);
-		Valence::one_valence (v, degree, Ap);
+		integer Val;
 		report <<"   Degree of minimal polynomial of AA^T = " << degree << '\n';
 		// if degree is small
 		if (degree < sqrt(double(order))) {
 			report << "   Computation of the valence starts:\n";
-			Valence::valence (Val, degree, A);
+			Valence::valenceParallel (Val, degree, A, numThreads());
 			report << "      Valence = " << Val << std::endl;
 			report << "   Computation of the valence of ends.\n";
 			Val = abs (Val);
@@ -470,8 +609,7 @@ namespace LinBox
 		bonus = gcd (bonus, r_mod);
 		Givaro::ZRing<Integer> Z;
 		BlasVector<Givaro::ZRing<Integer> > smooth (Z,(size_t)order), rough (Z,(size_t)order);
-		smithFormRough (rough, DA, bonus);
-		smithFormSmooth (smooth, A, r, e);
+		smoothAndRough (smooth, rough, A, DA, (long)r, e, bonus);
 		//fixed the rough largest invariant factor
 		if (r > 0) rough[r-1] = r_mod;
 
@@ -517,11 +655,10 @@ namespace LinBox
 		// compute the rank over a random prime field.
 		const size_t order = (A. rowdim() < A. coldim() ? A. rowdim() : A. coldim());
 
-		report << "Computation of the rank starts:" << std::endl;
+		report << "Computation of the rank and of the degree of min poly of AA^T starts:" << std::endl;
 		typedef typename BlasMatrix<IRing,_Rep>::Field Ring;
-		unsigned long r;
-		MatrixRank<Ring, Givaro::Modular<int32_t> > MR;
-		r = (unsigned long)MR. rank (A);
+		unsigned long r; size_t degree;
+		rankAndDegree (r, degree, A);
 		report << "   Matrix rank over a random prime field: " << r << std::endl;
 		report << "Computation of the rank finished.\n";
 		// a hack
@@ -529,20 +666,12 @@ namespace LinBox
 		const int64_t* prime_p;
 		std::vector<int64_t> e(NPrime); std::vector<int64_t>::iterator e_p;
 
-		report <<"   Compute the degree of min poly of AA^T: \n";
-		typedef Givaro::Modular<int32_t> Field;
-		integer Val; Field::Element v; size_t degree;
-		//integer Val; Field::Element v; unsigned long degree;
-        PrimeIterator<IteratorCategories::HeuristicTag> genprime(FieldTraits<Field>::bestBitSize(A.coldim()));
-		Field F (*genprime);
-		typename MatrixHomTrait<BlasMatrix <IRing, _Rep>, Field>::value_type Ap(F,A.rowdim(),A.coldim());
-		MatrixHom::map (Ap, A);
-		Valence::one_valence (v, degree, Ap);
+		integer Val;
 		report <<"   Degree of minial polynomial of AA^T = " << degree << '\n';
 		// if degree is small
 		if (degree < sqrt(double(order))) {
 			report << "   Computation of the valence starts:\n";
-			Valence::valence (Val, degree, A);
+			Valence::valenceParallel (Val, degree, A, numThreads());
 			report << "      Valence = " << Val << std::endl;
 			report << "   Computation of the valence of ends.\n";
 			Val = abs (Val);
@@ -590,8 +719,7 @@ namespace LinBox
 		// bonus assigns to its rough part
 		bonus = gcd (bonus, r_mod);
 		BlasVector<Givaro::ZRing<Integer> > smooth (Z,order), rough (Z,order);
-		smithFormSmooth (smooth, A, (long)r, e);
-		smithFormRough (rough, A, bonus);
+		smoothAndRough (smooth, rough, A, A, (long)r, e, bonus);
 		// fixed the rough largest invariant factor
 		if (r > 0) rough[r-1] = r_mod;
 
@@ -27,6 +27,8 @@
 #define __LINBOX_pp_gauss_H
 
 #include <map>
+#include <vector>
+#include <algorithm>
 #include <givaro/givconfig.h> // for Signed_Trait
 #include "linbox/algorithms/gauss.h"
 
@@ -67,7 +69,8 @@ namespace LinBox
             // Combine these in binary for use in StaticParameters
         PRIVILEGIATE_NO_COLUMN_PIVOTING	= 1,
         PRIVILEGIATE_REDUCING_FILLIN	= 2,
-        PRESERVE_UPPER_MATRIX		= 4
+        PRESERVE_UPPER_MATRIX		= 4,
+        PARALLEL_ELIMINATION		= 8
     };
 
         /** \brief Repository of functions for rank modulo 
@@ -561,10 +564,221 @@ namespace LinBox
 
             }
 
+            // ------------------------------------------------------
+            // Elimination by sets of independent pivots:
+            // at each step, units no two of which share a row or a
+            // column, nor have an entry in the column of another one,
+            // are pivots for all the other rows at once.
+            // Rows are reduced in parallel, with a dense accumulator
+            // per thread.  Columns of Q are permuted at the end only;
+            // with PreserveUpperMatrix the columns of the rows are
+            // relabeled accordingly and the pivot rows are moved to the
+            // top, in the order of their pivots, as with gauss_rankin.
+            // ------------------------------------------------------
+		template<class Modulo, class BB, class Container, class Perm, bool PreserveUpperMatrix>
+		void parallel_gauss_rankin(Modulo FMOD, Modulo PRIME, Container& ranks, BB& LigneA, Perm& Q, const size_t Ni, const size_t Nj)
+            {
+                linbox_check( Q.coldim() == Q.rowdim() );
+                linbox_check( Q.coldim() == Nj );
+
+                commentator().start ("Parallel Gaussian elimination modulo a prime power",
+                                     "PPRGE", Ni);
+
+                ranks.resize(0);
+
+                typedef typename BB::Row Vecteur;
+                typedef typename Vecteur::value_type E;
+                typedef typename Field::Element F;
+                typedef typename Signed_Trait<Modulo>::unsigned_type UModulo;
+
+                Modulo MOD = FMOD;
+#ifdef LINBOX_PRANK_OUT
+                std::cerr << "Parallel elimination mod " << MOD << " (" << PreserveUpperMatrix << ')' << std::endl;
+#endif
+
+                    // entries reduced modulo MOD
+                for(size_t i=0; i<Ni; ++i) {
+                    Vecteur& ligne = LigneA[i];
+                    size_t rs=0;
+                    for(size_t k=0; k<ligne.size(); ++k) {
+                        Modulo r = ligne[k].second;
+                        if ((r <0) || (r >= MOD)) r %= MOD ;
+                        if (r <0) r += MOD ;
+                        if (isNZero(r)) {
+                            ligne[rs] = ligne[k];
+                            ligne[rs].second = ( r );
+                            ++rs;
+                        }
+                    }
+                    ligne.resize(rs);
+                }
+
+                std::vector<bool> active(Ni, true);
+                std::vector<size_t> col_density(Nj), rows, pivots, pivotrows;
+                std::vector<UModulo> invpiv;
+                IndependentPivots P(Nj);
+                unsigned long indcol(0);
+                const Modulo prime(PRIME);
+                auto unit = [this,&prime](const F& e) { return ! this->MY_divides(prime, e); };
+
+                while (MOD > 1) {
+                    rows.resize(0);
+                    std::fill(col_density.begin(), col_density.end(), 0);
+                    for(size_t i=0; i<Ni; ++i)
+                        if (active[i] && LigneA[i].size()) {
+                            rows.push_back(i);
+                            for(size_t k=0; k<LigneA[i].size(); ++k)
+                                ++col_density[ LigneA[i][k].first ];
+                        }
+                    if (rows.empty()) break;
+
+                    if (! P.select(LigneA, rows, col_density, unit)) {
+                            // no unit left, all entries are divisible by PRIME
+                        for(size_t t=0; t<rows.size(); ++t)
+                            for(size_t k=0; k<LigneA[rows[t]].size(); ++k)
+                                LigneA[rows[t]][k].second /= PRIME;
+                        MOD /= PRIME;
+                        ranks.push_back( indcol );
+#ifdef LINBOX_PRANK_OUT
+                        std::cerr << "Rank mod " << PRIME << "^" << ranks.size() << " : " << indcol << std::endl;
+#endif
+                        continue;
+                    }
+
+                    invpiv.resize(P.size());
+                    for(size_t k=0; k<P.size(); ++k) {
+                        const E& e = LigneA[P.row(k)][P.position(k)];
+                        MY_Zpz_inv(invpiv[k], e.second, MOD);
+                        pivots.push_back( (size_t)e.first );
+                        pivotrows.push_back( P.row(k) );
+                        active[P.row(k)] = false;
+                    }
+                    indcol += (unsigned long)P.size();
+                    commentator().progress ((long)indcol);
+
+#ifdef __LINBOX_USE_OPENMP
+#pragma omp parallel
+#endif
+                    {
+                        std::vector<F> acc(Nj, F(0U));
+                        std::vector<size_t> mark(Nj, 0), nz;
+                        size_t stamp = 0;
+#ifdef __LINBOX_USE_OPENMP
+#pragma omp for schedule (dynamic, 64)
+#endif
+                        for(long t=0; t<(long)rows.size(); ++t) {
+                            const size_t l = rows[(size_t)t];
+                            if (! active[l]) continue;
+                            Vecteur& lignecourante = LigneA[l];
+                            bool hit = false;
+                            for(size_t k=0; !hit && (k<lignecourante.size()); ++k)
+                                hit = P.pivotOf(lignecourante[k].first) >= 0;
+                            if (! hit) continue;
+
+                            ++stamp;
+                            nz.resize(0);
+                            for(size_t k=0; k<lignecourante.size(); ++k) {
+                                const size_t c = lignecourante[k].first;
+                                acc[c] = lignecourante[k].second;
+                                mark[c] = stamp;
+                                nz.push_back(c);
+                            }
+                            for(size_t k=0; k<lignecourante.size(); ++k) {
+                                const long q = P.pivotOf(lignecourante[k].first);
+                                if (q < 0) continue;
+                                F headcoeff = MOD-(lignecourante[k].second);
+                                headcoeff *= invpiv[(size_t)q];
+                                headcoeff %= (UModulo)MOD ;
+                                const Vecteur& lignepivot = LigneA[P.row((size_t)q)];
+                                for(size_t m=0; m<lignepivot.size(); ++m) {
+                                    const size_t c = lignepivot[m].first;
+                                    if (mark[c] != stamp) {
+                                        mark[c] = stamp;
+                                        acc[c] = F(0U);
+                                        nz.push_back(c);
+                                    }
+                                    if (m == P.position((size_t)q))
+                                        acc[c] = F(0U);
+                                    else {
+                                        acc[c] += headcoeff * lignepivot[m].second;
+                                        acc[c] %= (UModulo)MOD;
+                                    }
+                                }
+                            }
+                            std::sort(nz.begin(), nz.end());
+                            Vecteur construit(nz.size());
+                            size_t ci = 0;
+                            for(size_t m=0; m<nz.size(); ++m)
+                                if (isNZero(acc[nz[m]]))
+                                    construit[ci++] = E(nz[m], acc[nz[m]]);
+                            construit.resize(ci);
+                            lignecourante = construit;
+                        }
+                    }
+
+                    if (! PreserveUpperMatrix) {
+                        std::vector<size_t> done(P.size());
+                        for(size_t k=0; k<done.size(); ++k) done[k] = P.row(k);
+                        P.clear(LigneA);
+                        for(size_t k=0; k<done.size(); ++k)
+                            LigneA[done[k]] = Vecteur(0);
+                    }
+                }
+                while( MOD > 1) {
+                    MOD /= PRIME;
+                    ranks.push_back( indcol );
+                }
+
+                    // pivot columns first, in their order
+                std::vector<size_t> pos(Nj), at(Nj);
+                for(size_t j=0; j<Nj; ++j) pos[j] = at[j] = j;
+                for(size_t t=0; t<pivots.size(); ++t) {
+                    const size_t p = pos[ pivots[t] ];
+                    if (p != t) {
+                        Q.permute(t,p);
+                        std::swap(at[t], at[p]);
+                        pos[ at[t] ] = t;
+                        pos[ at[p] ] = p;
+                    }
+                }
+                if (PreserveUpperMatrix) {
+                    for(size_t i=0; i<Ni; ++i) {
+                        Vecteur& ligne = LigneA[i];
+                        for(size_t k=0; k<ligne.size(); ++k)
+                            ligne[k].first = pos[ ligne[k].first ];
+                        std::sort(ligne.begin(), ligne.end(),
+                                  [](const E& a, const E& b) { return a.first < b.first; });
+                    }
+                        // pivot rows first, then the others in their order
+                    std::vector<Vecteur> ordered(Ni);
+                    std::vector<bool> moved(Ni, false);
+                    size_t r = 0;
+                    for(size_t t=0; t<pivotrows.size(); ++t, ++r) {
+                        std::swap(ordered[r], LigneA[pivotrows[t]]);
+                        moved[pivotrows[t]] = true;
+                    }
+                    for(size_t i=0; i<Ni; ++i)
+                        if (! moved[i]) std::swap(ordered[r++], LigneA[i]);
+                    for(size_t i=0; i<Ni; ++i)
+                        std::swap(LigneA[i], ordered[i]);
+                }
+
+#ifdef LINBOX_PRANK_OUT
+                std::cerr << "Rank mod " << FMOD << " : " << indcol << std::endl;
+#endif
+                commentator().stop ("done", 0, "PPRGE");
+            }
+
 		template<class Modulo, class BB, class D, class Container, class Perm>
 		void prime_power_rankin (Modulo FMOD, Modulo PRIME, Container& ranks, BB& SLA, Perm& Q, const size_t Ni, const size_t Nj, const D& density_trait, int StaticParameters=PRIVILEGIATE_NO_COLUMN_PIVOTING)
             {
-                if (PRIVILEGIATE_NO_COLUMN_PIVOTING & StaticParameters) {
+                if (PARALLEL_ELIMINATION & StaticParameters) {
+                    if (PRESERVE_UPPER_MATRIX & StaticParameters) {
+                        parallel_gauss_rankin<Modulo,BB,Container,Perm,true>(FMOD,PRIME,ranks, SLA, Q, Ni, Nj);
+                    } else {
+                        parallel_gauss_rankin<Modulo,BB,Container,Perm,false>(FMOD,PRIME,ranks, SLA, Q, Ni, Nj);
+                    }
+                } else if (PRIVILEGIATE_NO_COLUMN_PIVOTING & StaticParameters) {
                     if (PRESERVE_UPPER_MATRIX & StaticParameters) {
                         gauss_rankin<Modulo,BB,D,Container,Perm,true,true>(FMOD,PRIME,ranks, SLA, Q, Ni, Nj, density_trait);
                     } else {
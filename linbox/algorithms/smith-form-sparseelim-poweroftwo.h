@@ -25,7 +25,11 @@
 #ifndef __LINBOX_pp_gauss_poweroftwo_H
 #define __LINBOX_pp_gauss_poweroftwo_H
 #include <map>
+#include <vector>
+#include <algorithm>
+#include <type_traits>
 #include <givaro/givconfig.h> // for Signed_Trait
+#include "linbox/util/error.h"
 #include "linbox/algorithms/smith-form-sparseelim-local.h"
 
 #ifdef DEBUG
@@ -56,6 +60,10 @@ namespace LinBox
         /** \brief Repository of functions for rank modulo 
          * a prime power by elimination on sparse matrices.
          * Specialization for powers of 2
+         *
+         * UnsignedIntType is the arithmetic modulo 2^k, by native
+         * overflow for unsigned words: uint64_t, or __uint128_t for
+         * exponents k up to 127, RecInt::ruint, or Givaro::Integer.
          */
     template<typename UnsignedIntType>
     class PowerGaussDomainPowerOfTwo  {
@@ -95,7 +103,7 @@ namespace LinBox
             //  IEEE Transactions on Computers, 2013]  
             // http://doi.ieeecomputersociety.org/10.1109/TC.2013.94
         UInt_t& MY_Zpz_inv (UInt_t& u1, const UInt_t& a, const size_t exponent, const UInt_t& TWOTOEXPMONE) const {
-            static const UInt_t ttep2(TWOTOEXPMONE+3U);
+            const UInt_t ttep2(TWOTOEXPMONE+3U);
             if (this->isOne(a)) return u1=this->one;
             REQUIRE( (one<<exponent) == (TWOTOEXPMONE+1U) );
             REQUIRE( a <= TWOTOEXPMONE );
@@ -374,7 +382,7 @@ namespace LinBox
 
 
 #ifdef LINBOX_PRANK_OUT
-                std::cerr << "Elimination mod " << TWOK << std::endl;
+                std::cerr << "Elimination mod 2^" << EXPONENT << std::endl;
 #endif
 
                 D col_density(Nj);
@@ -530,9 +538,255 @@ namespace LinBox
 
             }
 
+            /** \brief Elimination by sets of independent pivots.
+             *
+             * As PowerGaussDomain::parallel_gauss_rankin: at each step,
+             * the rows of a set of structurally independent odd pivots
+             * are eliminated from all the other rows at once, each row
+             * concurrently with its own dense accumulator.  The pivot
+             * rows are first packed by columns and values, so that the
+             * row updates are contiguous multiply-adds, left unreduced as
+             * the native arithmetic wraps modulo a multiple of 2^k.
+             * The elimination works on a copy of the entries in UInt_t,
+             * written back in the matrix at the end.  With
+             * PreserveUpperMatrix the columns of the rows are relabeled
+             * as Q and the pivot rows are moved to the top, in the order
+             * of their pivots, as with gauss_rankin.
+             */
+        template<class BB, class Container, class Perm, bool PreserveUpperMatrix>
+        void parallel_gauss_rankin(size_t EXPONENTMAX, Container& ranks, BB& LigneA, Perm& Q, const size_t Ni, const size_t Nj)
+            {
+                linbox_check( Q.coldim() == Q.rowdim() );
+                linbox_check( Q.coldim() == Nj );
+
+                commentator().start ("Parallel Gaussian elimination modulo a prime power of 2",
+                                     "PPRGEPo2", Ni);
+
+                ranks.resize(0);
+
+                typedef typename BB::Row Vecteur;
+                typedef typename WorkRows::Row Ligne;
+                size_t EXPONENT = EXPONENTMAX;
+                UInt_t TWOK(1U); TWOK <<= EXPONENT;
+                UInt_t TWOKMONE(TWOK); --TWOKMONE;
+
+#ifdef LINBOX_PRANK_OUT
+                std::cerr << "Parallel elimination mod 2^" << EXPONENT << " (" << PreserveUpperMatrix << ')' << std::endl;
+#endif
+
+                    // entries reduced modulo 2^k
+                WorkRows W(Ni);
+                for(size_t i=0; i<Ni; ++i)
+                    for(auto const & iter : LigneA[i]) {
+                        UInt_t r = ((UInt_t)iter.second) & TWOKMONE;
+                        if (isNZero(r))
+                            W[i].emplace_back((size_t)iter.first, r);
+                    }
+
+                std::vector<bool> active(Ni, true);
+                std::vector<size_t> col_density(Nj), rows, pivots, pivotrows;
+                std::vector<UInt_t> invpiv;
+                std::vector<std::vector<size_t> > pcols;
+                std::vector<std::vector<UInt_t> > pvals;
+                IndependentPivots P(Nj);
+                unsigned long indcol(0);
+                auto unit = [this](const UInt_t& e) { return this->isOdd(e); };
+
+                while (EXPONENT > 0) {
+                    rows.resize(0);
+                    std::fill(col_density.begin(), col_density.end(), 0);
+                    for(size_t i=0; i<Ni; ++i)
+                        if (active[i] && W[i].size()) {
+                            rows.push_back(i);
+                            for(size_t k=0; k<W[i].size(); ++k)
+                                ++col_density[ W[i][k].first ];
+                        }
+                    if (rows.empty()) break;
+
+                    if (! P.select(W, rows, col_density, unit)) {
+                            // no odd entry left, reduce everything by one power of 2
+                        for(size_t t=0; t<rows.size(); ++t)
+                            for(size_t k=0; k<W[rows[t]].size(); ++k)
+                                W[rows[t]][k].second >>= 1;
+                        --EXPONENT;
+                        TWOK >>= 1;
+                        TWOKMONE >>= 1;
+                        ranks.push_back( indcol );
+#ifdef LINBOX_PRANK_OUT
+                        std::cerr << "Rank mod 2^" << ranks.size() << " : " << indcol << std::endl;
+#endif
+                        continue;
+                    }
+
+                        // pivot rows without their pivot, by columns and values
+                    invpiv.resize(P.size());
+                    pcols.resize(P.size());
+                    pvals.resize(P.size());
+                    for(size_t k=0; k<P.size(); ++k) {
+                        const Ligne& lignepivot = W[P.row(k)];
+                        const size_t pk = P.position(k);
+                        MY_Zpz_inv(invpiv[k], lignepivot[pk].second, EXPONENT, TWOKMONE);
+                        pcols[k].resize(0);
+                        pvals[k].resize(0);
+                        for(size_t m=0; m<lignepivot.size(); ++m)
+                            if (m != pk) {
+                                pcols[k].push_back(lignepivot[m].first);
+                                pvals[k].push_back(lignepivot[m].second);
+                            }
+                        pivots.push_back( lignepivot[pk].first );
+                        pivotrows.push_back( P.row(k) );
+                        active[P.row(k)] = false;
+                    }
+                    indcol += (unsigned long)P.size();
+                    commentator().progress ((long)indcol);
+
+#ifdef __LINBOX_USE_OPENMP
+#pragma omp parallel
+#endif
+                    {
+                        std::vector<UInt_t> acc(Nj, zero);
+                        std::vector<size_t> mark(Nj, 0), nz;
+                        std::vector<std::pair<size_t,UInt_t> > heads;
+                        size_t stamp = 0;
+#ifdef __LINBOX_USE_OPENMP
+#pragma omp for schedule (dynamic, 64)
+#endif
+                        for(long t=0; t<(long)rows.size(); ++t) {
+                            const size_t l = rows[(size_t)t];
+                            if (! active[l]) continue;
+                            Ligne& lignecourante = W[l];
+
+                                // entries in the pivot columns give the multipliers
+                            ++stamp;
+                            nz.resize(0);
+                            heads.resize(0);
+                            for(size_t k=0; k<lignecourante.size(); ++k) {
+                                const size_t c = lignecourante[k].first;
+                                const long q = P.pivotOf(c);
+                                if (q < 0) {
+                                    acc[c] = lignecourante[k].second;
+                                    mark[c] = stamp;
+                                    nz.push_back(c);
+                                } else {
+                                    UInt_t headcoeff = TWOK-lignecourante[k].second;
+                                    headcoeff *= invpiv[(size_t)q];
+                                    headcoeff &= TWOKMONE;
+                                    heads.emplace_back((size_t)q, headcoeff);
+                                }
+                            }
+                            if (heads.empty()) continue;
+
+                            for(auto const & h : heads) {
+                                const std::vector<size_t>& pc = pcols[h.first];
+                                for(size_t m=0; m<pc.size(); ++m)
+                                    if (mark[pc[m]] != stamp) {
+                                        mark[pc[m]] = stamp;
+                                        acc[pc[m]] = zero;
+                                        nz.push_back(pc[m]);
+                                    }
+                                axpyin(acc.data(), pc.data(), pvals[h.first].data(), h.second, pc.size());
+                            }
+
+                            std::sort(nz.begin(), nz.end());
+                            Ligne construit;
+                            construit.reserve(nz.size());
+                            for(size_t m=0; m<nz.size(); ++m) {
+                                UInt_t r = acc[nz[m]] & TWOKMONE;
+                                if (isNZero(r))
+                                    construit.emplace_back(nz[m], r);
+                            }
+                            lignecourante.swap(construit);
+                        }
+                    }
+
+                    if (! PreserveUpperMatrix) {
+                        std::vector<size_t> done(P.size());
+                        for(size_t k=0; k<done.size(); ++k) done[k] = P.row(k);
+                        P.clear(W);
+                        for(size_t k=0; k<done.size(); ++k)
+                            W[done[k]] = Ligne(0);
+                    }
+                }
+                while( EXPONENT > 0) {
+                    --EXPONENT;
+                    ranks.push_back( indcol );
+                }
+
+                    // pivot columns first, in their order
+                std::vector<size_t> pos(Nj), at(Nj);
+                for(size_t j=0; j<Nj; ++j) pos[j] = at[j] = j;
+                for(size_t t=0; t<pivots.size(); ++t) {
+                    const size_t p = pos[ pivots[t] ];
+                    if (p != t) {
+                        Q.permute(t,p);
+                        std::swap(at[t], at[p]);
+                        pos[ at[t] ] = t;
+                        pos[ at[p] ] = p;
+                    }
+                }
+
+                    // pivot rows first, then the others in their order
+                std::vector<size_t> order;
+                order.reserve(Ni);
+                if (PreserveUpperMatrix) {
+                    std::vector<bool> moved(Ni, false);
+                    for(size_t t=0; t<pivotrows.size(); ++t) {
+                        order.push_back(pivotrows[t]);
+                        moved[pivotrows[t]] = true;
+                    }
+                    for(size_t i=0; i<Ni; ++i)
+                        if (! moved[i]) order.push_back(i);
+                } else
+                    for(size_t i=0; i<Ni; ++i) order.push_back(i);
+
+                for(size_t i=0; i<Ni; ++i) {
+                    Ligne& ligne = W[order[i]];
+                    if (PreserveUpperMatrix) {
+                        for(size_t k=0; k<ligne.size(); ++k)
+                            ligne[k].first = pos[ ligne[k].first ];
+                        std::sort(ligne.begin(), ligne.end(),
+                                  [](const std::pair<size_t,UInt_t>& a, const std::pair<size_t,UInt_t>& b) { return a.first < b.first; });
+                    }
+                    Vecteur toto;
+                    toto.reserve(ligne.size());
+                    for(auto const & iter : ligne)
+                        toto.emplace_back(iter.first, iter.second);
+                    LigneA[i] = toto;
+                }
+
+#ifdef LINBOX_PRANK_OUT
+                std::cerr << "Rank mod 2^" << EXPONENTMAX << " : " << indcol << std::endl;
+#endif
+                commentator().stop ("done", 0, "PPRGEPo2");
+            }
+
+            /** \brief Ranks modulo 2^i, i <= EXPONENT, in place.
+             *
+             * Integral entries narrower than UInt_t and than
+             * EXPONENT bits go through parallel_gauss_rankin, which
+             * works on a copy in UInt_t.
+             * With PRESERVE_UPPER_MATRIX the upper matrix, reduced
+             * modulo 2^EXPONENT, is written back in the entries:
+             * LinboxError is thrown when they have less than EXPONENT
+             * bits, rather than truncating it.
+             */
         template<class BB, class D, class Container, class Perm>
         void prime_power_rankin (size_t EXPONENT, Container& ranks, BB& SLA, Perm& Q, const size_t Ni, const size_t Nj, const D& density_trait, int StaticParameters=PRIVILEGIATE_NO_COLUMN_PIVOTING) {
-            if (PRIVILEGIATE_NO_COLUMN_PIVOTING & StaticParameters) {
+            typedef typename BB::Row::value_type::second_type Stored;
+                // in place, residues modulo 2^EXPONENT would be truncated
+                // in entries narrower than UInt_t and than EXPONENT bits
+            const bool narrow = std::is_integral<Stored>::value && (sizeof(Stored) < sizeof(UInt_t))
+                && (EXPONENT > 8*sizeof(Stored));
+                // so would the upper matrix written back modulo 2^EXPONENT
+            if (narrow && (PRESERVE_UPPER_MATRIX & StaticParameters))
+                throw LinboxError("PowerGaussDomainPowerOfTwo: the entries of the matrix are too narrow to preserve the upper matrix modulo 2^EXPONENT");
+            if ((PARALLEL_ELIMINATION & StaticParameters) || narrow) {
+                if (PRESERVE_UPPER_MATRIX & StaticParameters) {
+                    parallel_gauss_rankin<BB,Container,Perm,true>(EXPONENT,ranks, SLA, Q, Ni, Nj);
+                } else {
+                    parallel_gauss_rankin<BB,Container,Perm,false>(EXPONENT,ranks, SLA, Q, Ni, Nj);
+                }
+            } else if (PRIVILEGIATE_NO_COLUMN_PIVOTING & StaticParameters) {
                 if (PRESERVE_UPPER_MATRIX & StaticParameters) {
                     gauss_rankin<BB,D,Container,Perm,true,true>(EXPONENT,ranks, SLA, Q, Ni, Nj, density_trait);
                 } else {
@@ -564,6 +818,23 @@ namespace LinBox
             return L;
         }
 
+    protected:
+            // rows of (column, value) in UInt_t, for IndependentPivots
+        struct WorkRows : public std::vector<std::vector<std::pair<size_t,UInt_t> > > {
+            typedef std::vector<std::pair<size_t,UInt_t> > Row;
+            WorkRows (size_t n) : std::vector<Row>(n) {}
+        };
+
+            // acc[c[m]] += h v[m], m < n, without reduction; the columns
+            // c[m] are distinct, so the loop vectorizes as a scatter
+        static void axpyin(UInt_t* acc, const size_t* c, const UInt_t* v, const UInt_t& h, size_t n) {
+#if defined(__LINBOX_USE_OPENMP) && (_OPENMP >= 201307)
+#pragma omp simd
+#endif
+            for(size_t m=0; m<n; ++m)
+                acc[c[m]] += h * v[m];
+        }
+
     };
 
 
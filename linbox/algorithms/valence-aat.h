@@ -0,0 +1,128 @@
+/* linbox/algorithms/valence-aat.h
+ *
+ * ========LICENCE========
+ * This file is part of the library LinBox.
+ *
+ * LinBox is free software: you can redistribute it and/or modify
+ * it under the terms of the  GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ * ========LICENCE========
+ */
+
+/*! @file algorithms/valence-aat.h
+ * @ingroup algorithms
+ * @brief Projected Krylov sequences of \f$AA^T\f$ modulo several primes at once.
+ *
+ * The integer matrix A is stored once as a MultiModSparseMatrix, so
+ * that each application of \f$AA^T\f$ traverses it once for k primes.
+ * When it has fewer nonzero entries than twice A, the product
+ * \f$AA^T\f$ is formed explicitly and applied instead of the composition.
+ */
+
+#ifndef __LINBOX_valence_aat_H
+#define __LINBOX_valence_aat_H
+
+#include <vector>
+
+#include "linbox/integer.h"
+#include "linbox/blackbox/multimod-sparse.h"
+#include "linbox/algorithms/multimod-wiedemann.h"
+
+namespace LinBox
+{
+
+	/** @brief Integer \f$AA^T\f$ for the sequences of the valence.
+	 * \ingroup algorithms
+	 *
+	 * A is kept as a MultiModSparseMatrix; fits() is false when it does
+	 * not fit, nothing else may then be called.
+	 */
+	class IntegerAAT {
+	public:
+		typedef MultiModSparseMatrix::Vector Vector;
+		typedef MultiModSparseMatrix::Moduli Moduli;
+
+		/**
+		 * @param A       integer blackbox with indexed iterators
+		 * @param length  number of terms of the sequences to come, to weigh
+		 *                the cost of forming \f$AA^T\f$
+		 */
+		template <class Blackbox>
+		IntegerAAT (const Blackbox& A, size_t length) :
+			_A (A), _explicit (false)
+		{
+			if (! _A.fits() || ! _A.productFits()) return;
+			// the product costs less than the applications it spares
+			const size_t nnz = _A.size();
+			if (_A.productWork() > (double)length * (double)nnz) return;
+			if (_A.productSize (2 * nnz) >= 2 * nnz) return;
+			_A. product (_B);
+			_explicit = true;
+		}
+
+		bool fits () const { return _A.fits(); }
+
+		//! whether \f$AA^T\f$ is applied as an explicit sparse matrix
+		bool isExplicit () const { return _explicit; }
+
+		size_t rowdim () const { return _A.rowdim(); }
+
+		//! nonzero entries read per application of \f$AA^T\f$
+		size_t traffic () const { return _explicit ? _B.size() : 2 * _A.size(); }
+
+		integer& cassini (integer& r) const { return _A.cassini (r); }
+
+		/// y = AA^T x modulo each of the primes P, x and y interleaved.
+		Vector& apply (Vector& y, const Vector& x, const Moduli& P) const
+		{
+			if (_explicit)
+				return _B. apply (y, x, P);
+			Vector t;
+			_A. applyTranspose (t, x, P);
+			return _A. apply (y, t, P);
+		}
+
+		/** The sequences \f$s_i = u^T (AA^T)^i v\f$, \f$i < \f$ length,
+		 * for random u and v modulo each of the primes, with one traversal
+		 * of the matrix per step for all the primes.
+		 * s[l][i] is the term i modulo primes[l].
+		 */
+		void sequences (std::vector<std::vector<uint64_t> >& s, const Moduli& primes,
+				size_t length, uint64_t seed) const
+		{
+			const IntegerAAT& B = *this;
+			MultiModKrylov K ([&B, &primes] (Vector& y, const Vector& x) {
+				B. apply (y, x, primes);
+			}, rowdim(), primes, seed);
+			K. extend (length);
+			s. resize (primes.size());
+			for (size_t l = 0; l < primes.size(); ++l)
+				s[l] = K. sequence (l);
+		}
+
+	protected:
+		MultiModSparseMatrix _A, _B;
+		bool _explicit;
+	};
+
+}
+
+#endif // __LINBOX_valence_aat_H
+
+// Local Variables:
+// mode: C++
+// tab-width: 4
+// indent-tabs-mode: nil
+// c-basic-offset: 4
+// End:
+// vim:sts=4:sw=4:ts=4:et:sr:cino=>s,f0,{0,g0,(0,\:0,t0,+0,=s
@@ -0,0 +1,144 @@
+/* linbox/blackbox/block-apply.h
+ *
+ * ========LICENCE========
+ * This file is part of the library LinBox.
+ *
+ * LinBox is free software: you can redistribute it and/or modify
+ * it under the terms of the  GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ * ========LICENCE========
+ */
+
+/*! @file blackbox/block-apply.h
+ * @ingroup blackbox
+ * @brief Matrix-block products \f$Y = AX\f$ and \f$Y = A^TX\f$ for any blackbox.
+ */
+
+#ifndef __LINBOX_blackbox_block_apply_H
+#define __LINBOX_blackbox_block_apply_H
+
+#include <utility>
+#include <type_traits>
+
+#include "linbox/util/debug.h"
+
+namespace LinBox
+{
+
+	/** @brief Capability detection for native block applies.
+	 *
+	 * A blackbox has a native block apply when it provides the members
+	 * \code
+	 * template<class OutBlock, class InBlock>
+	 * OutBlock& applyBlock (OutBlock& Y, const InBlock& X) const;          // Y = A X
+	 * template<class OutBlock, class InBlock>
+	 * OutBlock& applyTransposeBlock (OutBlock& Y, const InBlock& X) const; // Y = A^T X
+	 * \endcode
+	 * (either one may be missing).  The blocks are dense matrices
+	 * (BlasMatrix or BlasSubmatrix).  BlockApplyTraits::apply and
+	 * BlockApplyTraits::applyTranspose use them when they exist, and fall
+	 * back to one \c apply (resp. \c applyTranspose) per column otherwise,
+	 * which traverses the blackbox once per column of the block.
+	 *
+	 * Composed blackboxes (Compose, Transpose) forward to the traits of
+	 * their components, so a block product is native as deep as possible.
+	 */
+	template<class Blackbox>
+	struct BlockApplyTraits {
+	private:
+		template<class B, class Out, class In>
+		static auto _testApply (int)
+		-> decltype(std::declval<const B&>().applyBlock(std::declval<Out&>(), std::declval<const In&>()), std::true_type());
+		template<class B, class Out, class In>
+		static std::false_type _testApply (...);
+
+		template<class B, class Out, class In>
+		static auto _testApplyTranspose (int)
+		-> decltype(std::declval<const B&>().applyTransposeBlock(std::declval<Out&>(), std::declval<const In&>()), std::true_type());
+		template<class B, class Out, class In>
+		static std::false_type _testApplyTranspose (...);
+
+	public:
+		//! \c value is true if \f$Y = AX\f$ is native for these block types.
+		template<class OutBlock, class InBlock>
+		struct hasApply : public decltype(_testApply<Blackbox,OutBlock,InBlock>(0)) {};
+
+		//! \c value is true if \f$Y = A^TX\f$ is native for these block types.
+		template<class OutBlock, class InBlock>
+		struct hasApplyTranspose : public decltype(_testApplyTranspose<Blackbox,OutBlock,InBlock>(0)) {};
+
+		//! \f$Y \gets AX\f$
+		template<class OutBlock, class InBlock>
+		static OutBlock& apply (OutBlock& Y, const Blackbox& A, const InBlock& X)
+		{
+			linbox_check (Y.rowdim () == A.rowdim ());
+			linbox_check (A.coldim () == X.rowdim ());
+			linbox_check (Y.coldim () == X.coldim ());
+			return _apply (Y, A, X, hasApply<OutBlock,InBlock>());
+		}
+
+		//! \f$Y \gets A^TX\f$
+		template<class OutBlock, class InBlock>
+		static OutBlock& applyTranspose (OutBlock& Y, const Blackbox& A, const InBlock& X)
+		{
+			linbox_check (Y.rowdim () == A.coldim ());
+			linbox_check (A.rowdim () == X.rowdim ());
+			linbox_check (Y.coldim () == X.coldim ());
+			return _applyTranspose (Y, A, X, hasApplyTranspose<OutBlock,InBlock>());
+		}
+
+	private:
+		template<class OutBlock, class InBlock>
+		static OutBlock& _apply (OutBlock& Y, const Blackbox& A, const InBlock& X, std::true_type)
+		{
+			return A.applyBlock (Y, X);
+		}
+
+		template<class OutBlock, class InBlock>
+		static OutBlock& _apply (OutBlock& Y, const Blackbox& A, const InBlock& X, std::false_type)
+		{
+			typename OutBlock::ColIterator      i = Y.colBegin ();
+			typename InBlock::ConstColIterator  j = X.colBegin ();
+			for (; j != X.colEnd (); ++i, ++j)
+				A.apply (*i, *j);
+			return Y;
+		}
+
+		template<class OutBlock, class InBlock>
+		static OutBlock& _applyTranspose (OutBlock& Y, const Blackbox& A, const InBlock& X, std::true_type)
+		{
+			return A.applyTransposeBlock (Y, X);
+		}
+
+		template<class OutBlock, class InBlock>
+		static OutBlock& _applyTranspose (OutBlock& Y, const Blackbox& A, const InBlock& X, std::false_type)
+		{
+			typename OutBlock::ColIterator      i = Y.colBegin ();
+			typename InBlock::ConstColIterator  j = X.colBegin ();
+			for (; j != X.colEnd (); ++i, ++j)
+				A.applyTranspose (*i, *j);
+			return Y;
+		}
+	};
+
+}
+
+#endif // __LINBOX_blackbox_block_apply_H
+
+// Local Variables:
+// mode: C++
+// tab-width: 4
+// indent-tabs-mode: nil
+// c-basic-offset: 4
+// End:
+// vim:sts=4:sw=4:ts=4:et:sr:cino=>s,f0,{0,g0,(0,\:0,t0,+0,=s
@@ -159,6 +159,20 @@ namespace LinBox
 		template<class OutVector, class InVector>
 		OutVector& applyTranspose (OutVector& y, const InVector& x) const;
 
+		/** Block application <code>Y = A*X</code>.
+		 * Each switch is applied to a pair of rows of the block at once,
+		 * so the switches are traversed once for all the columns.
+		 * This is the native block apply used by BlockApplyTraits.
+		 */
+		template<class OutBlock, class InBlock>
+		OutBlock& applyBlock (OutBlock& Y, const InBlock& X) const;
+
+		/** Block application <code>Y = transpose (A)*X</code>.
+		 * The transposed switches are applied in reverse order.
+		 */
+		template<class OutBlock, class InBlock>
+		OutBlock& applyTransposeBlock (OutBlock& Y, const InBlock& X) const;
+
 		template<typename _Tp1, typename _Sw1 = typename Switch::template rebind<_Tp1>::other>
 		struct rebind {
 			typedef Butterfly<_Tp1, _Sw1> other;
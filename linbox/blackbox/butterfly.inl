@@ -51,6 +51,7 @@
 #include "linbox/blackbox/blackbox-interface.h"
 #include "linbox/vector/vector-domain.h"
 #include "linbox/field/hom.h"
+#include "linbox/util/debug.h"
 
 /** @file blackbox/butterfly.inl
  *
@@ -102,6 +103,50 @@ namespace LinBox
 		return y;
 	}
 
+	template <class Field, class Switch>
+	template<class OutBlock, class InBlock>
+	inline OutBlock& Butterfly<Field, Switch>::applyBlock (OutBlock& Y, const InBlock& X) const
+	{
+		linbox_check (Y.rowdim () == _n && X.rowdim () == _n);
+		linbox_check (Y.coldim () == X.coldim ());
+
+		std::vector< std::pair<size_t, size_t> >::const_iterator idx_iter = _indices.begin ();
+		typename std::vector<Switch>::const_iterator switch_iter = _switches.begin ();
+		const size_t s = X.coldim ();
+
+		for (size_t i = 0; i < _n; ++i)
+			for (size_t j = 0; j < s; ++j)
+				field().assign (Y.refEntry (i, j), X.getEntry (i, j));
+
+		for (; idx_iter != _indices.end (); ++idx_iter, ++switch_iter)
+			for (size_t j = 0; j < s; ++j)
+				switch_iter->apply (field(), Y.refEntry (idx_iter->first, j), Y.refEntry (idx_iter->second, j));
+
+		return Y;
+	}
+
+	template <class Field, class Switch>
+	template<class OutBlock, class InBlock>
+	inline OutBlock& Butterfly<Field, Switch>::applyTransposeBlock (OutBlock& Y, const InBlock& X) const
+	{
+		linbox_check (Y.rowdim () == _n && X.rowdim () == _n);
+		linbox_check (Y.coldim () == X.coldim ());
+
+		std::vector< std::pair<size_t, size_t> >::const_reverse_iterator idx_iter = _indices.rbegin ();
+		typename std::vector<Switch>::const_reverse_iterator switch_iter = _switches.rbegin ();
+		const size_t s = X.coldim ();
+
+		for (size_t i = 0; i < _n; ++i)
+			for (size_t j = 0; j < s; ++j)
+				field().assign (Y.refEntry (i, j), X.getEntry (i, j));
+
+		for (; idx_iter != _indices.rend (); ++idx_iter, ++switch_iter)
+			for (size_t j = 0; j < s; ++j)
+				switch_iter->applyTranspose (field(), Y.refEntry (idx_iter->first, j), Y.refEntry (idx_iter->second, j));
+
+		return Y;
+	}
+
 	template <class Field, class Switch>
 	void Butterfly<Field, Switch>::buildIndices ()
 	{
@@ -32,6 +32,8 @@
 #include "linbox/linbox-config.h"
 #include "linbox/blackbox/blackbox-interface.h"
 #include "linbox/vector/blas-vector.h"
+#include "linbox/matrix/dense-matrix.h"
+#include "linbox/blackbox/block-apply.h"
 
 namespace LinBox
 {
@@ -168,6 +170,29 @@ namespace LinBox
 			return y;
 		}
 
+		/** Block product \f$ Y \gets (A\cdot B)\cdot X\f$.
+		 * Uses the block applies of A and B (see BlockApplyTraits), with a
+		 * dense intermediate block instead of one vector per column.
+		 */
+		template <class OutBlock, class InBlock>
+		OutBlock& applyBlock (OutBlock& Y, const InBlock& X) const
+		{
+			BlasMatrix<Field> T (field(), _B_ptr->rowdim (), X.coldim ());
+			BlockApplyTraits<Blackbox2>::apply (T, *_B_ptr, X);
+			return BlockApplyTraits<Blackbox1>::apply (Y, *_A_ptr, T);
+		}
+
+		/** Block product \f$ Y \gets (A\cdot B)^t\cdot X\f$.
+		 * Applies A^t then B^t, blockwise.
+		 */
+		template <class OutBlock, class InBlock>
+		OutBlock& applyTransposeBlock (OutBlock& Y, const InBlock& X) const
+		{
+			BlasMatrix<Field> T (field(), _A_ptr->coldim (), X.coldim ());
+			BlockApplyTraits<Blackbox1>::applyTranspose (T, *_A_ptr, X);
+			return BlockApplyTraits<Blackbox2>::applyTranspose (Y, *_B_ptr, T);
+		}
+
 		template<typename _Tp1, typename _Tp2 = _Tp1>
 		struct rebind {
 			typedef ComposeOwner<
@@ -343,6 +368,40 @@ namespace LinBox
 			return y;
 		}
 
+		/// Block product \f$ Y \gets (A_0\cdots A_k)\cdot X\f$, see BlockApplyTraits.
+		template <class OutBlock, class InBlock>
+		OutBlock& applyBlock (OutBlock& Y, const InBlock& X) const
+		{
+			const size_t k = _BlackboxL.size();
+			if (k == 1)
+				return BlockApplyTraits<Blackbox>::apply (Y, *_BlackboxL[0], X);
+			BlasMatrix<Field> T (field(), _BlackboxL[k-1]->rowdim (), X.coldim ());
+			BlockApplyTraits<Blackbox>::apply (T, *_BlackboxL[k-1], X);
+			for (size_t i = k-2; i > 0; --i) {
+				BlasMatrix<Field> S (field(), _BlackboxL[i]->rowdim (), X.coldim ());
+				BlockApplyTraits<Blackbox>::apply (S, *_BlackboxL[i], T);
+				T = S;
+			}
+			return BlockApplyTraits<Blackbox>::apply (Y, *_BlackboxL[0], T);
+		}
+
+		/// Block product \f$ Y \gets (A_0\cdots A_k)^t\cdot X\f$, see BlockApplyTraits.
+		template <class OutBlock, class InBlock>
+		OutBlock& applyTransposeBlock (OutBlock& Y, const InBlock& X) const
+		{
+			const size_t k = _BlackboxL.size();
+			if (k == 1)
+				return BlockApplyTraits<Blackbox>::applyTranspose (Y, *_BlackboxL[0], X);
+			BlasMatrix<Field> T (field(), _BlackboxL[0]->coldim (), X.coldim ());
+			BlockApplyTraits<Blackbox>::applyTranspose (T, *_BlackboxL[0], X);
+			for (size_t i = 1; i < k-1; ++i) {
+				BlasMatrix<Field> S (field(), _BlackboxL[i]->coldim (), X.coldim ());
+				BlockApplyTraits<Blackbox>::applyTranspose (S, *_BlackboxL[i], T);
+				T = S;
+			}
+			return BlockApplyTraits<Blackbox>::applyTranspose (Y, *_BlackboxL[k-1], T);
+		}
+
 		template<typename _Tp1>
 		struct rebind {
 			typedef Compose<typename Blackbox::template rebind<_Tp1>::other, typename Blackbox::template rebind<_Tp1>::other> other;
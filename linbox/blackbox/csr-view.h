@@ -0,0 +1,186 @@
+/* linbox/blackbox/csr-view.h
+ *
+ * ========LICENCE========
+ * This file is part of the library LinBox.
+ *
+ * LinBox is free software: you can redistribute it and/or modify
+ * it under the terms of the  GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ * ========LICENCE========
+ */
+
+/*! @file blackbox/csr-view.h
+ * @ingroup blackbox
+ * @brief Read-only blackbox over CSR arrays owned by the caller.
+ *
+ * SparseMatrix<Field, SparseMatrixFormat::CSR> owns its arrays, so
+ * wrapping data held elsewhere (a C caller, an interpreter) costs a copy
+ * of every entry.  CSRView reads the arrays in place: the entries are
+ * reduced into the field as they are applied, so that the same arrays
+ * serve any field, and rebinding the view copies nothing.
+ */
+
+#ifndef __LINBOX_blackbox_csr_view_H
+#define __LINBOX_blackbox_csr_view_H
+
+#include <cstddef>
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include "linbox/linbox-config.h"
+#include "linbox/util/debug.h"
+#include "linbox/blackbox/blackbox-interface.h"
+
+namespace LinBox
+{
+
+	/** @brief Read-only blackbox over CSR arrays owned by the caller.
+	 * \ingroup blackbox
+	 *
+	 * Row i has the entries val[t] in the columns colid[t], for
+	 * start[i] <= t < start[i+1].  A column may appear several times in
+	 * a row: its entries add up.  The arrays must outlive the view and
+	 * its rebinds, and are never written.  The values are of any type
+	 * the field can init() from.
+	 */
+	template<class _Field, class _Index = size_t, class _Value = typename _Field::Element>
+	class CSRView : public BlackboxInterface {
+	public:
+		typedef CSRView<_Field, _Index, _Value> Self_t;
+		typedef _Field                           Field;
+		typedef typename Field::Element        Element;
+		typedef _Index                           Index;
+		typedef _Value                           Value;
+
+		CSRView (const Field& F, size_t m, size_t n,
+			 const Index* start, const Index* colid, const Value* val) :
+			_field(&F), _m(m), _n(n), _start(start), _colid(colid), _val(val)
+		{}
+
+		//! the view over another field
+		template<class _Tp1>
+		CSRView (const CSRView<_Tp1, Index, Value>& A, const Field& F) :
+			_field(&F), _m(A.rowdim()), _n(A.coldim()),
+			_start(A.start()), _colid(A.colid()), _val(A.values())
+		{}
+
+		template<typename _Tp1>
+		struct rebind {
+			typedef CSRView<_Tp1, Index, Value> other;
+			// the view stores no field element
+			void operator() (other&, const Self_t&)
+			{}
+		};
+
+		/// y = A x
+		template<class OutVector, class InVector>
+		OutVector& apply (OutVector& y, const InVector& x) const
+		{
+			linbox_check(y.size() >= _m && x.size() >= _n);
+			Element a;
+			for (size_t i = 0; i < _m; ++i) {
+				Element& yi = y[i];
+				field().assign(yi, field().zero);
+				for (Index t = _start[i]; t < _start[i+1]; ++t)
+					field().axpyin(yi, field().init(a, _val[t]), x[_colid[t]]);
+			}
+			return y;
+		}
+
+		/// y = A^T x
+		template<class OutVector, class InVector>
+		OutVector& applyTranspose (OutVector& y, const InVector& x) const
+		{
+			linbox_check(y.size() >= _n && x.size() >= _m);
+			Element a;
+			for (size_t j = 0; j < _n; ++j)
+				field().assign(y[j], field().zero);
+			for (size_t i = 0; i < _m; ++i) {
+				if (field().isZero(x[i])) continue;
+				for (Index t = _start[i]; t < _start[i+1]; ++t)
+					field().axpyin(y[_colid[t]], field().init(a, _val[t]), x[i]);
+			}
+			return y;
+		}
+
+		/// A[i,j], zero if absent; the columns of a row need not be sorted
+		Element& getEntry (Element& x, size_t i, size_t j) const
+		{
+			Element a;
+			field().assign(x, field().zero);
+			for (Index t = _start[i]; t < _start[i+1]; ++t)
+				if ((size_t)_colid[t] == j)
+					field().addin(x, field().init(a, _val[t]));
+			return x;
+		}
+
+		/// copies the view into S, a matrix of the same dimensions, for an elimination;
+		/// the entries of a column repeated in a row are added up
+		template<class Matrix>
+		Matrix& copy (Matrix& S) const
+		{
+			std::vector<std::pair<size_t, Element> > row;
+			for (size_t i = 0; i < _m; ++i) {
+				row.clear();
+				for (Index t = _start[i]; t < _start[i+1]; ++t) {
+					row.push_back(std::make_pair((size_t)_colid[t], field().zero));
+					field().init(row.back().second, _val[t]);
+				}
+				std::stable_sort(row.begin(), row.end(), lessColumn);
+				for (size_t k = 0; k < row.size(); ) {
+					Element a = row[k].second;
+					size_t l = k + 1;
+					for (; l < row.size() && row[l].first == row[k].first; ++l)
+						field().addin(a, row[l].second);
+					if (! field().isZero(a))
+						S.setEntry(i, row[k].first, a);
+					k = l;
+				}
+			}
+			return S;
+		}
+
+		size_t rowdim () const { return _m; }
+		size_t coldim () const { return _n; }
+		size_t size () const { return (size_t)(_start[_m] - _start[0]); }
+		const Field& field () const { return *_field; }
+
+		const Index* start () const { return _start; }
+		const Index* colid () const { return _colid; }
+		const Value* values () const { return _val; }
+
+	protected:
+		static bool lessColumn (const std::pair<size_t, Element>& a, const std::pair<size_t, Element>& b)
+		{
+			return a.first < b.first;
+		}
+
+		const Field* _field;
+		size_t       _m, _n;
+		const Index* _start;
+		const Index* _colid;
+		const Value* _val;
+	};
+
+}
+
+#endif // __LINBOX_blackbox_csr_view_H
+
+// Local Variables:
+// mode: C++
+// tab-width: 4
+// indent-tabs-mode: nil
+// c-basic-offset: 4
+// End:
+// vim:sts=4:sw=4:ts=4:et:sr:cino=>s,f0,{0,g0,(0,\:0,t0,+0,=s
@@ -135,10 +135,25 @@ namespace LinBox
 		OutVector &applyTranspose (OutVector &y, const InVector &x) const { return apply (y, x); }
 
 		virtual Matrix& applyRight(Matrix& Y, const Matrix& X) const // Y = AX
-		{   MatrixDomain<Field> MD(field());
-		    return MD.mul(Y, *this, X);
+		{   return applyBlock(Y, X); }
+
+		/// Y = AX, row i of X scaled by d_i (native block apply, see BlockApplyTraits)
+		template <class OutBlock, class InBlock>
+		OutBlock& applyBlock(OutBlock& Y, const InBlock& X) const
+		{
+			linbox_check(Y.rowdim() == _n && X.rowdim() == _n);
+			linbox_check(Y.coldim() == X.coldim());
+			for (size_t i = 0; i < _n; ++i)
+				for (size_t j = 0; j < X.coldim(); ++j)
+					field().mul(Y.refEntry(i, j), _v[i], X.getEntry(i, j));
+			return Y;
 		}
 
+		/// Y = A^T X = AX
+		template <class OutBlock, class InBlock>
+		OutBlock& applyTransposeBlock(OutBlock& Y, const InBlock& X) const
+		{ return applyBlock(Y, X); }
+
 		Matrix& applyLeft(Matrix& Y, const Matrix& X) const // Y = AX
 		{   MatrixDomain<Field> MD(field());
 		    return MD.mul(Y, X, *this);
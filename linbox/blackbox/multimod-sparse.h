@@ -0,0 +1,322 @@
+/* linbox/blackbox/multimod-sparse.h
+ *
+ * ========LICENCE========
+ * This file is part of the library LinBox.
+ *
+ * LinBox is free software: you can redistribute it and/or modify
+ * it under the terms of the  GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ * ========LICENCE========
+ */
+
+/*! @file blackbox/multimod-sparse.h
+ * @ingroup blackbox
+ * @brief Integer sparse matrix applied modulo several primes at once.
+ *
+ * The CRA based blackbox algorithms over the integers rebind the matrix
+ * to each prime field and stream it from memory once per prime.  Here
+ * the entries are stored once as word size integers and each apply
+ * reduces them on the fly into k moduli, for k vectors interleaved
+ * entrywise, so that the matrix is read once for the k primes.
+ */
+
+#ifndef __LINBOX_blackbox_multimod_sparse_H
+#define __LINBOX_blackbox_multimod_sparse_H
+
+#include <vector>
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+
+#include "linbox/integer.h"
+#include "linbox/util/debug.h"
+#include "linbox/util/instrument.h"
+
+#ifndef LINBOX_MULTIMOD_SPMV_PRIMES
+//! default number of primes sharing one traversal of a MultiModSparseMatrix
+#define LINBOX_MULTIMOD_SPMV_PRIMES 4
+#endif
+
+namespace LinBox
+{
+
+	/** @brief Integer sparse matrix applied modulo several primes at once.
+	 * \ingroup blackbox
+	 *
+	 * A vector modulo k primes \f$p_0, \ldots, p_{k-1}\f$ is stored
+	 * interleaved: x[i*k+l] is the entry i modulo p_l, in \f$[0, p_l)\f$.
+	 * The primes must be below \f$2^{31}\f$, so that a product of
+	 * residues fits in 62 bits.  fits() is false when some entry of the
+	 * matrix does not fit in 62 bits; nothing else may then be called.
+	 */
+	class MultiModSparseMatrix {
+	public:
+		typedef std::vector<uint64_t> Vector;
+		typedef std::vector<uint64_t> Moduli;
+
+		MultiModSparseMatrix (size_t m = 0, size_t n = 0) :
+			_m (m), _n (n), _fits (true), _start (m + 1, 0)
+		{}
+
+		/// Copies the nonzero entries of an integer matrix with indexed iterators.
+		template <class Matrix>
+		MultiModSparseMatrix (const Matrix& A) :
+			_m (A.rowdim()), _n (A.coldim()), _fits (true)
+		{
+			const integer big = integer(1) << 62;
+			std::vector<std::vector<std::pair<size_t, int64_t> > > rows (_m);
+			integer x;
+			for (typename Matrix::ConstIndexedIterator it = A.IndexedBegin(); it != A.IndexedEnd(); ++it) {
+				A.field().convert (x, it.value());
+				if (x == 0) continue;
+				if (abs (x) >= big) { _fits = false; return; }
+				rows[it.rowIndex()].push_back (std::make_pair (it.colIndex(), (int64_t)x));
+			}
+			_start. assign (1, 0);
+			for (size_t i = 0; i < _m; ++i) {
+				std::sort (rows[i].begin(), rows[i].end());
+				for (size_t t = 0; t < rows[i].size(); ++t) {
+					_col. push_back (rows[i][t].first);
+					_val. push_back (rows[i][t].second);
+				}
+				_start. push_back (_col.size());
+			}
+		}
+
+		bool fits () const { return _fits; }
+		size_t rowdim () const { return _m; }
+		size_t coldim () const { return _n; }
+		size_t size () const { return _val.size(); }
+
+		//! the entries in CSR form, e.g. for a CSRView modulo one prime
+		const size_t* start () const { return _start.data(); }
+		const size_t* colid () const { return _col.data(); }
+		const int64_t* values () const { return _val.data(); }
+
+		//! bytes of the stored entries
+		size_t bytes () const
+		{
+			return _val.size() * (sizeof(int64_t) + sizeof(size_t)) + _start.size() * sizeof(size_t);
+		}
+
+		//! largest absolute value of an entry
+		uint64_t maxEntry () const
+		{
+			uint64_t a = 0;
+			for (size_t t = 0; t < _val.size(); ++t)
+				a = std::max (a, (uint64_t)std::abs (_val[t]));
+			return a;
+		}
+
+		/// y = A x modulo each of the primes P, x and y interleaved.
+		Vector& apply (Vector& y, const Vector& x, const Moduli& P) const
+		{
+			LINBOX_INSTRUMENT_SCOPE ("multimod apply");
+			const size_t k = P.size();
+			y. resize (_m * k);
+			std::vector<uint64_t> acc (k);
+			for (size_t i = 0; i < _m; ++i) {
+				std::fill (acc.begin(), acc.end(), 0);
+				for (size_t t = _start[i]; t < _start[i+1]; ++t) {
+					const uint64_t* xj = &x[_col[t] * k];
+					for (size_t l = 0; l < k; ++l)
+						addmul (acc[l], residue (_val[t], P[l]), xj[l], P[l]);
+				}
+				for (size_t l = 0; l < k; ++l)
+					y[i*k+l] = acc[l] % P[l];
+			}
+			return y;
+		}
+
+		/// y = A^T x modulo each of the primes P, x and y interleaved.
+		Vector& applyTranspose (Vector& y, const Vector& x, const Moduli& P) const
+		{
+			LINBOX_INSTRUMENT_SCOPE ("multimod apply");
+			const size_t k = P.size();
+			y. assign (_n * k, 0);
+			for (size_t i = 0; i < _m; ++i) {
+				const uint64_t* xi = &x[i * k];
+				for (size_t t = _start[i]; t < _start[i+1]; ++t) {
+					uint64_t* yj = &y[_col[t] * k];
+					for (size_t l = 0; l < k; ++l)
+						addmul (yj[l], residue (_val[t], P[l]), xi[l], P[l]);
+				}
+			}
+			for (size_t j = 0; j < y.size(); j += k)
+				for (size_t l = 0; l < k; ++l)
+					y[j+l] %= P[l];
+			return y;
+		}
+
+		/** Number of nonzero entries of \f$AA^T\f$, counted up to limit.
+		 * It costs \f$\sum_j c_j^2\f$, for \f$c_j\f$ the number of entries
+		 * of the column j.
+		 */
+		size_t productSize (size_t limit) const
+		{
+			std::vector<size_t> cstart, crow;
+			std::vector<int64_t> cval;
+			columns (cstart, crow, cval);
+			std::vector<size_t> mark (_m, _m);
+			size_t count = 0;
+			for (size_t i = 0; i < _m && count < limit; ++i)
+				for (size_t t = _start[i]; t < _start[i+1]; ++t)
+					for (size_t c = cstart[_col[t]]; c < cstart[_col[t] + 1]; ++c)
+						if (mark[crow[c]] != i) {
+							mark[crow[c]] = i;
+							++count;
+						}
+			return std::min (count, limit);
+		}
+
+		//! \f$\sum_j c_j^2\f$, the work of productSize() and of product()
+		double productWork () const
+		{
+			std::vector<size_t> c (_n, 0);
+			for (size_t t = 0; t < _col.size(); ++t)
+				++c[_col[t]];
+			double w = 0;
+			for (size_t j = 0; j < _n; ++j)
+				w += (double)c[j] * (double)c[j];
+			return w;
+		}
+
+		//! whether the entries of \f$AA^T\f$ fit in 62 bits
+		bool productFits () const
+		{
+			size_t rmax = 0;
+			for (size_t i = 0; i < _m; ++i)
+				rmax = std::max (rmax, _start[i+1] - _start[i]);
+			const double a = (double)maxEntry();
+			return a * a * (double)rmax < 4.e18;
+		}
+
+		/// B = A A^T, if productFits().
+		MultiModSparseMatrix& product (MultiModSparseMatrix& B) const
+		{
+			linbox_check (productFits());
+			std::vector<size_t> cstart, crow;
+			std::vector<int64_t> cval;
+			columns (cstart, crow, cval);
+
+			B._m = B._n = _m;
+			B._fits = true;
+			B._start. assign (1, 0);
+			B._col. clear();
+			B._val. clear();
+			std::vector<int64_t> acc (_m, 0);
+			std::vector<size_t> mark (_m, _m), touched;
+			for (size_t i = 0; i < _m; ++i) {
+				touched. clear();
+				for (size_t t = _start[i]; t < _start[i+1]; ++t)
+					for (size_t c = cstart[_col[t]]; c < cstart[_col[t] + 1]; ++c) {
+						const size_t r = crow[c];
+						if (mark[r] != i) {
+							mark[r] = i;
+							acc[r] = 0;
+							touched. push_back (r);
+						}
+						acc[r] += _val[t] * cval[c];
+					}
+				std::sort (touched.begin(), touched.end());
+				for (size_t c = 0; c < touched.size(); ++c)
+					if (acc[touched[c]] != 0) {
+						B._col. push_back (touched[c]);
+						B._val. push_back (acc[touched[c]]);
+					}
+				B._start. push_back (B._col.size());
+			}
+			return B;
+		}
+
+		/// Bound on the eigenvalues of \f$AA^T\f$ by the ovals of Cassini, as Valence::cassini.
+		integer& cassini (integer& r) const
+		{
+			std::vector<integer> d (_m, integer(0)), w (_n, integer(0));
+			for (size_t i = 0; i < _m; ++i)
+				for (size_t t = _start[i]; t < _start[i+1]; ++t) {
+					const integer a = _val[t];
+					d[i] += a * a;
+					w[_col[t]] += abs (a);
+				}
+			integer diag = 0, radius = 0, radius1 = 0;
+			for (size_t i = 0; i < _m; ++i) {
+				if (d[i] > diag) diag = d[i];
+				integer local = 0;
+				for (size_t t = _start[i]; t < _start[i+1]; ++t)
+					local += abs (integer(_val[t])) * w[_col[t]];
+				local -= d[i];
+				if (local > radius1) {
+					if (local > radius) {
+						radius1 = radius;
+						radius = local;
+					}
+					else
+						radius1 = local;
+				}
+			}
+			return r = diag + (integer)sqrt (radius * radius1);
+		}
+
+		//! a modulo p, in [0, p)
+		static uint64_t residue (int64_t a, uint64_t p)
+		{
+			if (a >= 0)
+				return ((uint64_t)a < p) ? (uint64_t)a : (uint64_t)a % p;
+			const uint64_t r = (uint64_t)(-a) % p;
+			return r ? p - r : 0;
+		}
+
+		//! acc += a b, reduced when it exceeds 63 bits; a, b < p < 2^31
+		static void addmul (uint64_t& acc, uint64_t a, uint64_t b, uint64_t p)
+		{
+			acc += a * b;
+			if (acc >> 63) acc %= p;
+		}
+
+	protected:
+		// the entries by columns
+		void columns (std::vector<size_t>& cstart, std::vector<size_t>& crow, std::vector<int64_t>& cval) const
+		{
+			cstart. assign (_n + 1, 0);
+			for (size_t t = 0; t < _col.size(); ++t)
+				++cstart[_col[t] + 1];
+			for (size_t j = 0; j < _n; ++j)
+				cstart[j+1] += cstart[j];
+			crow. resize (_val.size());
+			cval. resize (_val.size());
+			std::vector<size_t> pos (cstart.begin(), cstart.end() - 1);
+			for (size_t i = 0; i < _m; ++i)
+				for (size_t t = _start[i]; t < _start[i+1]; ++t) {
+					crow[pos[_col[t]]] = i;
+					cval[pos[_col[t]]++] = _val[t];
+				}
+		}
+
+		size_t _m, _n;
+		bool _fits;
+		std::vector<size_t> _start, _col;
+		std::vector<int64_t> _val;
+	};
+
+}
+
+#endif // __LINBOX_blackbox_multimod_sparse_H
+
+// Local Variables:
+// mode: C++
+// tab-width: 4
+// indent-tabs-mode: nil
+// c-basic-offset: 4
+// End:
+// vim:sts=4:sw=4:ts=4:et:sr:cino=>s,f0,{0,g0,(0,\:0,t0,+0,=s
@@ -148,6 +148,13 @@ public:
 		return lhs;
 	}
 
+	//! native block apply for BlockApplyTraits, lhs = A rhs
+	template <class Mat1, class Mat2>
+	Mat1& applyBlock(Mat1& lhs,const Mat2& rhs) const
+	{
+		return applyLeft(lhs,rhs);
+	}
+
 	template<class Mat1, class Mat2>
 	void applyLeft(int i0, int j0, int r, Mat1& lhs,Mat2& rhs, bool flip, int numThreads) const
 	{
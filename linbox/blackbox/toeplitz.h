@@ -235,6 +235,19 @@ namespace LinBox
 		template<class OutVector, class InVector>
 		OutVector& applyTranspose( OutVector &v_out, const InVector& v_in) const;
 
+		/** Block apply Y = A X with a single polynomial product.
+		 * The columns of X are packed into one polynomial (Kronecker
+		 * substitution, with a stride large enough for the products not to
+		 * overlap), so an FFT based ring does one large product instead of
+		 * one per column.  Native block apply of BlockApplyTraits.
+		 */
+		template<class OutBlock, class InBlock>
+		OutBlock& applyBlock( OutBlock &Y, const InBlock& X) const;
+
+		//! Block apply Y = A^T X, same packing as applyBlock.
+		template<class OutBlock, class InBlock>
+		OutBlock& applyTransposeBlock( OutBlock &Y, const InBlock& X) const;
+
 		// Get the determinant of the matrix
 		Element& det( Element& res ) const;
 
@@ -403,6 +403,73 @@ namespace LinBox
 
 	}
 
+
+	/*-----------------------------------------------------------------
+	 *    Apply the matrix to a block of vectors
+	 *----------------------------------------------------------------*/
+	template <class _PRing>
+	template<class OutBlock, class InBlock>
+	OutBlock& Toeplitz<typename _PRing::CoeffField,_PRing>::applyBlock( OutBlock &Y,
+									  const InBlock& X) const
+	{
+		linbox_check((Y.rowdim() == this->rowdim()) &&
+			     (X.rowdim() == this->coldim()) &&
+			     (Y.coldim() == X.coldim()));
+
+		const size_t N = this->rowdim(), M = this->coldim(), k = X.coldim();
+		if (k == 0) return Y;
+
+		// deg(pdata) <= N+M-2 and deg(column) <= M-1: the product of one
+		// column has at most N+2M-2 coefficients
+		const size_t s = N+2*M-2;
+		std::vector<Element> packed(s*(k-1)+M, this->field().zero);
+		for( size_t j = 0; j < k; ++j )
+			for( size_t i = 0; i < M; ++i )
+				this->field().assign(packed[j*s+i], X.getEntry(i,j));
+
+		Poly pOut, pIn;
+		this->P.init( pIn, packed );
+		this->P.mul(pOut, pIn, this->pdata);
+
+		for( size_t j = 0; j < k; ++j )
+			for( size_t i = 0; i < N; ++i )
+				this->P.getCoeff(Y.refEntry(i,j), pOut, j*s+N-1+i);
+
+		return Y;
+	}
+
+	/*-----------------------------------------------------------------
+	 *    Apply the transposed matrix to a block of vectors
+	 *----------------------------------------------------------------*/
+	template <class _PRing>
+	template<class OutBlock, class InBlock>
+	OutBlock& Toeplitz<typename _PRing::CoeffField,_PRing>::applyTransposeBlock( OutBlock &Y,
+										   const InBlock& X) const
+	{
+		linbox_check((Y.rowdim() == this->coldim()) &&
+			     (X.rowdim() == this->rowdim()) &&
+			     (Y.coldim() == X.coldim()));
+
+		const size_t N = this->coldim(), M = this->rowdim(), k = X.coldim();
+		if (k == 0) return Y;
+
+		const size_t s = N+2*M-2;
+		std::vector<Element> packed(s*(k-1)+M, this->field().zero);
+		for( size_t j = 0; j < k; ++j )
+			for( size_t i = 0; i < M; ++i )
+				this->field().assign(packed[j*s+i], X.getEntry(i,j));
+
+		Poly pOut, pIn;
+		this->P.init( pIn, packed );
+		this->P.mul(pOut, pIn, this->rpdata);
+
+		for( size_t j = 0; j < k; ++j )
+			for( size_t i = 0; i < N; ++i )
+				this->P.getCoeff(Y.refEntry(i,j), pOut, j*s+N-1+i);
+
+		return Y;
+	}
+
 } // namespace LinBox
 
 #endif //__LINBOX_bb_toeplitz_INL
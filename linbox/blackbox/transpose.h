@@ -27,6 +27,7 @@
 
 #include "linbox/util/error.h"
 #include "linbox/blackbox/blackbox-interface.h"
+#include "linbox/blackbox/block-apply.h"
 
 namespace LinBox
 {
@@ -138,6 +139,22 @@ namespace LinBox
 			return y;
 		}
 
+		//! Block product \f$Y \gets A^T X\f$, see BlockApplyTraits.
+		template <class OutBlock, class InBlock>
+		OutBlock &applyBlock (OutBlock &Y, const InBlock &X) const
+		{
+			if (_A_ptr != 0) BlockApplyTraits<Blackbox>::applyTranspose (Y, *_A_ptr, X);
+			return Y;
+		}
+
+		//! Block product \f$Y \gets A X\f$, see BlockApplyTraits.
+		template <class OutBlock, class InBlock>
+		OutBlock &applyTransposeBlock (OutBlock &Y, const InBlock &X) const
+		{
+			if (_A_ptr != 0) BlockApplyTraits<Blackbox>::apply (Y, *_A_ptr, X);
+			return Y;
+		}
+
 		/** Retreive row dimensions of BlackBox matrix.
 		 * This may be needed for applying preconditioners.
 		 * Required by abstract base class.
@@ -301,6 +318,20 @@ namespace LinBox
 			return _A_data.apply (y, x);
 		}
 
+		//! Block product \f$Y \gets A^T X\f$, see BlockApplyTraits.
+		template <class OutBlock, class InBlock>
+		OutBlock &applyBlock (OutBlock &Y, const InBlock &X) const
+		{
+			return BlockApplyTraits<Blackbox>::applyTranspose (Y, _A_data, X);
+		}
+
+		//! Block product \f$Y \gets A X\f$, see BlockApplyTraits.
+		template <class OutBlock, class InBlock>
+		OutBlock &applyTransposeBlock (OutBlock &Y, const InBlock &X) const
+		{
+			return BlockApplyTraits<Blackbox>::apply (Y, _A_data, X);
+		}
+
 		/** Retreive row dimensions of BlackBox matrix.
 		 * This may be needed for applying preconditioners.
 		 * Required by abstract base class.
@@ -35,6 +35,7 @@
 #include "linbox/vector/stream.h"
 #include "linbox/matrix/sparse-matrix.h"
 #include "linbox/vector/light_container.h"
+#include "linbox/matrix/densematrix/m4ri-matrix.h"
 
 namespace LinBox
 {
@@ -112,6 +113,17 @@ namespace LinBox
 		template<class OutVector, class InVector>
 		OutVector& applyTranspose(OutVector& y, const InVector& x) const; // y = A^T x
 
+		/** Y = A X for packed blocks of vectors: each word of a row of X
+		 * holds one entry of 64 vectors, so a row of A costs one XOR per
+		 * nonzero entry and per word.  Used by BlockApplyTraits, and by
+		 * BlockLanczosKernel (through PackedGF2Apply) on the packed
+		 * \f$V\f$ of each GF(2) block Lanczos iteration.
+		 */
+		M4RIMatrix& applyBlock(M4RIMatrix& Y, const M4RIMatrix& X) const;
+
+		//! Y = A^T X for packed blocks of vectors
+		M4RIMatrix& applyTransposeBlock(M4RIMatrix& Y, const M4RIMatrix& X) const;
+
 		/** Read the matrix from a stream in ANY format
 		 *  entries are read as "long int" and set to 1 if they are odd,
 		 *  0 otherwise
@@ -93,6 +93,65 @@ namespace LinBox
 	}
 
 
+	inline M4RIMatrix & ZeroOne<GF2>::applyBlock(M4RIMatrix & Y, const M4RIMatrix & X) const
+	{
+		typedef M4RIMatrix::Word Word;
+		linbox_check(X.rowdim() == _coldim && Y.rowdim() == _rowdim && Y.coldim() == X.coldim());
+		const size_t w = X.rowstride();
+		const long m = (long)_rowdim;
+		if (w == 1) {
+			// 64 vectors: one word per row, kept in a register
+#ifdef __LINBOX_USE_OPENMP
+#pragma omp parallel for schedule(dynamic,256)
+#endif
+			for (long i = 0; i < m; ++i) {
+				const Row_t & row = this->operator[]((size_t)i);
+				Word acc = 0;
+				for (Row_t::const_iterator loc = row.begin(); loc != row.end(); ++loc)
+					acc ^= *X.row(*loc);
+				*Y.row((size_t)i) = acc;
+			}
+			return Y;
+		}
+#ifdef __LINBOX_USE_OPENMP
+#pragma omp parallel for schedule(dynamic,256)
+#endif
+		for (long i = 0; i < m; ++i) {
+			const Row_t & row = this->operator[]((size_t)i);
+			Word * y = Y.row((size_t)i);
+			std::fill(y, y+w, Word(0));
+			for (Row_t::const_iterator loc = row.begin(); loc != row.end(); ++loc) {
+				const Word * x = X.row(*loc);
+				for (size_t k = 0; k < w; ++k)
+					y[k] ^= x[k];
+			}
+		}
+		return Y;
+	}
+
+	inline M4RIMatrix & ZeroOne<GF2>::applyTransposeBlock(M4RIMatrix & Y, const M4RIMatrix & X) const
+	{
+		typedef M4RIMatrix::Word Word;
+		linbox_check(X.rowdim() == _rowdim && Y.rowdim() == _coldim && Y.coldim() == X.coldim());
+		const size_t w = X.rowstride();
+		Y.zero();
+		// scatter of the rows of X: rows of A may share columns, so the
+		// threads split the words of the rows instead of the rows of A
+#ifdef __LINBOX_USE_OPENMP
+#pragma omp parallel for schedule(static) if (w > 1)
+#endif
+		for (long k = 0; k < (long)w; ++k) {
+			for (size_t i = 0; i < _rowdim; ++i) {
+				const Word x = X.row(i)[k];
+				if (!x) continue;
+				const Row_t & row = this->operator[](i);
+				for (Row_t::const_iterator loc = row.begin(); loc != row.end(); ++loc)
+					Y.row(*loc)[k] ^= x;
+			}
+		}
+		return Y;
+	}
+
 	inline const ZeroOne<GF2>::Element& ZeroOne<GF2>::setEntry(size_t i, size_t j, const Element& v) {
 		Row_t& rowi = this->operator[](i);
 		Row_t::iterator there = std::lower_bound(rowi.begin(), rowi.end(), j);
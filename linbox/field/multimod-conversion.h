@@ -0,0 +1,276 @@
+/* linbox/field/multimod-conversion.h
+ *
+ * ========LICENCE========
+ * This file is part of the library LinBox.
+ *
+ * LinBox is free software: you can redistribute it and/or modify
+ * it under the terms of the  GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ * ========LICENCE========
+ */
+
+/*! @file field/multimod-conversion.h
+ * @ingroup field
+ * @brief Integer matrices to and from their residues modulo the primes of a MultiModDouble.
+ *
+ * Both directions are matrix products over the doubles.  An integer is
+ * split in 16 bits digits \f$a = \sum_j a_j 2^{16j}\f$, so that the
+ * residues of a whole matrix are \f$[2^{16j} \bmod p_i]_{i,j}\f$ times
+ * the matrix of digits, followed by one reduction per residue.
+ * Conversely, with \f$y_i = r_i M_i^{-1} \bmod p_i\f$ and the digits
+ * \f$c_{ij}\f$ of \f$M_i = M/p_i\f$, \f$\sum_i y_i M_i = \sum_j 2^{16j}
+ * \sum_i y_i c_{ij}\f$: one product, then a carry propagation and one
+ * reduction modulo \f$M\f$ per entry.
+ */
+
+#ifndef __LINBOX_field_multimod_conversion_H
+#define __LINBOX_field_multimod_conversion_H
+
+#include <vector>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+#include <gmp.h>
+#include <givaro/zring.h>
+#include <fflas-ffpack/fflas/fflas.h>
+
+#include "linbox/linbox-config.h"
+#include "linbox/util/debug.h"
+#include "linbox/integer.h"
+#include "linbox/field/multimod-field.h"
+
+namespace LinBox
+{
+
+	/** @brief Residue number system conversions of integer matrices.
+	 * \ingroup field
+	 *
+	 * The residues of an \f$m \times n\f$ matrix are given by one pointer
+	 * per prime of the MultiModDouble, each to an \f$m \times n\f$ matrix
+	 * of stride \c ldr with entries in \f$[0,p_i)\f$, as for
+	 * Givaro::Modular<double>.  The reconstruction is symmetric, in
+	 * \f$(-M/2, M/2]\f$.
+	 */
+	class MultiModConversion {
+	public:
+		typedef Givaro::ZRing<double> DoubleDomain;
+
+		static const size_t digitBits = 16;
+
+		MultiModConversion (const MultiModDouble &F) :
+			_field(F), _size(F.size()), _primes(F.size())
+		{
+			double pmax = 1;
+			for (size_t i = 0; i < _size; ++i) {
+				_primes[i] = (double) F.getModulo(i);
+				pmax = std::max(pmax, _primes[i]);
+			}
+			// a product of _group digits by residues is exact (2^52: one bit of slack)
+			_group = std::max((size_t)1, (size_t)(std::ldexp(1., 52) / (std::ldexp(1., digitBits) * pmax)));
+
+			_M = F.getCRTmodulo();
+			_halfM = _M / 2;
+			_kM = (mpz_sizeinbase(_M.get_mpz_const(), 2) + digitBits - 1) / digitBits;
+			_crt.assign(_size * _kM, 0.);
+			for (size_t i = 0; i < _size; ++i)
+				digits(&_crt[i * _kM], 1, _kM, F.getCRTconstant(i));
+		}
+
+		const MultiModDouble &field () const { return _field; }
+		size_t size () const { return _size; }
+
+		/** R[i] = A mod p_i, for each prime p_i.
+		 * @param m, n dimensions of A
+		 * @param R    residues: _size pointers to m x n matrices of stride ldr
+		 * @param A    integer matrix of stride lda
+		 */
+		void reduce (size_t m, size_t n, double * const *R, size_t ldr,
+			     const Integer *A, size_t lda) const
+		{
+			if (!m || !n) return;
+			size_t limbs = 0;
+			for (size_t i = 0; i < m; ++i)
+				for (size_t j = 0; j < n; ++j)
+					limbs = std::max(limbs, (size_t) mpz_size(A[i*lda+j].get_mpz_const()));
+			const size_t k = std::max((size_t)1, limbs * (GMP_NUMB_BITS / digitBits));
+
+			// T[i][j] = 2^(16j) mod p_i
+			std::vector<double> T(_size * k);
+			for (size_t i = 0; i < _size; ++i) {
+				double t = 1.;
+				for (size_t j = 0; j < k; ++j) {
+					T[i*k+j] = t;
+					t = std::fmod(t * std::ldexp(1., digitBits), _primes[i]);
+				}
+			}
+
+			DoubleDomain D;
+			const size_t mb = rowBlock(m, n, std::max(k, _size));
+			for (size_t r0 = 0; r0 < m; r0 += mb) {
+				const size_t rows = std::min(mb, m - r0);
+				const size_t e = rows * n;
+				std::vector<double> K(k * e, 0.), Rt(_size * e);
+
+#ifdef __LINBOX_USE_OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+				for (long x = 0; x < (long)e; ++x) {
+					const size_t ix = (size_t)x;
+					digits(&K[ix], e, k, A[(r0 + ix / n) * lda + ix % n]);
+				}
+
+				for (size_t g0 = 0; g0 < k; g0 += _group) {
+					const size_t kg = std::min(_group, k - g0);
+					if (g0)
+						reduceRows(Rt, e);
+					FFLAS::fgemm(D, FFLAS::FflasNoTrans, FFLAS::FflasNoTrans,
+						     _size, e, kg, 1., &T[g0], k, &K[g0 * e], e,
+						     (g0 ? 1. : 0.), &Rt[0], e);
+				}
+
+#ifdef __LINBOX_USE_OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+				for (long li = 0; li < (long)_size; ++li) {
+					const size_t i = (size_t)li;
+					const double p = _primes[i];
+					for (size_t x = 0; x < e; ++x) {
+						const size_t a = (r0 + x / n) * lda + x % n;
+						double v = std::fmod(Rt[i*e+x], p);
+						if (v != 0. && mpz_sgn(A[a].get_mpz_const()) < 0)
+							v = p - v;
+						R[i][(r0 + x / n) * ldr + x % n] = v;
+					}
+				}
+			}
+		}
+
+		/** A = the integer matrix congruent to R[i] modulo each p_i,
+		 * symmetric modulo the product of the primes.
+		 */
+		void reconstruct (size_t m, size_t n, Integer *A, size_t lda,
+				  const double * const *R, size_t ldr) const
+		{
+			if (!m || !n) return;
+			linbox_check((_size + _group - 1) / _group < ((size_t)1 << 11));
+
+			DoubleDomain D;
+			const size_t mb = rowBlock(m, n, std::max(_kM, _size));
+			for (size_t r0 = 0; r0 < m; r0 += mb) {
+				const size_t rows = std::min(mb, m - r0);
+				const size_t e = rows * n;
+				std::vector<double> Y(_size * e), P(_kM * e);
+				std::vector<uint64_t> Z(_kM * e, 0);
+
+				// y_i = r_i M_i^{-1} mod p_i
+#ifdef __LINBOX_USE_OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+				for (long li = 0; li < (long)_size; ++li) {
+					const size_t i = (size_t)li;
+					const Givaro::Modular<double> &F = _field.getBase(i);
+					const double inv = _field.getCRTinverse(i);
+					for (size_t x = 0; x < e; ++x)
+						F.mul(Y[i*e+x], R[i][(r0 + x / n) * ldr + x % n], inv);
+				}
+
+				for (size_t g0 = 0; g0 < _size; g0 += _group) {
+					const size_t sg = std::min(_group, _size - g0);
+					FFLAS::fgemm(D, FFLAS::FflasTrans, FFLAS::FflasNoTrans,
+						     _kM, e, sg, 1., &_crt[g0 * _kM], _kM, &Y[g0 * e], e,
+						     0., &P[0], e);
+					for (size_t x = 0; x < _kM * e; ++x)
+						Z[x] += (uint64_t) P[x];
+				}
+
+#ifdef __LINBOX_USE_OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+				for (long x = 0; x < (long)e; ++x) {
+					const size_t ix = (size_t)x;
+					Integer &a = A[(r0 + ix / n) * lda + ix % n];
+					carry(a, &Z[ix], e);
+					mpz_fdiv_r(a.get_mpz(), a.get_mpz_const(), _M.get_mpz_const());
+					if (mpz_cmp(a.get_mpz_const(), _halfM.get_mpz_const()) > 0)
+						mpz_sub(a.get_mpz(), a.get_mpz_const(), _M.get_mpz_const());
+				}
+			}
+		}
+
+	protected:
+
+		// the k lowest 16 bits digits of |a|, every inc doubles, into zero initialised d
+		static void digits (double *d, size_t inc, size_t k, const Integer &a)
+		{
+			mpz_srcptr z = a.get_mpz_const();
+			const size_t l = mpz_size(z);
+			const size_t per = GMP_NUMB_BITS / digitBits;
+			for (size_t w = 0; w < l; ++w) {
+				const mp_limb_t b = mpz_getlimbn(z, (mp_size_t)w);
+				for (size_t c = 0; c < per && w * per + c < k; ++c)
+					d[(w * per + c) * inc] = (double) ((b >> (c * digitBits)) & 0xFFFF);
+			}
+		}
+
+		// a = sum_j z[j*inc] 2^(16j)
+		void carry (Integer &a, const uint64_t *z, size_t inc) const
+		{
+			std::vector<uint16_t> d;
+			d.reserve(_kM + 4);
+			uint64_t acc = 0;
+			for (size_t j = 0; j < _kM; ++j) {
+				acc += z[j * inc];
+				d.push_back((uint16_t)(acc & 0xFFFF));
+				acc >>= digitBits;
+			}
+			for (; acc; acc >>= digitBits)
+				d.push_back((uint16_t)(acc & 0xFFFF));
+			mpz_import(a.get_mpz(), d.size(), -1, sizeof(uint16_t), 0, 0, d.data());
+		}
+
+		void reduceRows (std::vector<double> &Rt, size_t e) const
+		{
+			for (size_t i = 0; i < _size; ++i)
+				for (size_t x = 0; x < e; ++x)
+					Rt[i*e+x] = std::fmod(Rt[i*e+x], _primes[i]);
+		}
+
+		// rows per block so that the work matrices stay around 2^24 doubles
+		static size_t rowBlock (size_t m, size_t n, size_t depth)
+		{
+			const size_t budget = (size_t)1 << 24;
+			return std::min(m, std::max((size_t)1, budget / (depth * n)));
+		}
+
+		MultiModDouble          _field;
+		size_t                   _size;
+		std::vector<double>    _primes;
+		size_t                  _group; // digits (or primes) per exact product
+		integer                     _M;
+		integer                 _halfM;
+		size_t                     _kM; // digits of the M_i
+		std::vector<double>       _crt; // row i: digits of M_i
+	};
+
+}
+
+#endif // __LINBOX_field_multimod_conversion_H
+
+// Local Variables:
+// mode: C++
+// tab-width: 4
+// indent-tabs-mode: nil
+// c-basic-offset: 4
+// End:
+// vim:sts=4:sw=4:ts=4:et:sr:cino=>s,f0,{0,g0,(0,\:0,t0,+0,=s
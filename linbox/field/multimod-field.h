@@ -153,6 +153,14 @@ namespace LinBox
 		const integer& getCRTmodulo() const
 		{return _crt_modulo;}
 
+		//! \f$M_i = M / p_i\f$
+		const integer& getCRTconstant(size_t i) const
+		{return _crt_constant[i];}
+
+		//! \f$M_i^{-1} \bmod p_i\f$
+		double getCRTinverse(size_t i) const
+		{return _crt_inverse[i];}
+
 		integer &cardinality (integer &c) const
 		{
 			c=1;
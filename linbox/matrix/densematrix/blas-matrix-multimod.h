@@ -26,33 +26,38 @@
 
 /*! @file matrix/blas-matrix-multimod.h
  * @ingroup matrix
- * A \c BlasMatrix<\c _Field > represents a matrix as an array of
- * <code>_Field::Element</code>s. It also has the BlasBlackbox interface.
- *
- */
-
-/*! @file matrix/blas-matrix-multimod.h
  * @brief specialisation for mutlimod field.
+ *
+ * A \c BlasMatrix<MultiModDouble> stores its residues prime by prime:
+ * the \f$m \times n\f$ matrix modulo \f$p_i\f$ is the contiguous block
+ * \c getPointer(i) of stride \c getStride(), in \f$[0,p_i)\f$ as for
+ * Givaro::Modular<double>.  BlasMatrixDomain<MultiModDouble> works on
+ * whole blocks: one fgemm per prime for the products, one vectorised
+ * FFLAS level 1 call per prime for the elementwise operations, the
+ * primes being spread over the threads.
  */
 
 #ifndef __LINBOX_blas_matrix_multimod_H
 #define __LINBOX_blas_matrix_multimod_H
 
-#include "linbox/util/debug.h"
+#include <vector>
+#include <iostream>
 
-// #include "linbox/vector/subiterator.h"
-// #include "linbox/vector/subvector.h"
+#include "linbox/util/debug.h"
 
 #include "linbox/matrix/matrix-category.h"
 #include "linbox/linbox-tags.h"
 #include "linbox/matrix/dense-matrix.h"
+#include "linbox/matrix/matrixdomain/blas-matrix-domain.h"
+#include "linbox/field/multimod-field.h"
+#include "linbox/field/multimod-conversion.h"
 
-THIS_CODE_MAY_NOT_COMPILE_AND_IS_NOT_TESTED
+#include <fflas-ffpack/fflas/fflas.h>
 
 namespace LinBox
 { /*  Specialisation of BlasMatrix for MultiModDouble field */
 
-	/*! No Doc.
+	/*! Dense matrix over a MultiModDouble, structure of arrays.
 	*/
 	template<>
 	class BlasMatrix<MultiModDouble> {
@@ -62,151 +67,336 @@ namespace LinBox
 		typedef MultiModDouble         Field;
 		typedef std::vector<double>  Element;
 		typedef BlasMatrix<MultiModDouble> Self_t;
+		typedef Givaro::Modular<double> Residue; //!< field of one prime
 
 	protected:
 
 		MultiModDouble                 _field;
-		const std::vector<MatrixDomain<Givaro::Modular<double> > >   _MD;
 		size_t                  _row,_col;
-		Element                _One,_Zero; //! @warning used ?
-		std::vector<BlasMatrix<Givaro::Modular<double> >* > _rep;
-		mutable std::vector<double>       _entry;
-	public:
-
+		std::vector<double>            _rep; // prime i: [i*_row*_col, (i+1)*_row*_col)
+		mutable Element              _entry;
 
-		//BlasMatrix () {}
+	public:
 
 		BlasMatrix (const MultiModDouble& F) :
-			_field(F) , _rep(F.size()), _entry(F.size())
+			_field(F), _row(0), _col(0), _entry(F.size())
 		{}
 
-		BlasMatrix (const Field& F, size_t m, size_t n, bool alloc=true) :
-			_field(F), _row(m) , _col(n) , _rep(F.size()),  _entry(F.size())
+		BlasMatrix (const Field& F, size_t m, size_t n) :
+			_field(F), _row(m) , _col(n) , _rep(F.size()*m*n, 0.),  _entry(F.size())
+		{}
+
+		//! residues of the integer matrix A
+		template<class _Rep>
+		BlasMatrix (const Field& F, const BlasMatrix<Givaro::ZRing<Integer>,_Rep>& A) :
+			_field(F), _row(A.rowdim()) , _col(A.coldim()) , _rep(F.size()*A.rowdim()*A.coldim()),  _entry(F.size())
 		{
-			for (size_t i=0;i<_rep.size();++i)
-				_rep[i] =  new BlasMatrix<Givaro::Modular<double> > (F.getBase(i), m, n);
+			std::vector<double*> R(size());
+			for (size_t i=0;i<size();++i)
+				R[i] = getPointer(i);
+			MultiModConversion(F).reduce(_row, _col, R.data(), _col, A.getPointer(), A.getStride());
 		}
 
-		BlasMatrix (const BlasMatrix<MultiModDouble> & A):
-			_field(A._field),_row(A._row), _col(A._col),
-			_rep(A._rep.size()), _entry(A._entry)
+		void resize (size_t m, size_t n)
 		{
-
-			for (size_t i=0;i<_rep.size();++i)
-				_rep[i]= new  BlasMatrix<Givaro::Modular<double> > (const_cast<BlasMatrix<Givaro::Modular<double> >& >( *A._rep[i]));
+			_row = m;
+			_col = n;
+			_rep.assign(size()*m*n, 0.);
 		}
 
+		//! number of primes
+		size_t size() const {return _field.size();}
 
-		const BlasMatrix<MultiModDouble>& operator=(const BlasMatrix<MultiModDouble> & A)
+		size_t rowdim() const {return _row;}
+
+		size_t coldim() const {return _col;}
+
+		const Field &field() const  {return _field;}
+
+		//! the matrix modulo the i-th prime
+		double* getPointer(size_t i) {return _rep.data() + i*_row*_col;}
+		const double* getPointer(size_t i) const {return _rep.data() + i*_row*_col;}
+		size_t getStride() const {return _col;}
+
+		//! copy of the matrix modulo the i-th prime
+		BlasMatrix<Residue>& getMatrix(BlasMatrix<Residue>& A, size_t i) const
 		{
-			_field   = A._field;
-			_row = A._row;
-			_col = A._col;
-			_rep = std::vector<BlasMatrix<Givaro::Modular<double> >* >(A._rep.size());
-			_entry = A._entry;
-			for (size_t i=0;i<_rep.size();++i)
-				_rep[i]= new  BlasMatrix<Givaro::Modular<double> > (const_cast<BlasMatrix<Givaro::Modular<double> >& >( *A._rep[i]));
-			return *this;
+			linbox_check(A.rowdim() == _row && A.coldim() == _col);
+			FFLAS::fassign(_field.getBase(i), _row, _col, getPointer(i), _col, A.getPointer(), A.getStride());
+			return A;
 		}
 
+		//! the integer matrix of the residues, symmetric modulo the product of the primes
+		template<class _Rep>
+		BlasMatrix<Givaro::ZRing<Integer>,_Rep>& convert (BlasMatrix<Givaro::ZRing<Integer>,_Rep>& A) const
+		{
+			linbox_check(A.rowdim() == _row && A.coldim() == _col);
+			std::vector<const double*> R(size());
+			for (size_t i=0;i<size();++i)
+				R[i] = getPointer(i);
+			MultiModConversion(_field).reconstruct(_row, _col, A.getPointer(), A.getStride(), R.data(), _col);
+			return A;
+		}
 
-		~BlasMatrix() {for (size_t i=0; i< _rep.size();++i) {delete _rep[i];} }
-
+		//! y = A x, with x and y vectors of Element
 		template <class Vector1, class Vector2>
 		Vector1&  apply (Vector1& y, const Vector2& x) const
 		{
-			for (size_t i=0;i<_rep.size();++i) {
-				std::vector<double> x_tmp(x.size()), y_tmp(y.size());
-				for (size_t j=0;j<x.size();++j)
-					x_tmp[j]= x[j][i];
-
-				_rep[i]->apply(y_tmp, x_tmp);
+			return _apply(y, x, FFLAS::FflasNoTrans);
+		}
 
-				for (size_t j=0;j<y.size();++j){
-					y[j][i]=y_tmp[j];
+		//! y = A^T x, with x and y vectors of Element
+		template <class Vector1, class Vector2>
+		Vector1&  applyTranspose (Vector1& y, const Vector2& x) const
+		{
+			return _apply(y, x, FFLAS::FflasTrans);
+		}
 
-				}
+		std::ostream& write(std::ostream& os) const
+		{
+			for (size_t i=0;i<size();++i) {
+				BlasMatrix<Residue> A(_field.getBase(i), _row, _col);
+				getMatrix(A, i).write(os);
 			}
+			return os;
+		}
 
-			return y;
+
+		const Element& setEntry (size_t i, size_t j, const Element &a_ij)
+		{
+			for (size_t k=0; k< size();++k)
+				getPointer(k)[i*_col+j] = a_ij[k];
+			return a_ij;
 		}
 
-		template <class Vector1, class Vector2>
-		Vector1&  applyTranspose (Vector1& y, const Vector2& x) const
+
+		const Element& getEntry (size_t i, size_t j) const
 		{
-			for (size_t i=0;i<_rep.size();++i) {
-				std::vector<double> x_tmp(x.size()), y_tmp(y.size());
-				for (size_t j=0;j<x.size();++j)
-					x_tmp[i]= x[j][i];
+			for (size_t k=0; k< size();++k)
+				_entry[k] = getPointer(k)[i*_col+j];
+			return _entry;
+		}
 
-				_rep[i]->applyTranspose(y_tmp, x_tmp);
+	protected:
 
-				for (size_t j=0;j<y.size();++j)
-					y[j][i]=y_tmp[i];
+		template <class Vector1, class Vector2>
+		Vector1& _apply (Vector1& y, const Vector2& x, FFLAS::FFLAS_TRANSPOSE t) const
+		{
+			const size_t nx = (t == FFLAS::FflasNoTrans) ? _col : _row;
+			const size_t ny = (t == FFLAS::FflasNoTrans) ? _row : _col;
+			linbox_check(x.size() == nx && y.size() == ny);
+			std::vector<double> X(size()*nx), Y(size()*ny);
+			for (size_t j=0;j<nx;++j)
+				for (size_t k=0;k<size();++k)
+					X[k*nx+j] = x[j][k];
+
+#ifdef __LINBOX_USE_OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+			for (long lk=0;lk<(long)size();++lk) {
+				const size_t k = (size_t)lk;
+				const Residue &F = _field.getBase(k);
+				FFLAS::fgemv(F, t, _row, _col, F.one, getPointer(k), _col,
+					     &X[k*nx], 1, F.zero, &Y[k*ny], 1);
 			}
 
+			for (size_t j=0;j<ny;++j) {
+				y[j].resize(size());
+				for (size_t k=0;k<size();++k)
+					y[j][k] = Y[k*ny+j];
+			}
 			return y;
 		}
 
-#if 0
-		template<typename _Tp1>
-		struct rebind
-		{
-			typedef BlasMatrix<_Tp1> other;
+	};
 
-			void operator() (other *& Ap, const Self_t& A, const _Tp1& F) {
-				Ap = new other(F, A.rowdim(), A.coldim());
-				Hom<Field, _Tp1> hom(A. field(), F);
 
-				hom.image (*Ap_p, *A_p);
-			}
-		};
-#endif
+	template <>
+	class MatrixContainerTrait<BlasMatrix<MultiModDouble> > {
+	public:
+		typedef MatrixContainerCategory::Blackbox Type;
+	};
 
-		size_t rowdim() const {return _row;}
+	/*! Operations on BlasMatrix<MultiModDouble>, prime by prime.
+	 * Scalars are Elements of the MultiModDouble, one residue per prime.
+	 */
+	template<>
+	class BlasMatrixDomain<MultiModDouble> {
 
-		size_t coldim() const {return _col;}
+	public:
+		typedef MultiModDouble                  Field;
+		typedef Field::Element                Element;
+		typedef BlasMatrix<MultiModDouble>     Matrix;
+		typedef Matrix::Residue               Residue;
 
+	protected:
+		const Field  * _field;
 
-		const Field &field() const  {return _field;}
+	public:
 
+		BlasMatrixDomain (const Field& F ) : _field(&F) {}
 
-		std::ostream& write(std::ostream& os) const
+		const Field& field() const { return *_field; }
+
+		//! C = A
+		Matrix& copy(Matrix& C, const Matrix& A) const
 		{
-			for (size_t i=0;i<_rep.size();++i)
-				_rep[i]->write(os);
-			return os;
+			return C = A;
 		}
 
+		//! C = A*B
+		Matrix& mul(Matrix& C, const Matrix& A, const Matrix& B) const
+		{
+			linbox_check( A.coldim() == B.rowdim());
+			linbox_check( C.rowdim() == A.rowdim());
+			linbox_check( C.coldim() == B.coldim());
+			const size_t m = C.rowdim(), n = C.coldim(), k = A.coldim();
+#ifdef __LINBOX_USE_OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+			for (long li=0;li<(long)field().size();++li) {
+				const size_t i = (size_t)li;
+				const Residue &F = field().getBase(i);
+				FFLAS::fgemm(F, FFLAS::FflasNoTrans, FFLAS::FflasNoTrans, m, n, k,
+					     F.one, A.getPointer(i), A.getStride(), B.getPointer(i), B.getStride(),
+					     F.zero, C.getPointer(i), C.getStride());
+			}
+			return C;
+		}
 
-		const Element& setEntry (size_t , size_t j, const Element &a_ij)
+		//! C = beta.C + alpha.A*B
+		Matrix& muladdin(const Element& beta, Matrix& C,
+				 const Element& alpha, const Matrix& A, const Matrix& B) const
 		{
-			for (size_t i=0; i< _rep.size();++i)
-				_rep[i]->setEntry(i,j,a_ij[i]);
-            return a_ij;
+			linbox_check( A.coldim() == B.rowdim());
+			linbox_check( C.rowdim() == A.rowdim());
+			linbox_check( C.coldim() == B.coldim());
+			const size_t m = C.rowdim(), n = C.coldim(), k = A.coldim();
+#ifdef __LINBOX_USE_OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+			for (long li=0;li<(long)field().size();++li) {
+				const size_t i = (size_t)li;
+				const Residue &F = field().getBase(i);
+				FFLAS::fgemm(F, FFLAS::FflasNoTrans, FFLAS::FflasNoTrans, m, n, k,
+					     alpha[i], A.getPointer(i), A.getStride(), B.getPointer(i), B.getStride(),
+					     beta[i], C.getPointer(i), C.getStride());
+			}
+			return C;
 		}
 
+		//! C = A+B
+		Matrix& add(Matrix& C, const Matrix& A, const Matrix& B) const
+		{
+			linbox_check( same(C,A) && same(C,B));
+			const size_t mn = C.rowdim()*C.coldim();
+#ifdef __LINBOX_USE_OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+			for (long li=0;li<(long)field().size();++li) {
+				const size_t i = (size_t)li;
+				FFLAS::fadd(field().getBase(i), mn, A.getPointer(i), 1, B.getPointer(i), 1, C.getPointer(i), 1);
+			}
+			return C;
+		}
 
-		const Element& getEntry (size_t , size_t j) const
+		//! C = A-B
+		Matrix& sub(Matrix& C, const Matrix& A, const Matrix& B) const
 		{
-			for (size_t i=0; i< _rep.size();++i)
-				_entry[i]=_rep[i]->getEntry(i,j);
-			return _entry;
+			linbox_check( same(C,A) && same(C,B));
+			const size_t mn = C.rowdim()*C.coldim();
+#ifdef __LINBOX_USE_OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+			for (long li=0;li<(long)field().size();++li) {
+				const size_t i = (size_t)li;
+				FFLAS::fsub(field().getBase(i), mn, A.getPointer(i), 1, B.getPointer(i), 1, C.getPointer(i), 1);
+			}
+			return C;
+		}
+
+		//! C += B
+		Matrix& addin(Matrix& C, const Matrix& B) const
+		{
+			linbox_check( same(C,B));
+			const size_t mn = C.rowdim()*C.coldim();
+#ifdef __LINBOX_USE_OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+			for (long li=0;li<(long)field().size();++li) {
+				const size_t i = (size_t)li;
+				FFLAS::faddin(field().getBase(i), mn, B.getPointer(i), 1, C.getPointer(i), 1);
+			}
+			return C;
 		}
 
-		BlasMatrix<Givaro::Modular<double> >*& getMatrix(size_t i) {return _rep[i];}
+		//! C -= B
+		Matrix& subin(Matrix& C, const Matrix& B) const
+		{
+			linbox_check( same(C,B));
+			const size_t mn = C.rowdim()*C.coldim();
+#ifdef __LINBOX_USE_OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+			for (long li=0;li<(long)field().size();++li) {
+				const size_t i = (size_t)li;
+				FFLAS::fsubin(field().getBase(i), mn, B.getPointer(i), 1, C.getPointer(i), 1);
+			}
+			return C;
+		}
 
-	};
+		//! C = a.C
+		Matrix& mulin(Matrix& C, const Element& a) const
+		{
+			const size_t mn = C.rowdim()*C.coldim();
+#ifdef __LINBOX_USE_OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+			for (long li=0;li<(long)field().size();++li) {
+				const size_t i = (size_t)li;
+				FFLAS::fscalin(field().getBase(i), mn, a[i], C.getPointer(i), 1);
+			}
+			return C;
+		}
 
+		//! C += a.B
+		Matrix& axpyin(Matrix& C, const Element& a, const Matrix& B) const
+		{
+			linbox_check( same(C,B));
+			const size_t mn = C.rowdim()*C.coldim();
+#ifdef __LINBOX_USE_OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+			for (long li=0;li<(long)field().size();++li) {
+				const size_t i = (size_t)li;
+				FFLAS::faxpy(field().getBase(i), mn, a[i], B.getPointer(i), 1, C.getPointer(i), 1);
+			}
+			return C;
+		}
 
-	template <>
-	class MatrixContainerTrait<BlasMatrix<MultiModDouble> > {
-	public:
-		typedef MatrixContainerCategory::Blackbox Type;
+		bool areEqual(const Matrix& A, const Matrix& B) const
+		{
+			if (!same(A,B))
+				return false;
+			const size_t mn = A.rowdim()*A.coldim();
+			for (size_t i=0;i<field().size();++i)
+				for (size_t x=0;x<mn;++x)
+					if (A.getPointer(i)[x] != B.getPointer(i)[x])
+						return false;
+			return true;
+		}
+
+	protected:
+
+		static bool same(const Matrix& A, const Matrix& B)
+		{
+			return A.rowdim() == B.rowdim() && A.coldim() == B.coldim();
+		}
 	};
+
 } // LinBox
 
-#endif // __LINBOX_blas_matrix_H
+#endif // __LINBOX_blas_matrix_multimod_H
 
 // Local Variables:
 // mode: C++
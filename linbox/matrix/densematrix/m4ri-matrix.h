@@ -0,0 +1,269 @@
+/* linbox/matrix/densematrix/m4ri-matrix.h
+ *
+ * ========LICENCE========
+ * This file is part of the library LinBox.
+ *
+ * LinBox is free software: you can redistribute it and/or modify
+ * it under the terms of the  GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ * ========LICENCE========
+ */
+
+/*! @file matrix/densematrix/m4ri-matrix.h
+ * @ingroup matrix
+ * @brief Dense matrices over GF(2), packed 64 entries per machine word.
+ *
+ * The layout is the one of the M4RI library: row major, each row padded
+ * to a whole number of 64-bit words, entry \f$(i,j)\f$ being bit
+ * \f$j \bmod 64\f$ of word \f$j/64\f$ of row \f$i\f$.  The padding bits
+ * are always zero, so rows can be combined word by word.  The library
+ * itself is not needed: the algorithms are in M4RIMatrixDomain.
+ */
+
+#ifndef __LINBOX_matrix_densematrix_m4ri_matrix_H
+#define __LINBOX_matrix_densematrix_m4ri_matrix_H
+
+#include <vector>
+#include <iostream>
+#include <algorithm>
+#include <stdint.h>
+
+#include "linbox/linbox-config.h"
+#include "linbox/util/debug.h"
+#include "linbox/field/gf2.h"
+
+namespace LinBox
+{
+
+	/** @brief Dense packed matrix over GF(2).
+	 * \ingroup matrix
+	 *
+	 * Only the interface needed by M4RIMatrixDomain and the usual entry
+	 * accessors are provided; there are no row or column iterators, the
+	 * rows being accessed as arrays of words through row().
+	 */
+	class M4RIMatrix {
+	public:
+		typedef GF2                Field;
+		typedef GF2::Element     Element;
+		typedef uint64_t            Word;
+		typedef M4RIMatrix          Self_t;
+
+		static const size_t WordBits = 64;
+
+		M4RIMatrix () :
+			_field (NULL), _m (0), _n (0), _w (0)
+		{}
+
+		//! m x n zero matrix
+		M4RIMatrix (const GF2 &F, size_t m, size_t n) :
+			_field (&F)
+		{
+			init (m, n);
+		}
+
+		/** Packs a matrix over GF(2) given through \c getEntry, e.g. a
+		 * BlasMatrix<GF2> or a SparseMatrix<GF2>.
+		 */
+		template <class Matrix>
+		M4RIMatrix (const GF2 &F, const Matrix &A) :
+			_field (&F)
+		{
+			init (A.rowdim (), A.coldim ());
+			for (size_t i = 0; i < _m; ++i)
+				for (size_t j = 0; j < _n; ++j) {
+					bool e;
+					A.getEntry (e, i, j);
+					if (e) setEntry (i, j, true);
+				}
+		}
+
+		//! resizes to m x n, all entries zero
+		void init (size_t m, size_t n)
+		{
+			_m = m; _n = n;
+			_w = (n + WordBits - 1) / WordBits;
+			_rep.assign (_m * _w, 0);
+		}
+
+		void resize (size_t m, size_t n) { init (m, n); }
+
+		const GF2 &field () const { return *_field; }
+
+		size_t rowdim () const { return _m; }
+		size_t coldim () const { return _n; }
+
+		//! number of words per row
+		size_t rowstride () const { return _w; }
+
+		Word *row (size_t i) { return _rep.data () + i * _w; }
+		const Word *row (size_t i) const { return _rep.data () + i * _w; }
+
+		//! mask of the meaningful bits of the last word of a row
+		Word lastMask () const
+		{
+			return (_n % WordBits) ? ((Word (1) << (_n % WordBits)) - 1) : ~Word (0);
+		}
+
+		bool getEntry (size_t i, size_t j) const
+		{
+			linbox_check (i < _m && j < _n);
+			return (row (i)[j / WordBits] >> (j % WordBits)) & 1;
+		}
+
+		bool &getEntry (bool &x, size_t i, size_t j) const
+		{
+			return x = getEntry (i, j);
+		}
+
+		void setEntry (size_t i, size_t j, const bool &a)
+		{
+			linbox_check (i < _m && j < _n);
+			const Word b = Word (1) << (j % WordBits);
+			if (a) row (i)[j / WordBits] |= b;
+			else   row (i)[j / WordBits] &= ~b;
+		}
+
+		void zero () { std::fill (_rep.begin (), _rep.end (), Word (0)); }
+
+		void identity ()
+		{
+			zero ();
+			for (size_t i = 0; i < std::min (_m, _n); ++i)
+				setEntry (i, i, true);
+		}
+
+		/** Fills with random entries.
+		 * @param g generator returning (at least) 64 random bits per call,
+		 * such as \c std::mt19937_64
+		 */
+		template <class Generator>
+		void random (Generator &g)
+		{
+			const Word mask = lastMask ();
+			for (size_t i = 0; i < _m; ++i) {
+				Word *r = row (i);
+				for (size_t k = 0; k < _w; ++k)
+					r[k] = (Word) g ();
+				if (_w) r[_w - 1] &= mask;
+			}
+		}
+
+		//! exchanges rows i and k
+		void swapRows (size_t i, size_t k)
+		{
+			if (i != k)
+				std::swap_ranges (row (i), row (i) + _w, row (k));
+		}
+
+		//! exchanges columns j and k
+		void swapCols (size_t j, size_t k)
+		{
+			if (j == k) return;
+			for (size_t i = 0; i < _m; ++i) {
+				bool a = getEntry (i, j), b = getEntry (i, k);
+				if (a != b) {
+					setEntry (i, j, b);
+					setEntry (i, k, a);
+				}
+			}
+		}
+
+		/** row i += row k, on the words starting with word \p w0
+		 * (the words before are assumed zero in row k).
+		 */
+		void addRow (size_t i, size_t k, size_t w0 = 0)
+		{
+			Word *a = row (i);
+			const Word *b = row (k);
+			for (size_t t = w0; t < _w; ++t)
+				a[t] ^= b[t];
+		}
+
+		//! \f$y \gets Ax\f$ for dense vectors of bools (or BitVector)
+		template <class OutVector, class InVector>
+		OutVector &apply (OutVector &y, const InVector &x) const
+		{
+			linbox_check (x.size () == _n && y.size () == _m);
+			std::vector<Word> px (_w, 0);
+			for (size_t j = 0; j < _n; ++j)
+				if (x[j]) px[j / WordBits] |= Word (1) << (j % WordBits);
+			for (size_t i = 0; i < _m; ++i) {
+				const Word *r = row (i);
+				Word s = 0;
+				for (size_t t = 0; t < _w; ++t)
+					s ^= r[t] & px[t];
+				y[i] = parity (s);
+			}
+			return y;
+		}
+
+		//! \f$y \gets A^Tx\f$
+		template <class OutVector, class InVector>
+		OutVector &applyTranspose (OutVector &y, const InVector &x) const
+		{
+			linbox_check (x.size () == _m && y.size () == _n);
+			std::vector<Word> py (_w, 0);
+			for (size_t i = 0; i < _m; ++i)
+				if (x[i]) {
+					const Word *r = row (i);
+					for (size_t t = 0; t < _w; ++t)
+						py[t] ^= r[t];
+				}
+			for (size_t j = 0; j < _n; ++j)
+				y[j] = (py[j / WordBits] >> (j % WordBits)) & 1;
+			return y;
+		}
+
+		static bool parity (Word s)
+		{
+			s ^= s >> 32; s ^= s >> 16; s ^= s >> 8;
+			s ^= s >> 4;  s ^= s >> 2;  s ^= s >> 1;
+			return s & 1;
+		}
+
+		std::ostream &write (std::ostream &os) const
+		{
+			for (size_t i = 0; i < _m; ++i) {
+				os << "[";
+				for (size_t j = 0; j < _n; ++j)
+					os << (getEntry (i, j) ? " 1" : " 0");
+				os << " ]" << std::endl;
+			}
+			return os;
+		}
+
+	protected:
+		const GF2        *_field;
+		size_t                _m;
+		size_t                _n;
+		size_t                _w; // words per row
+		std::vector<Word>   _rep;
+	};
+
+	inline std::ostream &operator<< (std::ostream &os, const M4RIMatrix &A)
+	{
+		return A.write (os);
+	}
+
+}
+
+#endif // __LINBOX_matrix_densematrix_m4ri_matrix_H
+
+// Local Variables:
+// mode: C++
+// tab-width: 4
+// indent-tabs-mode: nil
+// c-basic-offset: 4
+// End:
+// vim:sts=4:sw=4:ts=4:et:sr:cino=>s,f0,{0,g0,(0,\:0,t0,+0,=s
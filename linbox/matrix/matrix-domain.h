@@ -67,7 +67,7 @@ namespace LinBox {
 #include "matrixdomain/matrix-domain.h" // needed by BlasMatrix
 #include "matrixdomain/blas-matrix-domain.h"
 #include "matrixdomain/matrix-domain-gf2.h"
-// #include "matrixdomain/matrix-domain-m4ri.h"
+#include "matrixdomain/matrix-domain-m4ri.h"
 #include "matrixdomain/plain-domain.h"
 
 #include "matrixdomain/opencl-domain.h"
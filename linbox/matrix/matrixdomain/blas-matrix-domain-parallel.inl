@@ -0,0 +1,251 @@
+/* linbox/matrix/matrixdomain/blas-matrix-domain-parallel.inl
+ *
+ * ========LICENCE========
+ * This file is part of the library LinBox.
+ *
+ * LinBox is free software: you can redistribute it and/or modify
+ * it under the terms of the  GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ * ========LICENCE========
+ */
+
+/*! @internal
+ * @file matrix/matrixdomain/blas-matrix-domain-parallel.inl
+ * @brief Parallel kernels of BlasMatrixDomain (see BlasExecution).
+ *
+ * Products are FFLAS parallel fgemm, rank, determinant and inverse go
+ * through a parallel PLUQ, and the triangular solves are split in
+ * independent slices of the right hand side, one per thread.
+ */
+
+#ifndef __LINBOX_matrix_matrixdomain_blas_matrix_domain_parallel_INL
+#define __LINBOX_matrix_matrixdomain_blas_matrix_domain_parallel_INL
+
+#include <vector>
+#include <algorithm>
+#include <type_traits>
+
+namespace LinBox { namespace Protected {
+
+	//! dense matrices with a pointer and a stride, handled by the parallel kernels
+	template <class Matrix>
+	struct IsBlasDenseOne : public std::false_type {};
+	template <class Field, class Rep>
+	struct IsBlasDenseOne<BlasMatrix<Field,Rep> > : public std::true_type {};
+	template <class Matrix>
+	struct IsBlasDenseOne<BlasSubmatrix<Matrix> > : public std::true_type {};
+
+	//! true when all the operands are handled by the parallel kernels
+	template <class Matrix1, class Matrix2 = Matrix1, class Matrix3 = Matrix1>
+	struct IsBlasDense : public std::integral_constant<bool,
+			IsBlasDenseOne<Matrix1>::value
+			&& IsBlasDenseOne<Matrix2>::value
+			&& IsBlasDenseOne<Matrix3>::value> {};
+
+	template <class Field>
+	struct BlasMatrixDomainParallel {
+		typedef typename Field::Element           Element;
+		typedef typename Field::Element_ptr   Element_ptr;
+
+		typedef FFLAS::ParSeqHelper::Parallel<FFLAS::CuttingStrategy::Recursive,
+						      FFLAS::StrategyParameter::TwoDAdaptive> GemmHelper;
+		typedef FFLAS::ParSeqHelper::Parallel<FFLAS::CuttingStrategy::Recursive,
+						      FFLAS::StrategyParameter::Threads>      PluqHelper;
+
+		//! C = beta C + alpha A B
+		template <class Matrix1, class Matrix2, class Matrix3>
+		static Matrix1 &muladdin (const BlasExecution &E,
+					  const Element &beta, Matrix1 &C,
+					  const Element &alpha, const Matrix2 &A, const Matrix3 &B)
+		{
+			linbox_check( A.coldim() == B.rowdim());
+			linbox_check( C.rowdim() == A.rowdim());
+			linbox_check( C.coldim() == B.coldim());
+			typename Matrix2::constSubMatrixType A_v(A);
+			typename Matrix3::constSubMatrixType B_v(B);
+			typename Matrix1::subMatrixType C_v(C);
+
+			const size_t t = E.numThreads();
+			PAR_BLOCK {
+				FFLAS::fgemm( C.field(), FFLAS::FflasNoTrans, FFLAS::FflasNoTrans,
+					      C_v.rowdim(), C_v.coldim(), A_v.coldim(),
+					      alpha,
+					      A_v.getPointer(), A_v.getStride(),
+					      B_v.getPointer(), B_v.getStride(),
+					      beta,
+					      C_v.getWritePointer(), C_v.getStride(),
+					      GemmHelper(t));
+			}
+			return C;
+		}
+
+		/** PLUQ of the m x n matrix A, in place; returns the rank.
+		 * P and Q are in LAPACK format, \f$A = P L U Q\f$.
+		 */
+		static size_t pluq (const Field &F, const BlasExecution &E,
+				    size_t m, size_t n, Element_ptr A, size_t lda,
+				    std::vector<size_t> &P, std::vector<size_t> &Q)
+		{
+			P.assign(m, 0);
+			Q.assign(n, 0);
+			size_t r = 0;
+			const size_t t = E.numThreads();
+			PAR_BLOCK {
+				r = FFPACK::PLUQ(F, FFLAS::FflasNonUnit, m, n, A, lda,
+						 P.data(), Q.data(), PluqHelper(t));
+			}
+			return r;
+		}
+
+		//! rank of A, which is overwritten
+		template <class Matrix>
+		static unsigned int rankin (const Field &F, const BlasExecution &E, Matrix &A)
+		{
+			typename Matrix::subMatrixType A_v(A);
+			std::vector<size_t> P, Q;
+			return (unsigned int) pluq(F, E, A_v.rowdim(), A_v.coldim(),
+						   A_v.getWritePointer(), A_v.getStride(), P, Q);
+		}
+
+		//! determinant of A, which is overwritten
+		template <class Matrix>
+		static Element detin (const Field &F, const BlasExecution &E, Matrix &A)
+		{
+			linbox_check( A.rowdim() == A.coldim());
+			typename Matrix::subMatrixType A_v(A);
+			const size_t n = A_v.rowdim();
+			std::vector<size_t> P, Q;
+			Element_ptr LU = A_v.getWritePointer();
+			const size_t lda = A_v.getStride();
+			Element d;
+			F.assign(d, F.one);
+			if (pluq(F, E, n, n, LU, lda, P, Q) < n)
+				return F.assign(d, F.zero);
+			bool odd = false;
+			for (size_t i = 0; i < n; ++i) {
+				F.mulin(d, LU[i*lda+i]);
+				odd ^= (P[i] != i);
+				odd ^= (Q[i] != i);
+			}
+			if (odd)
+				F.negin(d);
+			return d;
+		}
+
+		/** Calls f(j0, w) for slices [j0, j0+w) of n columns (or rows),
+		 * one per thread.
+		 */
+		template <class Slice>
+		static void slices (const BlasExecution &E, size_t n, Slice f)
+		{
+			const size_t t = std::max((size_t)1, std::min(E.numThreads(), n));
+			const size_t q = n / t, r = n % t;
+#ifdef __LINBOX_USE_OPENMP
+#pragma omp parallel for num_threads(t) schedule(static,1)
+#endif
+			for (long k = 0; k < (long)t; ++k) {
+				const size_t s = (size_t)k;
+				const size_t w = q + (s < r ? 1 : 0);
+				if (w)
+					f(s*q + std::min(s, r), w);
+			}
+		}
+
+		/** Ainv = A^{-1}, A is overwritten by its PLUQ factorization.
+		 * \f$A^{-1} = Q^T U^{-1} L^{-1} P^T\f$ is computed by slices of
+		 * columns of the identity.  Returns the nullity.
+		 */
+		template <class Matrix1, class Matrix2>
+		static int invin (const Field &F, const BlasExecution &E, Matrix1 &Ainv, Matrix2 &A)
+		{
+			linbox_check( A.rowdim() == A.coldim());
+			linbox_check( A.rowdim() == Ainv.rowdim());
+			linbox_check( A.coldim() == Ainv.coldim());
+			typename Matrix2::subMatrixType A_v(A);
+			typename Matrix1::subMatrixType X_v(Ainv);
+			const size_t n = A_v.rowdim();
+			Element_ptr LU = A_v.getWritePointer();
+			const size_t lda = A_v.getStride();
+			std::vector<size_t> P, Q;
+			const size_t r = pluq(F, E, n, n, LU, lda, P, Q);
+			if (r < n)
+				return (int)(n - r);
+
+			Element_ptr X = X_v.getWritePointer();
+			const size_t ldx = X_v.getStride();
+			for (size_t i = 0; i < n; ++i)
+				for (size_t j = 0; j < n; ++j)
+					F.assign(X[i*ldx+j], (i == j) ? F.one : F.zero);
+
+			slices(E, n, [&] (size_t j0, size_t w) {
+				FFPACK::applyP(F, FFLAS::FflasLeft, FFLAS::FflasNoTrans, w, 0, n, X+j0, ldx, P.data());
+				FFLAS::ftrsm(F, FFLAS::FflasLeft, FFLAS::FflasLower, FFLAS::FflasNoTrans, FFLAS::FflasUnit,
+					     n, w, F.one, LU, lda, X+j0, ldx);
+				FFLAS::ftrsm(F, FFLAS::FflasLeft, FFLAS::FflasUpper, FFLAS::FflasNoTrans, FFLAS::FflasNonUnit,
+					     n, w, F.one, LU, lda, X+j0, ldx);
+				FFPACK::applyP(F, FFLAS::FflasLeft, FFLAS::FflasNoTrans, w, 0, n, X+j0, ldx, Q.data());
+			});
+			return 0;
+		}
+
+		//! B = A^{-1} B, A triangular; the columns of B are independent
+		template <class Rep, class Matrix>
+		static Matrix &left_solve (const Field &F, const BlasExecution &E,
+					   const TriangularBlasMatrix<Field,Rep> &A, Matrix &B)
+		{
+			linbox_check( A.rowdim() == A.coldim());
+			linbox_check( A.coldim() == B.rowdim());
+			typename Matrix::subMatrixType B_v(B);
+			Element_ptr Bp = B_v.getWritePointer();
+			const size_t ldb = B_v.getStride();
+			slices(E, B_v.coldim(), [&] (size_t j0, size_t w) {
+				FFLAS::ftrsm(F, FFLAS::FflasLeft, (FFLAS::FFLAS_UPLO) A.getUpLo(),
+					     FFLAS::FflasNoTrans, (FFLAS::FFLAS_DIAG) A.getDiag(),
+					     A.rowdim(), w, F.one, A.getPointer(), A.getStride(),
+					     Bp+j0, ldb);
+			});
+			return B;
+		}
+
+		//! B = B A^{-1}, A triangular; the rows of B are independent
+		template <class Rep, class Matrix>
+		static Matrix &right_solve (const Field &F, const BlasExecution &E,
+					    const TriangularBlasMatrix<Field,Rep> &A, Matrix &B)
+		{
+			linbox_check( A.rowdim() == A.coldim());
+			linbox_check( B.coldim() == A.rowdim());
+			typename Matrix::subMatrixType B_v(B);
+			Element_ptr Bp = B_v.getWritePointer();
+			const size_t ldb = B_v.getStride();
+			slices(E, B_v.rowdim(), [&] (size_t i0, size_t w) {
+				FFLAS::ftrsm(F, FFLAS::FflasRight, (FFLAS::FFLAS_UPLO) A.getUpLo(),
+					     FFLAS::FflasNoTrans, (FFLAS::FFLAS_DIAG) A.getDiag(),
+					     w, A.coldim(), F.one, A.getPointer(), A.getStride(),
+					     Bp+i0*ldb, ldb);
+			});
+			return B;
+		}
+	};
+
+} // Protected
+} // LinBox
+
+#endif // __LINBOX_matrix_matrixdomain_blas_matrix_domain_parallel_INL
+
+// Local Variables:
+// mode: C++
+// tab-width: 4
+// indent-tabs-mode: nil
+// c-basic-offset: 4
+// End:
+// vim:sts=4:sw=4:ts=4:et:sr:cino=>s,f0,{0,g0,(0,\:0,t0,+0,=s
@@ -41,6 +41,11 @@
 #include <linbox/linbox-config.h>
 #include <iostream>
 #include <vector>
+#include <algorithm>
+#include <type_traits>
+#ifdef __LINBOX_USE_OPENMP
+#include <omp.h>
+#endif
 
 #include <fflas-ffpack/ffpack/ffpack.h>
 #include <fflas-ffpack/fflas/fflas.h>
@@ -320,6 +325,62 @@ namespace LinBox
 	// 	BlasVector<Field,_Vrep>&  operator() (const Field &F, BlasVector<Field,_Vrep>& P, const Matrix& A) const;
 	// };
 
+	/** Execution policy of the dense kernels of BlasMatrixDomain.
+	 *
+	 * - \c SEQUENTIAL: the sequential FFLAS-FFPACK routines (default);
+	 * - \c PARALLEL: recursive task parallel FFLAS-FFPACK routines on
+	 *   all the available threads;
+	 * - \c THREADS: the same on a fixed number of threads.
+	 *
+	 * The policy applies to the products, rank, determinant, inverse and
+	 * triangular solves on BlasMatrix and BlasSubmatrix operands; other
+	 * operands always use the sequential code.  Domains built without a
+	 * policy take BlasExecution::byDefault(), so that setting it makes
+	 * the algorithms built on BlasMatrixDomain parallel.
+	 */
+	struct BlasExecution {
+		enum Mode { SEQUENTIAL, PARALLEL, THREADS };
+
+		Mode      mode;
+		size_t threads; // for THREADS
+
+		BlasExecution (Mode m = SEQUENTIAL, size_t t = 0) :
+			mode(m), threads(t)
+		{}
+
+		static BlasExecution sequential () { return BlasExecution(SEQUENTIAL); }
+		static BlasExecution parallel () { return BlasExecution(PARALLEL); }
+		static BlasExecution fixed (size_t t) { return BlasExecution(THREADS, t); }
+
+		//! number of threads used by the kernels
+		size_t numThreads () const
+		{
+			switch (mode) {
+#ifdef __LINBOX_USE_OPENMP
+			case PARALLEL : return (size_t)omp_get_max_threads();
+#endif
+			case THREADS  : return std::max(threads, (size_t)1);
+			default       : return 1;
+			}
+		}
+
+		bool isParallel () const { return numThreads () > 1; }
+
+		//! policy of the domains constructed without one
+		static BlasExecution &byDefault ()
+		{
+			static BlasExecution E;
+			return E;
+		}
+	};
+
+} /* end of namespace LinBox */
+
+#include "linbox/matrix/matrixdomain/blas-matrix-domain-parallel.inl"
+
+namespace LinBox
+{
+
 	/**
 	 *  Interface for all functionnalities provided
 	 *  for BlasMatrix.
@@ -341,6 +402,9 @@ namespace LinBox
 	protected:
 
 		const Field  * _field;
+		BlasExecution   _exec;
+
+		typedef Protected::BlasMatrixDomainParallel<Field> Parallel;
 
 	public:
 
@@ -398,8 +462,9 @@ namespace LinBox
 		inline std::ostream &write (std::ostream &os, const Matrix &A, bool maple_format) const
 		inline std::istream &read (std::istream &is, Matrix &A) const
 */
-		BlasMatrixDomain () {}
-		BlasMatrixDomain (const Field& F ) { init(F); }
+		BlasMatrixDomain () : _exec(BlasExecution::byDefault()) {}
+		BlasMatrixDomain (const Field& F ) : _exec(BlasExecution::byDefault()) { init(F); }
+		BlasMatrixDomain (const Field& F, const BlasExecution& E ) : _exec(E) { init(F); }
 
 		void init(const Field& F )
 		{
@@ -417,7 +482,7 @@ namespace LinBox
 
 		//! Copy constructor
 		BlasMatrixDomain (const BlasMatrixDomain<Field> & BMD) :
-			_field(BMD._field)
+			_field(BMD._field), _exec(BMD._exec)
 		{
 #if 0 // NO MORE USEFUL
 #ifndef NDEBUG
@@ -432,6 +497,10 @@ namespace LinBox
 		//! Field accessor
 		const Field& field() const { return *_field; }
 
+		//! execution policy of the dense kernels
+		const BlasExecution& execution() const { return _exec; }
+		void setExecution(const BlasExecution& E) { _exec = E; }
+
 		/*
 		 * Basics operation available matrix respecting BlasMatrix interface
 		 */
@@ -441,6 +510,8 @@ namespace LinBox
 		template <class Operand1, class Operand2, class Operand3>
 		Operand1& mul(Operand1& C, const Operand2& A, const Operand3& B) const
 		{
+			if (_exec.isParallel() && Protected::IsBlasDense<Operand1,Operand2,Operand3>::value)
+				return muladdin(field().zero,C,field().one,A,B);
 			return BlasMatrixDomainMul<Field,Operand1,Operand2,Operand3>()(field(),C,A,B);
 		}
 
@@ -568,6 +639,10 @@ namespace LinBox
 		Operand1& muladd(Operand1& D, const Element& beta, const Operand1& C,
 				 const Element& alpha, const Operand2& A, const Operand3& B) const
 		{
+			if (_exec.isParallel() && Protected::IsBlasDense<Operand1,Operand2,Operand3>::value) {
+				copy(D,C);
+				return muladdin(beta,D,alpha,A,B);
+			}
 			return BlasMatrixDomainMulAdd<Operand1,Operand2,Operand3/*,Operand1::MatrixVectorType()*/>()(D,beta,C,alpha,A,B);
 		}
 
@@ -577,7 +652,7 @@ namespace LinBox
 		Operand1& muladdin(const Element& beta, Operand1& C,
 				   const Element& alpha, const Operand2& A, const Operand3& B) const
 		{
-			return BlasMatrixDomainMulAdd<Operand1,Operand2,Operand3/*,Operand1::MatrixVectorType()*/>()(beta,C,alpha,A,B);
+			return _muladdin(beta,C,alpha,A,B,Protected::IsBlasDense<Operand1,Operand2,Operand3>());
 		}
 
 
@@ -590,16 +665,16 @@ namespace LinBox
 		template <class Matrix1, class Matrix2>
 		Matrix1& inv( Matrix1 &Ainv, const Matrix2 &A) const
 		{
-			BlasMatrixDomainInv<Field,Matrix1,Matrix2>()(field(),Ainv,A);
-			return Ainv;
+			int nullity;
+			return inv(Ainv,A,nullity);
 		}
 
 		//! Inversion (in place)
 		template <class Matrix>
 		Matrix& invin( Matrix &Ainv, Matrix &A) const
 		{
-			BlasMatrixDomainInv<Field,Matrix,Matrix>()(field(),Ainv,A);
-			return Ainv;
+			int nullity;
+			return invin(Ainv,A,nullity);
 		}
 
 		//! Inversion (the matrix A is modified)
@@ -644,7 +719,7 @@ namespace LinBox
 		template <class Matrix1, class Matrix2>
 		Matrix1& inv( Matrix1 &Ainv, const Matrix2 &A, int& nullity) const
 		{
-			nullity = BlasMatrixDomainInv<Field,Matrix1,Matrix2>()(field(),Ainv,A);
+			nullity = _inv(Ainv,A,Protected::IsBlasDense<Matrix1,Matrix2>());
 			return Ainv;
 		}
 
@@ -653,7 +728,7 @@ namespace LinBox
 		template <class Matrix1, class Matrix2>
 		Matrix1& invin( Matrix1 &Ainv, Matrix2 &A, int& nullity) const
 		{
-			nullity = BlasMatrixDomainInv<Field,Matrix1,Matrix2>()(field(),Ainv,A);
+			nullity = _invin(Ainv,A,Protected::IsBlasDense<Matrix1,Matrix2>());
 			return Ainv;
 		}
 
@@ -661,29 +736,28 @@ namespace LinBox
 		template <class Matrix>
 		unsigned int rank(const Matrix &A) const
 		{
-			return BlasMatrixDomainRank<Field,Matrix>()(field(),A);
+			return _rank(A,Protected::IsBlasDense<Matrix>());
 		}
 
 		//! in-place Rank (the matrix is modified)
 		template <class Matrix>
 		unsigned int rankin(Matrix &A) const
 		{
-			return BlasMatrixDomainRank<Field, Matrix>()(field(),A);
+			return _rankin(A,Protected::IsBlasDense<Matrix>());
 		}
 
 		//! determinant
 		template <class Matrix>
 		Element det(const Matrix &A) const
 		{
-			return BlasMatrixDomainDet<Field, Matrix>()(field(),A);
+			return _det(A,Protected::IsBlasDense<Matrix>());
 		}
 
 		//! in-place Determinant (the matrix is modified)
 		template <class Matrix>
 		Element detin(Matrix &A) const
 		{
-
-			return BlasMatrixDomainDet<Field, Matrix>()(field(),A);
+			return _detin(A,Protected::IsBlasDense<Matrix>());
 		}
 		//@}
 
@@ -709,6 +783,13 @@ namespace LinBox
 			return BlasMatrixDomainLeftSolve<Field,Operand,Matrix>()(field(),A,B);
 		}
 
+		//! AX=B , (B<-X), A triangular: parallel on the columns of B
+		template <class Operand, class _Rep>
+		Operand& left_solve (const TriangularBlasMatrix<Field,_Rep>& A, Operand& B) const
+		{
+			return _left_solve(A,B,Protected::IsBlasDense<Operand>());
+		}
+
 		//! linear solve with matrix right hand side.
 		//! XA=B
 		template <class Operand1, class Matrix, class Operand2>
@@ -726,6 +807,13 @@ namespace LinBox
 			return BlasMatrixDomainRightSolve<Field,Operand,Matrix>()(field(),A,B);
 		}
 
+		//! XA=B , (B<-X), A triangular: parallel on the rows of B
+		template <class Operand, class _Rep>
+		Operand& right_solve (const TriangularBlasMatrix<Field,_Rep>& A, Operand& B) const
+		{
+			return _right_solve(A,B,Protected::IsBlasDense<Operand>());
+		}
+
 		//! minimal polynomial computation.
 		template <class Polynomial, class Matrix>
 		Polynomial& minpoly( Polynomial& P, const Matrix& A ) const
@@ -904,6 +992,144 @@ namespace LinBox
 		}
 #endif
 
+	protected:
+
+		// dispatch between the parallel kernels, for BlasMatrix and
+		// BlasSubmatrix operands (std::true_type), and the functors
+
+		template <class Operand1, class Operand2, class Operand3>
+		Operand1& _muladdin(const Element& beta, Operand1& C,
+				    const Element& alpha, const Operand2& A, const Operand3& B,
+				    std::true_type) const
+		{
+			if (_exec.isParallel())
+				return Parallel::muladdin(_exec,beta,C,alpha,A,B);
+			return BlasMatrixDomainMulAdd<Operand1,Operand2,Operand3>()(beta,C,alpha,A,B);
+		}
+
+		template <class Operand1, class Operand2, class Operand3>
+		Operand1& _muladdin(const Element& beta, Operand1& C,
+				    const Element& alpha, const Operand2& A, const Operand3& B,
+				    std::false_type) const
+		{
+			return BlasMatrixDomainMulAdd<Operand1,Operand2,Operand3>()(beta,C,alpha,A,B);
+		}
+
+		template <class Matrix1, class Matrix2>
+		int _inv(Matrix1& Ainv, const Matrix2& A, std::true_type) const
+		{
+			if (!_exec.isParallel())
+				return BlasMatrixDomainInv<Field,Matrix1,Matrix2>()(field(),Ainv,A);
+			typename Matrix2::matrixType A_c(A); // do copy
+			return Parallel::invin(field(),_exec,Ainv,A_c);
+		}
+
+		template <class Matrix1, class Matrix2>
+		int _inv(Matrix1& Ainv, const Matrix2& A, std::false_type) const
+		{
+			return BlasMatrixDomainInv<Field,Matrix1,Matrix2>()(field(),Ainv,A);
+		}
+
+		template <class Matrix1, class Matrix2>
+		int _invin(Matrix1& Ainv, Matrix2& A, std::true_type) const
+		{
+			if (!_exec.isParallel())
+				return BlasMatrixDomainInv<Field,Matrix1,Matrix2>()(field(),Ainv,A);
+			return Parallel::invin(field(),_exec,Ainv,A);
+		}
+
+		template <class Matrix1, class Matrix2>
+		int _invin(Matrix1& Ainv, Matrix2& A, std::false_type) const
+		{
+			return BlasMatrixDomainInv<Field,Matrix1,Matrix2>()(field(),Ainv,A);
+		}
+
+		template <class Matrix>
+		unsigned int _rank(const Matrix& A, std::true_type) const
+		{
+			if (!_exec.isParallel())
+				return BlasMatrixDomainRank<Field,Matrix>()(field(),A);
+			typename Matrix::matrixType A_c(A); // do copy
+			return Parallel::rankin(field(),_exec,A_c);
+		}
+
+		template <class Matrix>
+		unsigned int _rank(const Matrix& A, std::false_type) const
+		{
+			return BlasMatrixDomainRank<Field,Matrix>()(field(),A);
+		}
+
+		template <class Matrix>
+		unsigned int _rankin(Matrix& A, std::true_type) const
+		{
+			if (!_exec.isParallel())
+				return BlasMatrixDomainRank<Field,Matrix>()(field(),A);
+			return Parallel::rankin(field(),_exec,A);
+		}
+
+		template <class Matrix>
+		unsigned int _rankin(Matrix& A, std::false_type) const
+		{
+			return BlasMatrixDomainRank<Field,Matrix>()(field(),A);
+		}
+
+		template <class Matrix>
+		Element _det(const Matrix& A, std::true_type) const
+		{
+			if (!_exec.isParallel())
+				return BlasMatrixDomainDet<Field,Matrix>()(field(),A);
+			typename Matrix::matrixType A_c(A); // do copy
+			return Parallel::detin(field(),_exec,A_c);
+		}
+
+		template <class Matrix>
+		Element _det(const Matrix& A, std::false_type) const
+		{
+			return BlasMatrixDomainDet<Field,Matrix>()(field(),A);
+		}
+
+		template <class Matrix>
+		Element _detin(Matrix& A, std::true_type) const
+		{
+			if (!_exec.isParallel())
+				return BlasMatrixDomainDet<Field,Matrix>()(field(),A);
+			return Parallel::detin(field(),_exec,A);
+		}
+
+		template <class Matrix>
+		Element _detin(Matrix& A, std::false_type) const
+		{
+			return BlasMatrixDomainDet<Field,Matrix>()(field(),A);
+		}
+
+		template <class Operand, class _Rep>
+		Operand& _left_solve(const TriangularBlasMatrix<Field,_Rep>& A, Operand& B, std::true_type) const
+		{
+			if (!_exec.isParallel())
+				return BlasMatrixDomainLeftSolve<Field,Operand,TriangularBlasMatrix<Field,_Rep> >()(field(),A,B);
+			return Parallel::left_solve(field(),_exec,A,B);
+		}
+
+		template <class Operand, class _Rep>
+		Operand& _left_solve(const TriangularBlasMatrix<Field,_Rep>& A, Operand& B, std::false_type) const
+		{
+			return BlasMatrixDomainLeftSolve<Field,Operand,TriangularBlasMatrix<Field,_Rep> >()(field(),A,B);
+		}
+
+		template <class Operand, class _Rep>
+		Operand& _right_solve(const TriangularBlasMatrix<Field,_Rep>& A, Operand& B, std::true_type) const
+		{
+			if (!_exec.isParallel())
+				return BlasMatrixDomainRightSolve<Field,Operand,TriangularBlasMatrix<Field,_Rep> >()(field(),A,B);
+			return Parallel::right_solve(field(),_exec,A,B);
+		}
+
+		template <class Operand, class _Rep>
+		Operand& _right_solve(const TriangularBlasMatrix<Field,_Rep>& A, Operand& B, std::false_type) const
+		{
+			return BlasMatrixDomainRightSolve<Field,Operand,TriangularBlasMatrix<Field,_Rep> >()(field(),A,B);
+		}
+
 	public:
 
 		/** Print matrix.
@@ -0,0 +1,607 @@
+/* linbox/matrix/matrixdomain/matrix-domain-m4ri.h
+ *
+ * ========LICENCE========
+ * This file is part of the library LinBox.
+ *
+ * LinBox is free software: you can redistribute it and/or modify
+ * it under the terms of the  GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ * ========LICENCE========
+ */
+
+/*! @file matrix/matrixdomain/matrix-domain-m4ri.h
+ * @ingroup matrixdomain
+ * @brief Dense linear algebra over GF(2) on packed M4RIMatrix.
+ *
+ * Multiplication uses the Method of Four Russians (M4RM) with Gray code
+ * tables, and Strassen-Winograd above a cutoff; echelon forms use the
+ * M4RI elimination of Bard.  The BlasMatrixDomain operations are
+ * specialized for M4RIMatrix, so <code>BlasMatrixDomain<GF2></code> can be
+ * used on them as on BlasMatrix.
+ */
+
+#ifndef __LINBOX_matrix_matrixdomain_matrix_domain_m4ri_H
+#define __LINBOX_matrix_matrixdomain_matrix_domain_m4ri_H
+
+#include <vector>
+#include <algorithm>
+
+#include "linbox/linbox-config.h"
+#include "linbox/util/debug.h"
+#include "linbox/util/error.h"
+#include "linbox/field/gf2.h"
+#include "linbox/matrix/densematrix/m4ri-matrix.h"
+#include "linbox/matrix/matrixdomain/blas-matrix-domain.h"
+
+#ifndef LINBOX_M4RI_STRASSEN_CUTOFF
+#define LINBOX_M4RI_STRASSEN_CUTOFF 2048
+#endif
+
+namespace LinBox
+{
+
+	/** @brief Matrix domain for packed dense matrices over GF(2).
+	 * \ingroup matrixdomain
+	 *
+	 * Addition is a word-wise exclusive or.  The products and eliminations
+	 * process the rows 8 at a time: the \f$2^8\f$ sums of 8 rows are
+	 * tabulated in Gray code order (one row addition per entry), then each
+	 * row to update needs a single table lookup instead of up to 8 row
+	 * additions.
+	 */
+	class M4RIMatrixDomain {
+	public:
+		typedef GF2                  Field;
+		typedef bool               Element;
+		typedef M4RIMatrix          Matrix;
+		typedef M4RIMatrix::Word      Word;
+
+		//! number of rows combined in a Gray code table
+		static const size_t K = 8;
+
+		/** @param F the field GF(2)
+		 * @param cutoff dimension under which products are done by M4RM
+		 * only (at least 128, for the recursion to shrink the operands)
+		 */
+		M4RIMatrixDomain (const GF2 &F, size_t cutoff = LINBOX_M4RI_STRASSEN_CUTOFF) :
+			_field (&F), _cutoff (cutoff < 128 ? 128 : cutoff)
+		{}
+
+		const GF2 &field () const { return *_field; }
+
+		Matrix &copy (Matrix &B, const Matrix &A) const
+		{
+			B = A;
+			return B;
+		}
+
+		bool areEqual (const Matrix &A, const Matrix &B) const
+		{
+			if (A.rowdim () != B.rowdim () || A.coldim () != B.coldim ())
+				return false;
+			for (size_t i = 0; i < A.rowdim (); ++i)
+				if (!std::equal (A.row (i), A.row (i) + A.rowstride (), B.row (i)))
+					return false;
+			return true;
+		}
+
+		bool isZero (const Matrix &A) const
+		{
+			for (size_t i = 0; i < A.rowdim (); ++i)
+				for (size_t t = 0; t < A.rowstride (); ++t)
+					if (A.row (i)[t]) return false;
+			return true;
+		}
+
+		//! C += A
+		Matrix &addin (Matrix &C, const Matrix &A) const
+		{
+			linbox_check (C.rowdim () == A.rowdim () && C.coldim () == A.coldim ());
+			for (size_t i = 0; i < C.rowdim (); ++i) {
+				Word *c = C.row (i);
+				const Word *a = A.row (i);
+				for (size_t t = 0; t < C.rowstride (); ++t)
+					c[t] ^= a[t];
+			}
+			return C;
+		}
+
+		//! C = A + B
+		Matrix &add (Matrix &C, const Matrix &A, const Matrix &B) const
+		{
+			C = A;
+			return addin (C, B);
+		}
+
+		//! C = A B
+		Matrix &mul (Matrix &C, const Matrix &A, const Matrix &B) const
+		{
+			C.zero ();
+			return axpyin (C, A, B);
+		}
+
+		//! C += A B
+		Matrix &axpyin (Matrix &C, const Matrix &A, const Matrix &B) const
+		{
+			linbox_check (A.coldim () == B.rowdim ());
+			linbox_check (C.rowdim () == A.rowdim () && C.coldim () == B.coldim ());
+			if (std::min (std::min (A.rowdim (), A.coldim ()), B.coldim ()) >= _cutoff)
+				return strassenWinograd (C, A, B);
+			return m4rm (C, A, B);
+		}
+
+		/** C += A B by the Method of Four Russians.
+		 * For each group of K rows of B, the \f$2^K\f$ combinations are
+		 * tabulated (on a slice of the columns so the table stays in
+		 * cache) and added to the rows of C selected by K bits of A.
+		 */
+		Matrix &m4rm (Matrix &C, const Matrix &A, const Matrix &B) const
+		{
+			const size_t m = A.rowdim (), l = A.coldim (), w = C.rowstride ();
+			const size_t slice = 32; // words of the table rows
+			std::vector<Word> T ((size_t (1) << K) * slice);
+
+			for (size_t c0 = 0; c0 < w; c0 += slice) {
+				const size_t ww = std::min (slice, w - c0);
+				for (size_t k0 = 0; k0 < l; k0 += K) {
+					const size_t kk = (l - k0 < K) ? l - k0 : K;
+					grayTable (T, B, k0, kk, c0, ww);
+					// k0 is a multiple of K, so the kk bits are in one word
+					const size_t wa = k0 / Matrix::WordBits, sh = k0 % Matrix::WordBits;
+					const Word mask = (Word (1) << kk) - 1;
+					for (size_t i = 0; i < m; ++i) {
+						const size_t idx = (size_t) ((A.row (i)[wa] >> sh) & mask);
+						if (!idx) continue;
+						Word *c = C.row (i) + c0;
+						const Word *t = &T[idx * ww];
+						for (size_t s = 0; s < ww; ++s)
+							c[s] ^= t[s];
+					}
+				}
+			}
+			return C;
+		}
+
+		/** C += A B with one level of Strassen-Winograd, recursively.
+		 * The operands are split in quadrants padded with zeros, with
+		 * column splits on word boundaries.
+		 */
+		Matrix &strassenWinograd (Matrix &C, const Matrix &A, const Matrix &B) const
+		{
+			const size_t m = A.rowdim (), l = A.coldim (), n = B.coldim ();
+			const size_t hm = (m + 1) / 2;
+			const size_t hl = roundUp ((l + 1) / 2), hn = roundUp ((n + 1) / 2);
+
+			Matrix A11 (field (), hm, hl), A12 (field (), hm, hl), A21 (field (), hm, hl), A22 (field (), hm, hl);
+			Matrix B11 (field (), hl, hn), B12 (field (), hl, hn), B21 (field (), hl, hn), B22 (field (), hl, hn);
+			extract (A11, A, 0, 0);   extract (A12, A, 0, hl);
+			extract (A21, A, hm, 0);  extract (A22, A, hm, hl);
+			extract (B11, B, 0, 0);   extract (B12, B, 0, hn);
+			extract (B21, B, hl, 0);  extract (B22, B, hl, hn);
+
+			// over GF(2) additions and subtractions are the same
+			Matrix S1 (A21); addin (S1, A22);
+			Matrix S2 (S1);  addin (S2, A11);
+			Matrix S3 (A11); addin (S3, A21);
+			Matrix S4 (A12); addin (S4, S2);
+			Matrix T1 (B12); addin (T1, B11);
+			Matrix T2 (B22); addin (T2, T1);
+			Matrix T3 (B22); addin (T3, B12);
+			Matrix T4 (T2);  addin (T4, B21);
+
+			Matrix P1 (field (), hm, hn), P (field (), hm, hn), U2 (field (), hm, hn);
+			mul (P1, A11, B11);
+			// C11 = P1 + P2
+			mul (P, A12, B21); addin (P, P1); insertAdd (C, P, 0, 0);
+			// U2 = P1 + P6, U3 = U2 + P7, U4 = U2 + P5
+			mul (U2, S2, T2); addin (U2, P1);
+			Matrix U3 (U2), P5 (field (), hm, hn);
+			mul (P, S3, T3); addin (U3, P);
+			mul (P5, S1, T1);
+			// C22 = U3 + P5
+			Matrix U (U3); addin (U, P5); insertAdd (C, U, hm, hn);
+			// C12 = U4 + P3
+			U = U2; addin (U, P5);
+			mul (P, S4, B22); addin (U, P); insertAdd (C, U, 0, hn);
+			// C21 = U3 - P4
+			mul (P, A22, T4); addin (U3, P); insertAdd (C, U3, hm, 0);
+			return C;
+		}
+
+		/** PLE decomposition \f$A = P L E\f$, in place.
+		 *
+		 * On return, with \f$r\f$ the rank: rows \f$0..r-1\f$ of \p A hold
+		 * the echelon form \f$E\f$ in the columns \f$\geq Q[i]\f$ of row
+		 * \f$i\f$ (\f$E_{i,Q[i]} = 1\f$), and the unit lower triangular
+		 * \f$L\f$ is stored below, \f$L_{i,j} = A_{i,Q[j]}\f$ for \f$i > j\f$.
+		 * Row \f$i\f$ was exchanged with row \f$P[i] \geq i\f$ at step \f$i\f$
+		 * (LAPACK convention).
+		 * @returns the rank
+		 */
+		size_t ple (Matrix &A, std::vector<size_t> &P, std::vector<size_t> &Q) const
+		{
+			const size_t m = A.rowdim (), n = A.coldim (), w = A.rowstride ();
+			P.clear (); Q.clear ();
+			size_t r = 0;
+			for (size_t c = 0; c < n && r < m; ++c) {
+				size_t i = r;
+				while (i < m && !A.getEntry (i, c)) ++i;
+				if (i == m) continue;
+				A.swapRows (r, i);
+				P.push_back (i);
+				Q.push_back (c);
+
+				// eliminate the bits right of the pivot, keeping the
+				// multiplier (the pivot column) as the entry of L
+				const size_t w0 = c / Matrix::WordBits, b = c % Matrix::WordBits;
+				const Word high = (b == Matrix::WordBits - 1) ? Word (0) : ~((Word (2) << b) - 1);
+				const Word *pr = A.row (r);
+				for (size_t k = r + 1; k < m; ++k) {
+					if (!A.getEntry (k, c)) continue;
+					Word *rk = A.row (k);
+					rk[w0] ^= pr[w0] & high;
+					for (size_t t = w0 + 1; t < w; ++t)
+						rk[t] ^= pr[t];
+				}
+				++r;
+			}
+			return r;
+		}
+
+		/** Row echelon form by the M4RI algorithm, in place.
+		 *
+		 * Columns are processed K at a time: up to K pivots are found and
+		 * reduced against each other, then all the other rows are reduced
+		 * with one lookup in the Gray code table of the pivot rows.
+		 * @param A matrix, replaced by its (reduced) row echelon form
+		 * @param pivots columns of the pivots of rows \f$0..r-1\f$
+		 * @param reduced if true, the reduced row echelon form
+		 * @param ncols pivots are only searched in the first \p ncols columns
+		 * @returns the rank \f$r\f$ of the first \p ncols columns
+		 */
+		size_t echelonize (Matrix &A, std::vector<size_t> &pivots, bool reduced = true,
+				   size_t ncols = (size_t)-1) const
+		{
+			const size_t m = A.rowdim (), w = A.rowstride ();
+			ncols = std::min (ncols, A.coldim ());
+			pivots.clear ();
+			std::vector<Word> T;
+			size_t pc[K];
+			size_t r = 0;
+
+			for (size_t c = 0; c < ncols && r < m; c += K) {
+				const size_t kk = (ncols - c < K) ? ncols - c : K;
+				const size_t w0 = c / Matrix::WordBits;
+				size_t found = 0;
+
+				// pivots of the panel, rows reduced only as far as needed
+				for (size_t j = c; j < c + kk && r + found < m; ++j)
+					for (size_t i = r + found; i < m; ++i) {
+						for (size_t t = 0; t < found; ++t)
+							if (A.getEntry (i, pc[t]))
+								A.addRow (i, r + t, w0);
+						if (A.getEntry (i, j)) {
+							A.swapRows (i, r + found);
+							pc[found++] = j;
+							break;
+						}
+					}
+				if (found == 0)
+					continue;
+
+				// identity on the pivot columns of the pivot rows
+				for (size_t t = found; t-- > 0; )
+					for (size_t s = 0; s < t; ++s)
+						if (A.getEntry (r + s, pc[t]))
+							A.addRow (r + s, r + t, w0);
+
+				const size_t ww = w - w0;
+				T.resize ((size_t (1) << found) * ww);
+				std::fill (T.begin (), T.begin () + ww, Word (0));
+				for (size_t g = 1; g < (size_t (1) << found); ++g) {
+					const size_t cur = g ^ (g >> 1), prev = (g - 1) ^ ((g - 1) >> 1);
+					size_t bit = 0;
+					while (!((g >> bit) & 1)) ++bit;
+					const Word *src = A.row (r + bit) + w0;
+					for (size_t s = 0; s < ww; ++s)
+						T[cur * ww + s] = T[prev * ww + s] ^ src[s];
+				}
+
+				for (size_t i = reduced ? 0 : r + found; i < m; ++i) {
+					if (i >= r && i < r + found) continue;
+					size_t idx = 0;
+					for (size_t t = 0; t < found; ++t)
+						idx |= size_t (A.getEntry (i, pc[t])) << t;
+					if (!idx) continue;
+					Word *ri = A.row (i) + w0;
+					const Word *tr = &T[idx * ww];
+					for (size_t s = 0; s < ww; ++s)
+						ri[s] ^= tr[s];
+				}
+
+				for (size_t t = 0; t < found; ++t)
+					pivots.push_back (pc[t]);
+				r += found;
+			}
+			return r;
+		}
+
+		size_t rank (const Matrix &A) const
+		{
+			Matrix B (A);
+			return rankin (B);
+		}
+
+		//! rank, the matrix is modified
+		size_t rankin (Matrix &A) const
+		{
+			std::vector<size_t> piv;
+			return echelonize (A, piv, false);
+		}
+
+		bool det (const Matrix &A) const
+		{
+			linbox_check (A.rowdim () == A.coldim ());
+			return rank (A) == A.rowdim ();
+		}
+
+		/** Inverse of a square matrix by echelonizing \f$[A | I]\f$.
+		 * @returns the nullity of \p A, 0 iff \p Ainv was computed
+		 */
+		int inv (Matrix &Ainv, const Matrix &A) const
+		{
+			linbox_check (A.rowdim () == A.coldim ());
+			const size_t n = A.rowdim ();
+			Matrix Aug (field (), n, 2 * n), I (field (), n, n);
+			I.identity ();
+			insertAdd (Aug, A, 0, 0);
+			insertAdd (Aug, I, 0, n);
+			std::vector<size_t> piv;
+			const size_t r = echelonize (Aug, piv, true, n);
+			if (r < n)
+				return (int) (n - r);
+			Ainv.init (n, n);
+			extract (Ainv, Aug, 0, n);
+			return 0;
+		}
+
+		/** Some solution of \f$AX = B\f$.
+		 * @returns false if the system is inconsistent (X is then undefined)
+		 */
+		bool solve (Matrix &X, const Matrix &A, const Matrix &B) const
+		{
+			linbox_check (A.rowdim () == B.rowdim ());
+			const size_t m = A.rowdim (), n = A.coldim (), k = B.coldim ();
+			Matrix Aug (field (), m, n + k);
+			insertAdd (Aug, A, 0, 0);
+			insertAdd (Aug, B, 0, n);
+			std::vector<size_t> piv;
+			const size_t r = echelonize (Aug, piv, true, n);
+
+			Matrix R (field (), m, k);
+			extract (R, Aug, 0, n);
+			for (size_t i = r; i < m; ++i)
+				for (size_t t = 0; t < R.rowstride (); ++t)
+					if (R.row (i)[t]) return false;
+
+			X.init (n, k);
+			for (size_t i = 0; i < r; ++i)
+				std::copy (R.row (i), R.row (i) + R.rowstride (), X.row (piv[i]));
+			return true;
+		}
+
+		/** Basis of the right nullspace of \p A, as the columns of \p N.
+		 * @returns the nullity
+		 */
+		size_t nullspace (Matrix &N, const Matrix &A) const
+		{
+			const size_t n = A.coldim ();
+			Matrix E (A);
+			std::vector<size_t> piv;
+			const size_t r = echelonize (E, piv, true);
+
+			std::vector<bool> isPivot (n, false);
+			for (size_t t = 0; t < r; ++t)
+				isPivot[piv[t]] = true;
+
+			N.init (n, n - r);
+			size_t s = 0;
+			for (size_t f = 0; f < n; ++f) {
+				if (isPivot[f]) continue;
+				N.setEntry (f, s, true);
+				for (size_t t = 0; t < r; ++t)
+					if (E.getEntry (t, f))
+						N.setEntry (piv[t], s, true);
+				++s;
+			}
+			return n - r;
+		}
+
+		/** D = A[r0.., c0..], clipped to the dimensions of D, zero padded
+		 * beyond those of A.
+		 */
+		static void extract (Matrix &D, const Matrix &A, size_t r0, size_t c0)
+		{
+			D.zero ();
+			const size_t wa = A.rowstride (), wd = D.rowstride ();
+			const size_t q = c0 / Matrix::WordBits, sh = c0 % Matrix::WordBits;
+			const Word mask = D.lastMask ();
+			for (size_t i = 0; i < D.rowdim () && r0 + i < A.rowdim (); ++i) {
+				const Word *a = A.row (r0 + i);
+				Word *d = D.row (i);
+				for (size_t t = 0; t < wd && q + t < wa; ++t) {
+					Word v = a[q + t] >> sh;
+					if (sh && q + t + 1 < wa)
+						v |= a[q + t + 1] << (Matrix::WordBits - sh);
+					d[t] = v;
+				}
+				if (wd) d[wd - 1] &= mask;
+			}
+		}
+
+		/** C[r0.., c0..] += A, the parts of A outside C being zero.
+		 */
+		static void insertAdd (Matrix &C, const Matrix &A, size_t r0, size_t c0)
+		{
+			const size_t wa = A.rowstride (), wc = C.rowstride ();
+			const size_t q = c0 / Matrix::WordBits, sh = c0 % Matrix::WordBits;
+			for (size_t i = 0; i < A.rowdim () && r0 + i < C.rowdim (); ++i) {
+				const Word *a = A.row (i);
+				Word *c = C.row (r0 + i);
+				for (size_t t = 0; t < wa && q + t < wc; ++t) {
+					c[q + t] ^= a[t] << sh;
+					if (sh && q + t + 1 < wc)
+						c[q + t + 1] ^= a[t] >> (Matrix::WordBits - sh);
+				}
+			}
+		}
+
+	protected:
+
+		static size_t roundUp (size_t x)
+		{
+			return (x + Matrix::WordBits - 1) / Matrix::WordBits * Matrix::WordBits;
+		}
+
+		// T[g] = sum of the rows k0+t of B for the bits t of g, on words [c0, c0+ww)
+		static void grayTable (std::vector<Word> &T, const Matrix &B, size_t k0, size_t kk,
+				       size_t c0, size_t ww)
+		{
+			std::fill (T.begin (), T.begin () + ww, Word (0));
+			for (size_t g = 1; g < (size_t (1) << kk); ++g) {
+				const size_t cur = g ^ (g >> 1), prev = (g - 1) ^ ((g - 1) >> 1);
+				size_t bit = 0;
+				while (!((g >> bit) & 1)) ++bit;
+				const Word *src = B.row (k0 + bit) + c0;
+				for (size_t s = 0; s < ww; ++s)
+					T[cur * ww + s] = T[prev * ww + s] ^ src[s];
+			}
+		}
+
+		const GF2 *_field;
+		size_t    _cutoff;
+	};
+
+	/*! @internal BlasMatrixDomain operations on M4RIMatrix */
+	//@{
+	template <>
+	class BlasMatrixDomainMul<GF2, M4RIMatrix, M4RIMatrix, M4RIMatrix> {
+	public:
+		M4RIMatrix &operator() (const GF2 &F, M4RIMatrix &C, const M4RIMatrix &A, const M4RIMatrix &B) const
+		{
+			return M4RIMatrixDomain (F).mul (C, A, B);
+		}
+	};
+
+	template <>
+	class BlasMatrixDomainMulAdd<M4RIMatrix, M4RIMatrix, M4RIMatrix> {
+	public:
+		//! D = beta C + alpha A B
+		M4RIMatrix &operator() (M4RIMatrix &D, const bool &beta, const M4RIMatrix &C,
+					const bool &alpha, const M4RIMatrix &A, const M4RIMatrix &B) const
+		{
+			if (beta) D = C;
+			else D.init (C.rowdim (), C.coldim ());
+			return (*this) (true, D, alpha, A, B);
+		}
+
+		//! C = beta C + alpha A B
+		M4RIMatrix &operator() (const bool &beta, M4RIMatrix &C,
+					const bool &alpha, const M4RIMatrix &A, const M4RIMatrix &B) const
+		{
+			if (!beta) C.zero ();
+			if (alpha) M4RIMatrixDomain (C.field ()).axpyin (C, A, B);
+			return C;
+		}
+	};
+
+	template <>
+	class BlasMatrixDomainAddin<GF2, M4RIMatrix, M4RIMatrix> {
+	public:
+		M4RIMatrix &operator() (const GF2 &F, M4RIMatrix &C, const M4RIMatrix &A) const
+		{
+			return M4RIMatrixDomain (F).addin (C, A);
+		}
+	};
+
+	template <>
+	class BlasMatrixDomainRank<GF2, M4RIMatrix> {
+	public:
+		unsigned int operator() (const GF2 &F, const M4RIMatrix &A) const
+		{
+			return (unsigned int) M4RIMatrixDomain (F).rank (A);
+		}
+		unsigned int operator() (const GF2 &F, M4RIMatrix &A) const
+		{
+			return (unsigned int) M4RIMatrixDomain (F).rankin (A);
+		}
+	};
+
+	template <>
+	class BlasMatrixDomainDet<GF2, M4RIMatrix> {
+	public:
+		bool operator() (const GF2 &F, const M4RIMatrix &A) const
+		{
+			return M4RIMatrixDomain (F).det (A);
+		}
+		bool operator() (const GF2 &F, M4RIMatrix &A) const
+		{
+			linbox_check (A.rowdim () == A.coldim ());
+			return M4RIMatrixDomain (F).rankin (A) == A.rowdim ();
+		}
+	};
+
+	template <>
+	class BlasMatrixDomainInv<GF2, M4RIMatrix, M4RIMatrix> {
+	public:
+		int operator() (const GF2 &F, M4RIMatrix &Ainv, const M4RIMatrix &A) const
+		{
+			return M4RIMatrixDomain (F).inv (Ainv, A);
+		}
+		int operator() (const GF2 &F, M4RIMatrix &Ainv, M4RIMatrix &A) const
+		{
+			return M4RIMatrixDomain (F).inv (Ainv, A);
+		}
+	};
+
+	template <>
+	class BlasMatrixDomainLeftSolve<GF2, M4RIMatrix, M4RIMatrix, M4RIMatrix> {
+	public:
+		//! AX = B, throws LinboxMathInconsistentSystem if there is no solution
+		M4RIMatrix &operator() (const GF2 &F, M4RIMatrix &X, const M4RIMatrix &A, const M4RIMatrix &B) const
+		{
+			if (!M4RIMatrixDomain (F).solve (X, A, B))
+				throw LinboxMathInconsistentSystem ("M4RIMatrixDomain: inconsistent system");
+			return X;
+		}
+		M4RIMatrix &operator() (const GF2 &F, const M4RIMatrix &A, M4RIMatrix &B) const
+		{
+			M4RIMatrix X (F, A.coldim (), B.coldim ());
+			(*this) (F, X, A, B);
+			B = X;
+			return B;
+		}
+	};
+	//@}
+
+}
+
+#endif // __LINBOX_matrix_matrixdomain_matrix_domain_m4ri_H
+
+// Local Variables:
+// mode: C++
+// tab-width: 4
+// indent-tabs-mode: nil
+// c-basic-offset: 4
+// End:
+// vim:sts=4:sw=4:ts=4:et:sr:cino=>s,f0,{0,g0,(0,\:0,t0,+0,=s
@@ -126,7 +126,7 @@ public:
 
 	//  comparison ops
 	bool operator==(const SlicedBase &rhs){
-		return b0 == rhs.bo && b1 == rhs.b1;
+		return b0 == rhs.b0 && b1 == rhs.b1;
 	}
 
 	//  used for combining two units
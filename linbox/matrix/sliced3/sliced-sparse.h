@@ -0,0 +1,305 @@
+/* linbox/matrix/sliced3/sliced-sparse.h
+ *
+ * ========LICENCE========
+ * This file is part of the library LinBox.
+ *
+ * LinBox is free software: you can redistribute it and/or modify
+ * it under the terms of the  GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ * ========LICENCE========
+ */
+
+/*! @file matrix/sliced3/sliced-sparse.h
+ * @ingroup matrix
+ * @brief Sparse GF(3) matrices applied to bit-sliced blocks of vectors.
+ *
+ * A block of vectors over GF(3) is packed by rows: entry \f$(k,j)\f$ is
+ * bit \f$j \bmod w\f$ of the SlicedBase unit \f$j / w\f$ of row \f$k\f$,
+ * \f$w\f$ being the word size.  Row \f$i\f$ of \f$A X\f$ is then a sum of
+ * rows of \f$X\f$, one sliced addition per nonzero entry of \f$A\f$ and
+ * per word: a 64 columns block costs the same number of word operations
+ * as one scalar sparse matrix-vector product.
+ */
+
+#ifndef __LINBOX_matrix_sliced3_sliced_sparse_H
+#define __LINBOX_matrix_sliced3_sliced_sparse_H
+
+#include <vector>
+#include <algorithm>
+#include <cstdint>
+
+#include "linbox/linbox-config.h"
+#include "linbox/util/debug.h"
+#include "linbox/util/error.h"
+#include "linbox/matrix/sparse-matrix.h"
+#include "linbox/matrix/dense-matrix.h"
+#include "linbox/matrix/sliced3/dense-sliced.h"
+
+namespace LinBox
+{
+
+	/** @brief Row packed block of GF(3) vectors.
+	 * \ingroup matrix
+	 *
+	 * Each row holds \c coldim() entries in \c words() SlicedBase units;
+	 * the bits past \c coldim() in the last unit are kept to zero.
+	 */
+	template <class WordT = uint64_t>
+	class SlicedBlock {
+	public:
+		typedef SlicedBase<WordT> Unit;
+		static const size_t bits = 8 * sizeof (WordT);
+
+		SlicedBlock (size_t m = 0, size_t n = 0)
+		{
+			resize (m, n);
+		}
+
+		void resize (size_t m, size_t n)
+		{
+			_rownb = m;
+			_colnb = n;
+			_words = (n + bits - 1) / bits;
+			Unit z; z.zero ();
+			_rep.assign (_rownb * _words, z);
+		}
+
+		size_t rowdim () const { return _rownb; }
+		size_t coldim () const { return _colnb; }
+		size_t words () const { return _words; }
+
+		Unit *row (size_t i) { return &_rep[i * _words]; }
+		const Unit *row (size_t i) const { return &_rep[i * _words]; }
+
+		void zero ()
+		{
+			for (size_t k = 0; k < _rep.size (); ++k)
+				_rep[k].zero ();
+		}
+
+		//! entry (i,j) as 0, 1 or 2
+		unsigned getEntry (size_t i, size_t j) const
+		{
+			const Unit &u = row (i)[j / bits];
+			const size_t s = j % bits;
+			return (unsigned)((u.b0 >> s) & 1) + (unsigned)((u.b1 >> s) & 1);
+		}
+
+		//! sets entry (i,j) to v mod 3
+		void setEntry (size_t i, size_t j, unsigned v)
+		{
+			Unit &u = row (i)[j / bits];
+			const WordT m = (WordT)1 << (j % bits);
+			u.b0 &= ~m;
+			u.b1 &= ~m;
+			v %= 3;
+			if (v) u.b0 |= m;
+			if (v == 2) u.b1 |= m;
+		}
+
+		//! packs a dense matrix over a field of characteristic 3
+		template <class Field>
+		SlicedBlock &load (const BlasMatrix<Field> &X)
+		{
+			const Field &F = X.field ();
+			resize (X.rowdim (), X.coldim ());
+			for (size_t i = 0; i < _rownb; ++i)
+				for (size_t j = 0; j < _colnb; ++j) {
+					const typename Field::Element &e = X.getEntry (i, j);
+					if (!F.isZero (e))
+						setEntry (i, j, F.isOne (e) ? 1U : 2U);
+				}
+			return *this;
+		}
+
+		//! unpacks into X, of the same dimensions
+		template <class Field>
+		BlasMatrix<Field> &unload (BlasMatrix<Field> &X) const
+		{
+			const Field &F = X.field ();
+			linbox_check (X.rowdim () == _rownb && X.coldim () == _colnb);
+			for (size_t i = 0; i < _rownb; ++i)
+				for (size_t j = 0; j < _colnb; ++j)
+					switch (getEntry (i, j)) {
+					case 0 : X.setEntry (i, j, F.zero); break;
+					case 1 : X.setEntry (i, j, F.one); break;
+					default : X.setEntry (i, j, F.mOne); break;
+					}
+			return X;
+		}
+
+		void swap (SlicedBlock &B)
+		{
+			std::swap (_rownb, B._rownb);
+			std::swap (_colnb, B._colnb);
+			std::swap (_words, B._words);
+			_rep.swap (B._rep);
+		}
+
+	protected:
+		size_t                 _rownb;
+		size_t                 _colnb;
+		size_t                 _words;
+		std::vector<Unit>        _rep;
+	};
+
+	/** @brief Sparse matrix over GF(3) acting on sliced blocks.
+	 * \ingroup matrix
+	 *
+	 * Only the positions are stored, row by row, the entries equal to 1
+	 * before the entries equal to 2: row \f$i\f$ of \f$A X\f$ is
+	 * \f$2 \sum X_j + \sum X_k\f$, one sliced addition per entry and one
+	 * negation per row and word.
+	 *
+	 * It is built from a CSR or COO SparseMatrix, or from a dense
+	 * BlasMatrix (a projection block), over any representation of GF(3).
+	 */
+	template <class WordT = uint64_t>
+	class SlicedSparseMatrix {
+	public:
+		typedef SlicedBase<WordT>         Unit;
+		typedef SlicedBlock<WordT>       Block;
+
+		SlicedSparseMatrix () :
+			_rownb (0), _colnb (0), _start (1, 0)
+		{}
+
+		template <class Field>
+		SlicedSparseMatrix (const SparseMatrix<Field, SparseMatrixFormat::CSR> &A)
+		{
+			std::vector<Entry> t;
+			t.reserve (A.size ());
+			for (size_t i = 0; i < A.rowdim (); ++i)
+				for (size_t k = A.getStart (i); k < A.getEnd (i); ++k)
+					add (t, A.field (), i, A.getColid (k), A.getData (k));
+			build (A.field (), A.rowdim (), A.coldim (), t);
+		}
+
+		template <class Field>
+		SlicedSparseMatrix (const SparseMatrix<Field, SparseMatrixFormat::COO> &A)
+		{
+			std::vector<Entry> t;
+			t.reserve (A.size ());
+			for (size_t k = 0; k < A.size (); ++k)
+				add (t, A.field (), A.getRowid (k), A.getColid (k), A.getData (k));
+			build (A.field (), A.rowdim (), A.coldim (), t);
+		}
+
+		template <class Field>
+		SlicedSparseMatrix (const BlasMatrix<Field> &A)
+		{
+			std::vector<Entry> t;
+			for (size_t i = 0; i < A.rowdim (); ++i)
+				for (size_t j = 0; j < A.coldim (); ++j)
+					add (t, A.field (), i, j, A.getEntry (i, j));
+			build (A.field (), A.rowdim (), A.coldim (), t);
+		}
+
+		size_t rowdim () const { return _rownb; }
+		size_t coldim () const { return _colnb; }
+		size_t size () const { return _colid.size (); }
+
+		/** Y = A X.
+		 * Y must not share storage with X; it is resized if needed.
+		 */
+		Block &apply (Block &Y, const Block &X) const
+		{
+			linbox_check (X.rowdim () == _colnb);
+			if (Y.rowdim () != _rownb || Y.coldim () != X.coldim ())
+				Y.resize (_rownb, X.coldim ());
+			const size_t W = X.words ();
+
+#ifdef __LINBOX_USE_OPENMP
+#pragma omp parallel for schedule (dynamic, 256)
+#endif
+			for (long li = 0; li < (long)_rownb; ++li) {
+				const size_t i = (size_t)li;
+				Unit *y = Y.row (i);
+				for (size_t w = 0; w < W; ++w)
+					y[w].zero ();
+				for (size_t k = _mid[i]; k < _start[i+1]; ++k) {
+					const Unit *x = X.row (_colid[k]);
+					for (size_t w = 0; w < W; ++w)
+						y[w] += x[w];
+				}
+				if (_mid[i] != _start[i+1])
+					for (size_t w = 0; w < W; ++w)
+						y[w] *= 2;
+				for (size_t k = _start[i]; k < _mid[i]; ++k) {
+					const Unit *x = X.row (_colid[k]);
+					for (size_t w = 0; w < W; ++w)
+						y[w] += x[w];
+				}
+			}
+			return Y;
+		}
+
+	protected:
+		struct Entry {
+			size_t i, j;
+			bool two;
+		};
+
+		template <class Field>
+		static void add (std::vector<Entry> &t, const Field &F,
+				 size_t i, size_t j, const typename Field::Element &e)
+		{
+			if (F.isZero (e)) return;
+			Entry x = { i, j, !F.isOne (e) };
+			t.push_back (x);
+		}
+
+		// counting sort of the entries by row, ones before twos
+		template <class Field>
+		void build (const Field &F, size_t m, size_t n, const std::vector<Entry> &t)
+		{
+			if (F.characteristic () != 3)
+				throw LinBoxError ("SlicedSparseMatrix: the field is not GF(3)");
+			_rownb = m;
+			_colnb = n;
+			_start.assign (m + 1, 0);
+			_mid.assign (m, 0);
+			for (size_t k = 0; k < t.size (); ++k) {
+				++_start[t[k].i + 1];
+				if (!t[k].two) ++_mid[t[k].i];
+			}
+			for (size_t i = 0; i < m; ++i) {
+				_start[i+1] += _start[i];
+				_mid[i] += _start[i];
+			}
+			std::vector<size_t> one (_start.begin (), _start.end () - 1), two (_mid);
+			_colid.resize (t.size ());
+			for (size_t k = 0; k < t.size (); ++k) {
+				linbox_check (t[k].j < n);
+				_colid[t[k].two ? two[t[k].i]++ : one[t[k].i]++] = t[k].j;
+			}
+		}
+
+		size_t                   _rownb;
+		size_t                   _colnb;
+		std::vector<size_t>      _start; // row i: [_start[i], _start[i+1])
+		std::vector<size_t>        _mid; // first entry equal to 2 of row i
+		std::vector<size_t>      _colid;
+	};
+
+}
+
+#endif // __LINBOX_matrix_sliced3_sliced_sparse_H
+
+// Local Variables:
+// mode: C++
+// tab-width: 4
+// indent-tabs-mode: nil
+// c-basic-offset: 4
+// End:
+// vim:sts=4:sw=4:ts=4:et:sr:cino=>s,f0,{0,g0,(0,\:0,t0,+0,=s
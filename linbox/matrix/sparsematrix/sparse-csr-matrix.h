@@ -880,6 +880,47 @@ namespace LinBox {
 			return applyTranspose(y,x,field().zero);
 		}
 
+		// Y = AX, block X traversed once per row of A
+		// (native block apply, see BlockApplyTraits)
+		template<class outBlock, class inBlock>
+		outBlock& applyBlock(outBlock &Y, const inBlock& X) const
+		{
+			linbox_check(Y.rowdim() == _rownb && X.rowdim() == _colnb);
+			linbox_check(Y.coldim() == X.coldim());
+			const size_t s = X.coldim();
+			const FieldAXPY<Field> accu0(field());
+			std::vector<FieldAXPY<Field> > accu(s, accu0);
+			for (size_t i = 0 ; i < _rownb ; ++i) {
+				for (size_t j = 0 ; j < s ; ++j)
+					accu[j].reset();
+				for (index_t k = _start[i] ; k < _start[i+1] ; ++k)
+					for (size_t j = 0 ; j < s ; ++j)
+						accu[j].mulacc(_data[k],X.getEntry(_colid[k],j));
+				for (size_t j = 0 ; j < s ; ++j)
+					accu[j].get(Y.refEntry(i,j));
+			}
+			return Y;
+		}
+
+		// Y = A^t X, rows of A scattered into the rows of Y
+		template<class outBlock, class inBlock>
+		outBlock& applyTransposeBlock(outBlock &Y, const inBlock& X) const
+		{
+			linbox_check(Y.rowdim() == _colnb && X.rowdim() == _rownb);
+			linbox_check(Y.coldim() == X.coldim());
+			const size_t s = X.coldim();
+			const FieldAXPY<Field> accu0(field());
+			std::vector<FieldAXPY<Field> > accu(_colnb*s, accu0);
+			for (size_t i = 0 ; i < _rownb ; ++i)
+				for (index_t k = _start[i] ; k < _start[i+1] ; ++k)
+					for (size_t j = 0 ; j < s ; ++j)
+						accu[_colid[k]*s+j].mulacc(_data[k],X.getEntry(i,j));
+			for (size_t i = 0 ; i < _colnb ; ++i)
+				for (size_t j = 0 ; j < s ; ++j)
+					accu[i*s+j].get(Y.refEntry(i,j));
+			return Y;
+		}
+
 		const Field & field()  const
 		{
 			return _field ;
@@ -288,6 +288,11 @@ class SparseMatrix<Field_, SparseMatrixFormat::TPL_omp> : public BlackboxInterfa
 	template<class Mat1, class Mat2>
 	Mat1 & applyRight(Mat1 &Y, const Mat2 &X) const;
 
+        // Native block apply for BlockApplyTraits: Y <- AX.
+	template<class Mat1, class Mat2>
+	Mat1 & applyBlock(Mat1 &Y, const Mat2 &X) const
+	{ return applyLeft(Y, X); }
+
 	/** y <- A^T x.
 	 */
 	template<class OutVector, class InVector>
@@ -116,6 +116,11 @@ namespace LinBox
 	Mat1 & applyRight(Mat1 &Y, const Mat2 &X) const;
 	//Matrix & applyRight(Matrix &Y, const Matrix &X) const;
 
+	/// Native block apply for BlockApplyTraits: Y <- AX.
+	template<class Mat1, class Mat2>
+	Mat1 & applyBlock(Mat1 &Y, const Mat2 &X) const
+	{ return applyLeft(Y, X); }
+
 	/** y <- A x.
 	 *
 	 *  Performance will generally be best if A is in cacheOpt order,
@@ -33,6 +33,7 @@
 #include "linbox/blackbox/diagonal.h"
 #include "linbox/blackbox/compose.h"
 #include "linbox/solutions/methods.h"
+#include "linbox/solutions/hybrid-dispatch.h"
 #include "linbox/solutions/getentry.h"
 #include "linbox/vector/blas-vector.h"
 
@@ -123,13 +124,17 @@ namespace LinBox
 						const RingCategories::ModularTag	&tag,
 						const Method::Hybrid			&Meth)
 	{
-		// not yet a hybrid
-
-		if (useBB(A))
+		const bool blas = hybridBlasField(A.field());
+		switch (hybridChoice(A, true, blas).path) {
+		case HybridDecision::BLACKBOX:
 			return det(d, A, tag, Method::Blackbox(Meth));
-		else
-
+		case HybridDecision::SPARSE_ELIMINATION:
+			return det(d, A, tag, Method::SparseElimination(Meth));
+		default:
+			if (blas)
+				return det(d, A, tag, Method::BlasElimination(Meth));
 			return det(d, A, tag, Method::Elimination(Meth));
+		}
 	}
 	template<class Blackbox>
 	typename Blackbox::Field::Element &detin (typename Blackbox::Field::Element	&d,
@@ -609,6 +614,7 @@ namespace LinBox
 #include "linbox/algorithms/rational-cra2.h"
 #include "linbox/algorithms/varprec-cra-early-single.h"
 #include "linbox/algorithms/det-rational.h"
+#include "linbox/algorithms/multimod-wiedemann.h"
 namespace LinBox
 {
 
@@ -623,6 +629,55 @@ namespace LinBox
 		return SOLUTION_CRA_DET(d, A, tag, Meth);
 	}
 
+#if !defined(__LINBOX_HAVE_MPI) && !defined(__LINBOX_HAVE_KAAPI)
+	namespace Protected {
+		/*! @internal Integer determinant of a sparse matrix by Wiedemann,
+		 * reading the matrix once per step for LINBOX_MULTIMOD_SPMV_PRIMES
+		 * primes (see MultiModSparseMatrix).
+		 */
+		template <class Ring, class Fmt, class MyMethod>
+		typename Ring::Element &detMultiMod (typename Ring::Element                    &d,
+						     const SparseMatrix<Ring, Fmt>             &A,
+						     const MyMethod                            &Meth)
+		{
+			if (A.coldim() != A.rowdim())
+				throw LinboxError("LinBox ERROR: matrix must be square for determinant computation\n");
+			MultiModSparseMatrix B (A);
+			if (A.rowdim() == 0 || ! B.fits())
+				return cra_det (d, A, RingCategories::IntegerTag(), Meth);
+
+			commentator().start ("Integer Determinant, multi-modulus", "idet");
+			typedef Givaro::ModularBalanced<double> Field;
+			PrimeIterator<IteratorCategories::HeuristicTag> genprime(std::min (UINT64_C(31), FieldTraits<Field>::bestBitSize(A.coldim())));
+			MultiModDet iteration (B, Meth.earlyTermThreshold(), Meth.seed());
+			ChineseRemainder< EarlySingleCRA< Field > > cra(4UL);
+			integer dd;
+			cra.batch (dd, iteration, genprime, LINBOX_MULTIMOD_SPMV_PRIMES);
+			A.field().init(d, dd);
+			commentator().stop ("done", NULL, "idet");
+			return d;
+		}
+	}
+
+	template <class Ring, class Fmt>
+	typename Ring::Element &det (typename Ring::Element                    &d,
+				     const SparseMatrix<Ring, Fmt>             &A,
+				     const RingCategories::IntegerTag          &tag,
+				     const Method::Wiedemann                   &Meth)
+	{
+		return Protected::detMultiMod (d, A, Meth);
+	}
+
+	template <class Ring, class Fmt>
+	typename Ring::Element &det (typename Ring::Element                    &d,
+				     const SparseMatrix<Ring, Fmt>             &A,
+				     const RingCategories::IntegerTag          &tag,
+				     const Method::Blackbox                    &Meth)
+	{
+		return Protected::detMultiMod (d, A, Meth);
+	}
+#endif
+
 	template< class Blackbox, class MyMethod>
 	typename Blackbox::Field::Element &det (typename Blackbox::Field::Element         &d,
 						const Blackbox                            &A,
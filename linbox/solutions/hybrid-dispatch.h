@@ -0,0 +1,616 @@
+/* linbox/solutions/hybrid-dispatch.h
+ *
+ * ========LICENCE========
+ * This file is part of the library LinBox.
+ *
+ * LinBox is free software: you can redistribute it and/or modify
+ * it under the terms of the  GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ * ========LICENCE========
+ */
+
+/*! @file solutions/hybrid-dispatch.h
+ * @ingroup solutions
+ * @brief Cost model behind Method::Hybrid.
+ *
+ * The Hybrid solutions (rank, det, solve) choose between a blackbox
+ * method (Wiedemann), sparse elimination and dense BLAS elimination by
+ * estimating the time of each:
+ *  - Wiedemann: \f$2r\f$ applies of \f$A\f$ and as many dot products,
+ *    \f$c_w \cdot 2r (\nu + m + n)\f$ for \f$\nu\f$ nonzero entries and
+ *    \f$r = \min(m,n)\f$;
+ *  - sparse elimination: \f$c_e\f$ per update predicted by a symbolic
+ *    Markowitz elimination of the sparsity pattern, or by a simulation
+ *    on the row and column counts when the pattern cannot be read;
+ *  - dense elimination: \f$c_b \cdot m n r^{\omega-2}\f$ plus
+ *    \f$c_v\f$ per entry for the conversion to a BlasMatrix.
+ *
+ * The constants are machine dependent.  They are read once from the
+ * file named by the environment variable \c LINBOX_HYBRID_COSTS, or
+ * else from \c $HOME/.linbox-hybrid-costs, which is written by the
+ * calibration benchmark \c benchmarks/benchmark-hybrid-calibrate.C;
+ * built-in values are used when there is no such file.
+ * HybridCosts::use() replaces them, e.g. with HybridCosts::forcing()
+ * to make Method::Hybrid take a given path.
+ *
+ * The last choice of the calling thread is kept in
+ * HybridDispatcher::last() and reported to the commentator.
+ */
+
+#ifndef __LINBOX_solutions_hybrid_dispatch_H
+#define __LINBOX_solutions_hybrid_dispatch_H
+
+#include <cmath>
+#include <cstdlib>
+#include <string>
+#include <fstream>
+#include <iostream>
+#include <algorithm>
+#include <chrono>
+#include <limits>
+#include <queue>
+#include <vector>
+#include <functional>
+
+#include "linbox/linbox-config.h"
+#include "linbox/util/commentator.h"
+#include "linbox/vector/blas-vector.h"
+#include "linbox/matrix/sparse-matrix.h"
+#include "linbox/matrix/dense-matrix.h"
+#include "linbox/solutions/methods.h"
+
+#ifndef LINBOX_HYBRID_SYMBOLIC_BUDGET
+//! row merges of the symbolic elimination, per nonzero entry, row and column
+#define LINBOX_HYBRID_SYMBOLIC_BUDGET 8
+#endif
+
+namespace LinBox
+{
+
+	/** @brief Outcome of the Method::Hybrid cost model.
+	 * \ingroup solutions
+	 */
+	struct HybridDecision {
+		enum Path { BLACKBOX, SPARSE_ELIMINATION, DENSE_ELIMINATION };
+
+		Path path;
+		size_t rowdim, coldim;
+		double nonzeros;   //!< known, or estimated from the time of one apply
+		double fill;       //!< predicted nonzero entries after sparse elimination
+		double wiedemann, sparse, dense; //!< estimated times, in seconds
+
+		HybridDecision () :
+			path(DENSE_ELIMINATION), rowdim(0), coldim(0), nonzeros(0), fill(0),
+			wiedemann(0), sparse(0), dense(0)
+		{}
+
+		const char *name () const
+		{
+			switch (path) {
+			case BLACKBOX:           return "blackbox";
+			case SPARSE_ELIMINATION: return "sparse elimination";
+			default:                 return "dense elimination";
+			}
+		}
+
+		std::ostream &write (std::ostream &os) const
+		{
+			return os << "Hybrid: " << name() << " for " << rowdim << "x" << coldim
+				  << " with " << nonzeros << " nonzeros (fill " << fill
+				  << "), estimated Wiedemann " << wiedemann
+				  << "s, sparse elimination " << sparse
+				  << "s, dense elimination " << dense << "s";
+		}
+	};
+
+	/** @brief Machine constants of the Method::Hybrid cost model.
+	 * \ingroup solutions
+	 *
+	 * All of them are in seconds.
+	 */
+	struct HybridCosts {
+		double wiedemann;   //!< per nonzero entry (or row) and per apply
+		double elimination; //!< per update of sparse elimination
+		double blas;        //!< per unit of \f$m n r^{\omega-2}\f$ of dense elimination
+		double conversion;  //!< per entry of a dense copy
+		double omega;       //!< exponent of dense elimination
+
+		//! Built-in values, for a recent x86_64 core.
+		static HybridCosts defaults ()
+		{
+			HybridCosts C;
+			C.wiedemann   = 2e-9;
+			C.elimination = 2e-8;
+			C.blas        = 2e-10;
+			C.conversion  = 5e-9;
+			C.omega       = 3.;
+			return C;
+		}
+
+		//! The cache file: \c $LINBOX_HYBRID_COSTS, else \c $HOME/.linbox-hybrid-costs
+		static std::string cacheFile ()
+		{
+			const char *f = std::getenv("LINBOX_HYBRID_COSTS");
+			if (f && *f)
+				return f;
+			const char *h = std::getenv("HOME");
+			return std::string(h ? h : ".") + "/.linbox-hybrid-costs";
+		}
+
+		/** Reads "name value" lines; unknown names are ignored.
+		 * @return false if nothing could be read.
+		 */
+		bool read (std::istream &is)
+		{
+			std::string name;
+			double v;
+			bool any = false;
+			while (is >> name >> v) {
+				if (!(v > 0)) continue;
+				if      (name == "wiedemann")   wiedemann   = v;
+				else if (name == "elimination") elimination = v;
+				else if (name == "blas")        blas        = v;
+				else if (name == "conversion")  conversion  = v;
+				else if (name == "omega")       omega       = std::max(2., std::min(3., v));
+				else continue;
+				any = true;
+			}
+			return any;
+		}
+
+		std::ostream &write (std::ostream &os) const
+		{
+			os.precision(6);
+			return os << "wiedemann "   << wiedemann   << std::endl
+				  << "elimination " << elimination << std::endl
+				  << "blas "        << blas        << std::endl
+				  << "conversion "  << conversion  << std::endl
+				  << "omega "       << omega       << std::endl;
+		}
+
+		bool save (const std::string &file = cacheFile()) const
+		{
+			std::ofstream os(file.c_str());
+			return os && write(os);
+		}
+
+		//! A constant of this value disables its path, unless nothing else is available.
+		static double disabled ()
+		{
+			return std::numeric_limits<double>::max();
+		}
+
+		/** Constants under which Method::Hybrid takes the path \p p
+		 * when it is available: the other paths are disabled.
+		 */
+		static HybridCosts forcing (HybridDecision::Path p)
+		{
+			HybridCosts C = defaults();
+			if (p != HybridDecision::BLACKBOX)
+				C.wiedemann = disabled();
+			if (p != HybridDecision::SPARSE_ELIMINATION)
+				C.elimination = disabled();
+			if (p != HybridDecision::DENSE_ELIMINATION)
+				C.blas = disabled();
+			return C;
+		}
+
+		//! The constants of the cache file, or the defaults.
+		static HybridCosts load (const std::string &file = cacheFile())
+		{
+			HybridCosts C = defaults();
+			std::ifstream is(file.c_str());
+			if (is)
+				C.read(is);
+			return C;
+		}
+
+		/** The constants of this machine, loaded from the cache file
+		 * on the first call.
+		 */
+		static const HybridCosts &machine ()
+		{
+			return current();
+		}
+
+		/** Replaces the constants of machine(), e.g. by forcing(p).
+		 * Not synchronized with concurrent Hybrid calls.
+		 */
+		static void use (const HybridCosts &C)
+		{
+			current() = C;
+		}
+
+	private:
+		static HybridCosts &current ()
+		{
+			static HybridCosts C = load();
+			return C;
+		}
+	};
+
+	/** @brief Chooses the path of Method::Hybrid from a cost model.
+	 * \ingroup solutions
+	 *
+	 * @see hybrid-dispatch.h for the model.
+	 */
+	class HybridDispatcher {
+	public:
+		HybridDispatcher (const HybridCosts &C = HybridCosts::machine()) :
+			_costs(C)
+		{}
+
+		const HybridCosts &costs () const { return _costs; }
+
+		/** Work of sparse elimination on an \f$m \times n\f$ matrix
+		 * with \c nnz nonzero entries, when only these counts are known.
+		 *
+		 * Symbolic simulation on the counts: rows or columns with at
+		 * most one entry are eliminated first, at no cost.  Then each
+		 * pivot is a Markowitz choice, taken with row and column counts
+		 * half the average of the active submatrix, and its updates
+		 * fill the missing entries at the current density.
+		 * @param[out] ops  updates of the elimination
+		 * @return the predicted number of nonzero entries of the factors
+		 */
+		static double sparseWork (size_t m, size_t n, double nnz, double &ops)
+		{
+			ops = 0.;
+			double a = (double)m, b = (double)n;
+			if (m == 0 || n == 0 || nnz <= 0.)
+				return 0.;
+
+			// singletons, with Poisson distributed row and column counts
+			const double lr = nnz / a, lc = nnz / b;
+			const double sr = a * std::exp(-lr) * (1. + lr);
+			const double sc = b * std::exp(-lc) * (1. + lc);
+			const double s = std::min(std::min(a, b), std::max(sr, sc));
+			double z = std::max(0., nnz - s * std::max(1., std::min(lr, lc)));
+			a -= s;
+			b -= s;
+			double factors = nnz - z;
+
+			for (; a >= 1. && b >= 1. && z > 0.; a -= 1., b -= 1.) {
+				const double d = std::min(1., z / (a * b));
+				const double rc = std::max(1., 0.5 * z / a);
+				const double cc = std::max(1., 0.5 * z / b);
+				const double u = (rc - 1.) * (cc - 1.);
+				ops += u;
+				factors += rc + cc - 1.;
+				z = std::max(0., z - rc - cc + 1. + (1. - d) * u);
+			}
+			return factors;
+		}
+
+		/** Work of sparse elimination on the sparsity pattern of \p A,
+		 * read with its indexed iterators.
+		 *
+		 * Symbolic elimination: the pivot is in a shortest active row,
+		 * in its column with the fewest entries (Markowitz), and each
+		 * row having an entry in the pivot column gets the union of the
+		 * two patterns.  Once it has cost \c LINBOX_HYBRID_SYMBOLIC_BUDGET
+		 * times \f$\nu + m + n\f$ row merges, the remaining active
+		 * submatrix is left to the simulation on its counts.
+		 * @param[out] ops  updates of the elimination
+		 * @param[out] nnz  nonzero entries of \p A
+		 * @return the predicted number of nonzero entries of the factors
+		 */
+		template <class Matrix>
+		static double sparseWork (const Matrix &A, double &ops, double &nnz)
+		{
+			typedef std::pair<size_t, size_t> Key; // row count, row
+			const size_t m = A.rowdim(), n = A.coldim();
+			std::vector<std::vector<size_t> > rows(m), cols(n);
+			std::vector<size_t> count(n, 0);
+			for (auto it = A.IndexedBegin(); it != A.IndexedEnd(); ++it)
+				rows[it.rowIndex()].push_back(it.colIndex());
+
+			std::priority_queue<Key, std::vector<Key>, std::greater<Key> > shortest;
+			nnz = 0.;
+			for (size_t i = 0; i < m; ++i) {
+				std::vector<size_t> &R = rows[i];
+				std::sort(R.begin(), R.end());
+				R.erase(std::unique(R.begin(), R.end()), R.end());
+				for (size_t t = 0; t < R.size(); ++t) {
+					cols[R[t]].push_back(i);
+					++count[R[t]];
+				}
+				nnz += (double)R.size();
+				if (!R.empty())
+					shortest.push(Key(R.size(), i));
+			}
+
+			ops = 0.;
+			double factors = 0., z = nnz, steps = 0.;
+			const double budget = LINBOX_HYBRID_SYMBOLIC_BUDGET * (nnz + (double)m + (double)n);
+			std::vector<bool> done(m, false);
+			std::vector<size_t> merged;
+			while (!shortest.empty() && steps <= budget) {
+				const Key k = shortest.top();
+				shortest.pop();
+				const size_t p = k.second;
+				if (done[p] || rows[p].size() != k.first)
+					continue; // eliminated, or the row has grown since
+				const std::vector<size_t> &P = rows[p];
+				size_t c = P[0];
+				for (size_t t = 1; t < P.size(); ++t)
+					if (count[P[t]] < count[c])
+						c = P[t];
+				done[p] = true;
+				factors += (double)P.size();
+
+				for (size_t t = 0; t < cols[c].size(); ++t) {
+					const size_t r = cols[c][t];
+					if (done[r])
+						continue;
+					std::vector<size_t> &R = rows[r];
+					// R gets R + P without c; the columns of P only are fill
+					merged.clear();
+					size_t x = 0, y = 0;
+					while (x < R.size() || y < P.size()) {
+						if (y == P.size() || (x < R.size() && R[x] < P[y])) {
+							if (R[x] != c) merged.push_back(R[x]);
+							++x;
+						}
+						else if (x == R.size() || P[y] < R[x]) {
+							const size_t j = P[y++];
+							merged.push_back(j);
+							cols[j].push_back(r);
+							++count[j];
+						}
+						else {
+							if (R[x] != c) merged.push_back(R[x]);
+							++x;
+							++y;
+						}
+					}
+					--count[c];
+					steps += (double)(R.size() + P.size());
+					ops += (double)(P.size() - 1);
+					factors += 1.;
+					z += (double)merged.size() - (double)R.size();
+					R.swap(merged);
+					if (!R.empty())
+						shortest.push(Key(R.size(), r));
+				}
+				for (size_t t = 0; t < P.size(); ++t)
+					--count[P[t]];
+				z -= (double)P.size();
+			}
+
+			if (!shortest.empty()) {
+				// over budget: the counts of the active submatrix
+				size_t a = 0, b = 0;
+				for (size_t i = 0; i < m; ++i)
+					if (!done[i] && !rows[i].empty()) ++a;
+				for (size_t j = 0; j < n; ++j)
+					if (count[j]) ++b;
+				double rest;
+				factors += sparseWork(a, b, z, rest);
+				ops += rest;
+			}
+			return factors;
+		}
+
+		//! dense elimination of an m x n matrix, conversion excluded
+		double denseCost (size_t m, size_t n) const
+		{
+			const double r = (double)std::min(m, n);
+			return _costs.blas * (double)m * (double)n * std::pow(r, _costs.omega - 2.);
+		}
+
+		/** The cheapest path for an \f$m \times n\f$ matrix, with the
+		 * fill of sparse elimination simulated on the counts.
+		 * @param nnz      nonzero entries, or their equivalent in time of an apply
+		 * @param convert  time of a conversion of the matrix to sparse or
+		 *                 dense form other than the copy of its entries
+		 * @param sparse   whether sparse elimination is available
+		 * @param dense    whether dense elimination is available
+		 */
+		HybridDecision choose (size_t m, size_t n, double nnz, double convert = 0.,
+				       bool sparse = true, bool dense = true) const
+		{
+			double ops;
+			const double fill = sparseWork(m, n, nnz, ops);
+			return decide(m, n, nnz, fill, ops, convert, sparse, dense);
+		}
+
+		/** The cheapest path for \p A, with the fill of sparse
+		 * elimination simulated on its sparsity pattern.
+		 * \p A has indexed iterators.
+		 */
+		template <class Matrix>
+		HybridDecision choosePattern (const Matrix &A, bool sparse = true, bool dense = true) const
+		{
+			double ops, nnz;
+			const double fill = sparseWork(A, ops, nnz);
+			return decide(A.rowdim(), A.coldim(), nnz, fill, ops, 0., sparse, dense);
+		}
+
+		//! The last choice of this thread.
+		static HybridDecision &last ()
+		{
+			static thread_local HybridDecision D;
+			return D;
+		}
+
+	protected:
+		HybridDecision decide (size_t m, size_t n, double nnz, double fill, double ops,
+				       double convert, bool sparse, bool dense) const
+		{
+			HybridDecision D;
+			D.rowdim = m;
+			D.coldim = n;
+			D.nonzeros = nnz;
+			D.fill = fill;
+			const double r = (double)std::min(m, n);
+			D.wiedemann = _costs.wiedemann * 2. * r * (nnz + (double)m + (double)n);
+			D.sparse = convert + _costs.elimination * ops + _costs.conversion * nnz;
+			D.dense = convert + denseCost(m, n) + _costs.conversion * (double)m * (double)n;
+
+			// the blackbox path is always available, the last resort
+			const double never = HybridCosts::disabled();
+			sparse = sparse && _costs.elimination < never;
+			dense = dense && _costs.blas < never;
+			D.path = HybridDecision::BLACKBOX;
+			double best = (_costs.wiedemann < never) ? D.wiedemann : std::numeric_limits<double>::infinity();
+			if (sparse && D.sparse < best) {
+				D.path = HybridDecision::SPARSE_ELIMINATION;
+				best = D.sparse;
+			}
+			if (dense && D.dense <= best)
+				D.path = HybridDecision::DENSE_ELIMINATION;
+			return record(D);
+		}
+
+		static const HybridDecision &record (const HybridDecision &D)
+		{
+			last() = D;
+			D.write(commentator().report(Commentator::LEVEL_NORMAL, INTERNAL_DESCRIPTION)) << std::endl;
+			return last();
+		}
+
+		HybridCosts _costs;
+	};
+
+	namespace Protected {
+
+		//! nonzero entries of A, when its format stores them
+		template <class Field, class Storage>
+		inline auto hybridNonzeros (const SparseMatrix<Field,Storage> &A, int)
+		-> decltype((double)A.size())
+		{
+			return (double)A.size();
+		}
+
+		//! otherwise, -1
+		template <class Blackbox>
+		inline double hybridNonzeros (const Blackbox &, long)
+		{
+			return -1.;
+		}
+
+		//! seconds of one apply of A, over enough applies to be measurable
+		template <class Blackbox>
+		double hybridMeasureApply (const Blackbox &A)
+		{
+			typedef typename Blackbox::Field Field;
+			typedef std::chrono::steady_clock Clock;
+			const Field &F = A.field();
+			BlasVector<Field> x(F, A.coldim(), F.one), y(F, A.rowdim());
+			double t = 0.;
+			size_t k = 0;
+			for (size_t reps = 1; t < 1e-4 && k < 64; reps *= 2) {
+				const Clock::time_point t0 = Clock::now();
+				for (size_t i = 0; i < reps; ++i)
+					A.apply(y, x);
+				t += std::chrono::duration<double>(Clock::now() - t0).count();
+				k += reps;
+			}
+			return t / (double)k;
+		}
+
+		/** seconds of one apply of A.  The time per row and column is
+		 * measured on the first blackbox of the type, and kept.
+		 */
+		template <class Blackbox>
+		double hybridApplyTime (const Blackbox &A)
+		{
+			const double d = (double)(A.rowdim() + A.coldim());
+			static const double perDim = hybridMeasureApply(A) / std::max(1., d);
+			return perDim * d;
+		}
+
+		//! matrices with indexed iterators: symbolic elimination of their pattern
+		template <class Matrix>
+		inline auto hybridChoice (const Matrix &A, bool sparse, bool dense, int)
+		-> decltype(A.IndexedBegin(), HybridDecision())
+		{
+			return HybridDispatcher().choosePattern(A, sparse, dense);
+		}
+
+		//! other blackboxes: simulation on the counts
+		template <class Blackbox>
+		HybridDecision hybridChoice (const Blackbox &A, bool sparse, bool dense, long)
+		{
+			HybridDispatcher H;
+			const size_t m = A.rowdim(), n = A.coldim();
+			double nnz = hybridNonzeros(A, 0);
+			double convert = 0.;
+			if (nnz < 0.) {
+				const double t = hybridApplyTime(A);
+				nnz = std::max(0., t / H.costs().wiedemann - (double)m - (double)n);
+				convert = t * (double)n;
+			}
+			return H.choose(m, n, nnz, convert, sparse, dense);
+		}
+	}
+
+	/** Method::Hybrid choice for A.
+	 *
+	 * The sparsity pattern of matrices with indexed iterators is
+	 * eliminated symbolically.  Other sparse matrices give their number
+	 * of nonzero entries.  Other blackboxes are charged the time of an
+	 * apply, measured once per blackbox type, from which an equivalent
+	 * number of nonzero entries is derived, and their conversions are
+	 * charged one apply per column.
+	 * @param sparse  whether sparse elimination is available for A
+	 * @param dense   whether dense elimination is available for A
+	 */
+	template <class Blackbox>
+	HybridDecision hybridChoice (const Blackbox &A, bool sparse = true, bool dense = true)
+	{
+		return Protected::hybridChoice(A, sparse, dense, 0);
+	}
+
+	template <class Field, class _Rep>
+	HybridDecision hybridChoice (const BlasMatrix<Field,_Rep> &A, bool = true, bool = true)
+	{
+		HybridDispatcher H;
+		const size_t m = A.rowdim(), n = A.coldim();
+		return H.choose(m, n, (double)m * (double)n, 0., false, true);
+	}
+
+	//! whether dense BLAS elimination is available over F
+	template <class Field>
+	bool hybridBlasField (const Field &F)
+	{
+		integer a, b;
+		F.characteristic(a);
+		F.cardinality(b);
+		return a == b && a < LinBox::BlasBound;
+	}
+
+	/** Whether Method::Hybrid should use a blackbox method on A, rather
+	 * than an elimination.
+	 */
+	template<class BB>
+	bool useBB(const BB& A)
+	{
+		return hybridChoice(A).path == HybridDecision::BLACKBOX;
+	}
+
+	template<class Field, class _Rep>
+	bool useBB(const BlasMatrix<Field,_Rep>&) { return false; }
+
+}
+
+#endif // __LINBOX_solutions_hybrid_dispatch_H
+
+// Local Variables:
+// mode: C++
+// tab-width: 4
+// indent-tabs-mode: nil
+// c-basic-offset: 4
+// End:
+// vim:sts=4:sw=4:ts=4:et:sr:cino=>s,f0,{0,g0,(0,\:0,t0,+0,=s
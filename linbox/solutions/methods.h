@@ -50,6 +50,7 @@
 #define __LINBOX_method_H
 
 #include <string> // size_t
+#include <cstdint> // uint64_t
 
 #ifndef DEFAULT_EARLY_TERM_THRESHOLD
 #  define DEFAULT_EARLY_TERM_THRESHOLD 20
@@ -59,10 +60,6 @@
 #include "linbox/util/mpicpp.h"
 #endif
 
-#ifndef LINBOX_USE_BLACKBOX_THRESHOLD
-#define LINBOX_USE_BLACKBOX_THRESHOLD 1000
-#endif
-
 namespace LinBox
 {
 	///
@@ -147,9 +144,13 @@ namespace LinBox
 			CERTIFY = true, DONT_CERTIFY = false
 		};
 
-		/** Linear-time pivoting or not for eliminations */
+		/** Pivoting for sparse eliminations: linear-time, none, least
+		 * Markowitz cost, structured Gaussian elimination (singleton and
+		 * light columns first) followed by linear pivoting on what is left,
+		 * or sets of independent pivots eliminated in parallel.
+		 */
 		enum PivotStrategy {
-			PIVOT_LINEAR, PIVOT_NONE
+			PIVOT_LINEAR, PIVOT_NONE, PIVOT_MARKOWITZ, PIVOT_SGE, PIVOT_PARALLEL
 		};
 
 		Specifier ( ) :
@@ -168,6 +169,7 @@ namespace LinBox
 			, _communicatorp( 0 )
 #endif
 			, _checkResult( true )
+			, _seed( 0 )
 			{}
 
 		Specifier (const Specifier& s):
@@ -186,6 +188,7 @@ namespace LinBox
 			, _communicatorp(s._communicatorp)
 #endif
 			, _checkResult( s._checkResult )
+			, _seed( s._seed )
 			{}
 
 		/** Accessors
@@ -206,6 +209,7 @@ namespace LinBox
 		Shape		shape ()		const { return _shape; }
 		double		trustability ()		const { return _provensuccessprobability; }
 		bool		checkResult ()		const { return _checkResult; }
+		uint64_t	seed ()			const { return _seed; }
 #ifdef __LINBOX_HAVE_MPI
 		Communicator* communicatorp ()		const { return _communicatorp; }
 #endif
@@ -230,6 +234,8 @@ namespace LinBox
 		void shape          (Shape s)          { _shape = s; }
 		void trustability   (double p)         { _provensuccessprobability = p; }
 		void checkResult    (bool s)           { _checkResult = s; }
+		//! seed of the random choices, 0 for a random seed
+		void seed           (uint64_t s)       { _seed = s; }
 #ifdef __LINBOX_HAVE_MPI
 		void communicatorp  (Communicator* cp) { _communicatorp = cp; }
 #endif
@@ -248,6 +254,7 @@ namespace LinBox
 		Shape          _shape;
 		double         _provensuccessprobability;
 		bool           _checkResult;
+		uint64_t       _seed;
 #ifdef __LINBOX_HAVE_MPI
 		Communicator*   _communicatorp;
 #endif
@@ -680,18 +687,7 @@ namespace LinBox
 	};
 
 
-	template<class BB>
-	bool useBB(const BB& A)
-	{
-		return (A.coldim() > LINBOX_USE_BLACKBOX_THRESHOLD) && (A.rowdim() > LINBOX_USE_BLACKBOX_THRESHOLD);
-	}
-
-
-	template<class _Field, class _Rep>
-	class BlasMatrix ; // forward declaration...
-
-	template<class Field, class _Rep>
-	bool useBB(const BlasMatrix<Field,_Rep>& A) { return false; }
+	// useBB(A), the choice of Method::Hybrid, is in solutions/hybrid-dispatch.h
 
 
 	/** Solver traits.
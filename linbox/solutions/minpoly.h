@@ -194,6 +194,8 @@ namespace LinBox
 #include "linbox/algorithms/rational-cra2.h"
 #include "linbox/algorithms/varprec-cra-early-multip.h"
 #include "linbox/algorithms/minpoly-rational.h"
+#include "linbox/algorithms/multimod-wiedemann.h"
+#include "linbox/matrix/sparse-matrix.h"
 
 namespace LinBox
 {
@@ -264,6 +266,71 @@ namespace LinBox
 		return P;
 	}
 
+#ifndef __LINBOX_HAVE_MPI
+	namespace Protected {
+		/*! @internal Integer minpoly of a sparse matrix by Wiedemann,
+		 * reading the matrix once per step for LINBOX_MULTIMOD_SPMV_PRIMES
+		 * primes (see MultiModSparseMatrix).
+		 */
+		template <class Polynomial, class Ring, class Fmt, class MyMethod>
+		Polynomial &minpolyMultiMod (Polynomial                       & P,
+					     const SparseMatrix<Ring, Fmt>    & A,
+					     const MyMethod                   & M)
+		{
+			if (A.rowdim() == 0 || A.coldim() == 0){
+				P.resize(1);
+				P.field().assign(P[0],P.field().one);
+				return P;
+			}
+			typedef Givaro::ModularBalanced<double> Field;
+			PrimeIterator<IteratorCategories::HeuristicTag> genprime(std::min (UINT64_C(31), FieldTraits<Field>::bestBitSize(A.coldim())));
+			MultiModSparseMatrix B (A);
+			if (A.rowdim() != A.coldim() || ! B.fits()) {
+				commentator().start ("Integer Minpoly", "Iminpoly");
+				// the method as given, e.g. the certificate of Method::Blackbox
+				IntegerModularMinpoly<SparseMatrix<Ring, Fmt>, MyMethod> iteration(A, M);
+				ChineseRemainder< EarlyMultipCRA<Field > > cra(3UL);
+				cra(P, iteration, genprime);
+				commentator().stop ("done", NULL, "Iminpoly");
+				return P;
+			}
+			commentator().start ("Integer Minpoly, multi-modulus", "Iminpoly");
+			MultiModMinpoly iteration (B, M.earlyTermThreshold(), M.seed());
+			ChineseRemainder< EarlyMultipCRA<Field > > cra(3UL);
+			cra.batch (P, iteration, genprime, LINBOX_MULTIMOD_SPMV_PRIMES);
+			commentator().stop ("done", NULL, "Iminpoly");
+			return P;
+		}
+	}
+
+	template <class Polynomial, class Ring, class Fmt>
+	Polynomial &minpoly (Polynomial                       & P,
+			     const SparseMatrix<Ring, Fmt>    & A,
+			     const RingCategories::IntegerTag & tag,
+			     const Method::Wiedemann          & M)
+	{
+		return Protected::minpolyMultiMod (P, A, M);
+	}
+
+	template <class Polynomial, class Ring, class Fmt>
+	Polynomial &minpoly (Polynomial                       & P,
+			     const SparseMatrix<Ring, Fmt>    & A,
+			     const RingCategories::IntegerTag & tag,
+			     const Method::Blackbox           & M)
+	{
+		return Protected::minpolyMultiMod (P, A, M);
+	}
+
+	template <class Polynomial, class Ring, class Fmt>
+	Polynomial &minpoly (Polynomial                       & P,
+			     const SparseMatrix<Ring, Fmt>    & A,
+			     const RingCategories::IntegerTag & tag,
+			     const Method::Hybrid             & M)
+	{
+		return Protected::minpolyMultiMod (P, A, M);
+	}
+#endif
+
 	template < class Blackbox, class Polynomial, class MyMethod>
 	Polynomial &minpoly (Polynomial                        & P,
 			     const Blackbox                    & A,
@@ -79,6 +79,27 @@ namespace LinBox
 	inline unsigned long &rankin (unsigned long &r, const Blackbox &A, 
 			const DomainCategory &tag, const Method &M);
 
+	/**
+	 * Rank of an integer matrix A from its ranks modulo several random primes.
+	 * \ingroup solutions
+	 * The modular ranks are computed concurrently, by sparse elimination
+	 * or Wiedemann as \p M (or the \p Method::Hybrid dispatcher) chooses.
+	 * The integer entries are read once and reduced on the fly for each
+	 * prime when \p A has indexed iterators; otherwise \p A is rebound for
+	 * each prime.  No modular rank exceeds the integer rank, so the
+	 * largest is kept and the computation stops when \p agree primes give
+	 * it, when it is full, or after \p M.maxTries() primes (8 \p agree if
+	 * \p M.maxTries() is 1).  rank() over \p IntegerTag does not use this
+	 * mode: call this function for it.
+	 * \param[out] r   rank of \p A.
+	 * \param[out] err bound on the probability that \p r is below the rank
+	 *                 of \p A, 1 when no bound is known.
+	 * \param threads  number of threads, 0 for the default.
+	 */
+	template <class Blackbox, class MyMethod>
+	inline unsigned long &integral_rank (unsigned long &r, double &err, const Blackbox &A,
+					     const MyMethod &M, size_t agree = 2, size_t threads = 0);
+
 	/**
 	 * Compute the rank of a linear transform A over a field.
 	 * \ingroup solutions
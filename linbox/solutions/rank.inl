@@ -32,9 +32,18 @@
 // #define __LINBOX_rank_sparse_elimination_format SparseMatrixFormat::CSR
 
 #include "linbox/field/field-traits.h"
+#include "linbox/solutions/hybrid-dispatch.h"
+#include "linbox/blackbox/multimod-sparse.h"
+#include "linbox/blackbox/csr-view.h"
+#include "linbox/util/bounded-task-pool.h"
 
 #include <givaro/extension.h>
 
+#include <set>
+#include <memory>
+#include <cmath>
+#include <algorithm>
+
 // Namespace in which all LinBox library code resides
 namespace LinBox
 {
@@ -46,11 +55,15 @@ namespace LinBox
 				    const RingCategories::ModularTag &tag,
 				    const Method::Hybrid             &m)
 	{ // this should become a BB/Blas hybrid in the style of Duran/Saunders/Wan.
-		//! @bug choose (benchmark) better cuttoff (size, nbnz, sparse rep)
-		if (useBB(A)) {
+		const bool blas = hybridBlasField(A.field());
+		switch (hybridChoice(A, true, blas).path) {
+		case HybridDecision::BLACKBOX:
 			return rank(r, A, tag, Method::Blackbox(m ));
-		}
-		else {
+		case HybridDecision::SPARSE_ELIMINATION:
+			return rank(r, A, tag, Method::SparseElimination( m ));
+		default:
+			if (blas)
+				return rank(r, A, tag, Method::BlasElimination( m ));
 			return rank(r, A, tag, Method::Elimination( m ));
 		}
 	}
@@ -475,6 +488,152 @@ namespace LinBox
 	}
 
 
+	namespace Protected {
+
+		//! stores the integer entries of A once, when it has indexed iterators and they fit
+		template <class Blackbox>
+		inline auto integralRankEntries (std::unique_ptr<MultiModSparseMatrix> &S, const Blackbox &A, int)
+		-> decltype(A.IndexedBegin(), void())
+		{
+			S.reset(new MultiModSparseMatrix(A));
+			if (! S->fits())
+				S.reset();
+		}
+
+		//! otherwise A is rebound for each prime
+		template <class Blackbox>
+		inline void integralRankEntries (std::unique_ptr<MultiModSparseMatrix> &, const Blackbox &, long)
+		{}
+
+		//! whether the modular ranks use Wiedemann rather than sparse elimination
+		template <class MyMethod>
+		inline bool integralRankBlackbox (const MultiModSparseMatrix &, const MyMethod &) { return false; }
+		inline bool integralRankBlackbox (const MultiModSparseMatrix &, const Method::Wiedemann &) { return true; }
+		inline bool integralRankBlackbox (const MultiModSparseMatrix &, const Method::Blackbox &) { return true; }
+		inline bool integralRankBlackbox (const MultiModSparseMatrix &S, const Method::Hybrid &)
+		{
+			return HybridDispatcher().choose(S.rowdim(), S.coldim(), (double)S.size(), 0., true, false).path
+				== HybridDecision::BLACKBOX;
+		}
+
+		/** Bound on the probability that the rank of S modulo a random
+		 * prime of bits bits is too small: the prime divides a nonzero
+		 * minor, at most Hadamard's bound of the rows, or Wiedemann fails,
+		 * with probability at most N(N+1)/p.  The primes of bits bits are
+		 * counted as \f$2^{bits-1}/(bits \ln 2)\f$.
+		 */
+		inline double integralRankDeficiency (const MultiModSparseMatrix &S, size_t bits, bool blackbox)
+		{
+			double logH = 0.;
+			for (size_t i = 0; i < S.rowdim(); ++i) {
+				double norm = 0.;
+				for (size_t t = S.start()[i]; t < S.start()[i+1]; ++t)
+					norm += (double)S.values()[t] * (double)S.values()[t];
+				if (norm > 1.)
+					logH += 0.5 * std::log2(norm);
+			}
+			const double pmin = std::ldexp(1., (int)bits - 1);
+			double e = (logH / (double)(bits - 1)) / (pmin / ((double)bits * std::log(2.)));
+			if (blackbox) {
+				const double N = (double)std::max(S.rowdim(), S.coldim());
+				e += N * (N + 1.) / pmin;
+			}
+			return std::min(1., e);
+		}
+
+		//! rank of the integer S modulo the characteristic of F, on a view of its entries
+		template <class Field>
+		unsigned long &integralRankModular (unsigned long &r, const MultiModSparseMatrix &S, const Field &F,
+						    bool blackbox, const Specifier &M)
+		{
+			CSRView<Field, size_t, int64_t> V(F, S.rowdim(), S.coldim(), S.start(), S.colid(), S.values());
+			if (blackbox)
+				return rank(r, V, RingCategories::ModularTag(), Method::Wiedemann(M));
+			SparseMatrix<Field, SparseMatrixFormat::SparseSeq> C(F, S.rowdim(), S.coldim());
+			V.copy(C);
+			return rankin(r, C, RingCategories::ModularTag(), Method::SparseElimination(EliminationSpecifier(M)));
+		}
+	}
+
+	template <class Blackbox, class MyMethod>
+	inline unsigned long &integral_rank (unsigned long	&r,
+					     double		&err,
+					     const Blackbox	&A,
+					     const MyMethod	&M,
+					     size_t		agree,
+					     size_t		threads)
+	{
+		commentator().start ("Multi-prime Integer Rank", "mpirank");
+		typedef Givaro::ModularBalanced<double> projField;
+		typedef typename Blackbox::template rebind< projField >::other FBlackbox;
+		const size_t bits = FieldTraits<projField>::bestBitSize(A.rowdim());
+		PrimeIterator<IteratorCategories::HeuristicTag> genprime(bits);
+		if (agree == 0) agree = 1;
+		if (threads == 0) threads = BoundedTaskPool::defaultThreads();
+		const size_t tries = (M.maxTries() > 1) ? (size_t)M.maxTries() : 8 * agree;
+		const size_t full = std::min(A.rowdim(), A.coldim());
+
+		// the integer entries are read once, each prime reduces them on the fly
+		std::unique_ptr<MultiModSparseMatrix> S;
+		Protected::integralRankEntries(S, A, 0);
+		const bool blackbox = S && Protected::integralRankBlackbox(*S, M);
+		const double deficiency = S ? Protected::integralRankDeficiency(*S, bits, blackbox) : 1.;
+		commentator().report (Commentator::LEVEL_IMPORTANT, INTERNAL_DESCRIPTION)
+			<< "Integer rank by " << (S ? (blackbox ? "Wiedemann" : "sparse elimination") : "rebinding")
+			<< " modulo " << agree << " agreeing primes out of " << tries << " at most" << std::endl;
+
+		std::set<uint64_t> used;
+		BoundedTaskPool pool (threads);
+		unsigned long best = 0;
+		size_t agreeing = 0;
+		while (agreeing < agree && used.size() < tries && best < full) {
+			// no more primes than the agreement still needs
+			const size_t k = std::min(std::min(threads, agree - agreeing), tries - used.size());
+			std::vector<uint64_t> primes;
+			while (primes.size() < k) {
+				++genprime;
+				if (used.insert((uint64_t)*genprime).second)
+					primes.push_back((uint64_t)*genprime);
+			}
+			std::vector<unsigned long> ranks (k);
+			for (size_t l = 0; l < k; ++l) {
+				const MultiModSparseMatrix *Sp = S.get();
+				const uint64_t p = primes[l];
+				unsigned long *rk = &ranks[l];
+				pool.submit (0, [&A, &M, Sp, p, rk, blackbox] () {
+					const projField Fp((double)p);
+					if (Sp)
+						Protected::integralRankModular(*rk, *Sp, Fp, blackbox, M);
+					else {
+						FBlackbox Ap(A, Fp);
+						rankin(*rk, Ap, RingCategories::ModularTag(), M);
+					}
+				});
+			}
+			pool.wait();
+
+			// a modular rank never exceeds the integer one
+			for (size_t l = 0; l < k; ++l) {
+				commentator().report (Commentator::LEVEL_NORMAL, INTERNAL_DESCRIPTION)
+					<< "rank modulo " << primes[l] << ": " << ranks[l] << std::endl;
+				if (ranks[l] > best) {
+					best = ranks[l];
+					agreeing = 1;
+				}
+				else if (ranks[l] == best)
+					++agreeing;
+			}
+		}
+
+		r = best;
+		err = (best == full) ? 0. : std::pow(deficiency, (double)agreeing);
+		commentator().report (Commentator::LEVEL_IMPORTANT, INTERNAL_DESCRIPTION)
+			<< "Integer rank " << r << " from " << used.size() << " primes, "
+			<< agreeing << " agreeing, error probability at most " << err << std::endl;
+		commentator().stop ("done", NULL, "mpirank");
+		return r;
+	}
+
 	template <class Blackbox, class MyMethod>
 	inline unsigned long &rank (unsigned long                     &r,
 				    const Blackbox                    &A,
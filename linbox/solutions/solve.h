@@ -45,6 +45,7 @@
 #include "linbox/util/error.h"
 #include "linbox/vector/vector-domain.h"
 #include "linbox/solutions/methods.h"
+#include "linbox/solutions/hybrid-dispatch.h"
 #include "linbox/algorithms/bbsolve.h"
 
 #include "linbox/algorithms/rational-cra2.h"
@@ -105,15 +106,40 @@ namespace LinBox
 	}
 
 	// in methods.h FoobarMethod and Method::Foobar are the same class.
-	// in methods.h template<BB> bool useBB(const BB& A) is defined.
+	// in hybrid-dispatch.h template<BB> bool useBB(const BB& A) is defined.
+
+	namespace Protected {
+		//! @internal Hybrid over rings: blackbox or elimination
+		template <class Vector, class BB, class Tag>
+		Vector& solveHybrid(Vector& x, const BB& A, const Vector& b,
+				    const Method::Hybrid& m, const Tag&)
+		{
+			if (useBB(A)) return solve(x, A, b, Method::Blackbox(m));
+			else return solve(x, A, b, Method::Elimination(m));
+		}
+
+		//! @internal Hybrid over fields, where sparse elimination is also available
+		template <class Vector, class BB>
+		Vector& solveHybrid(Vector& x, const BB& A, const Vector& b,
+				    const Method::Hybrid& m, const RingCategories::ModularTag&)
+		{
+			switch (hybridChoice(A).path) {
+			case HybridDecision::BLACKBOX:
+				return solve(x, A, b, Method::Blackbox(m));
+			case HybridDecision::SPARSE_ELIMINATION:
+				return solve(x, A, b, Method::SparseElimination(m));
+			default:
+				return solve(x, A, b, Method::Elimination(m));
+			}
+		}
+	}
 
 	//! @internal specialize this on blackboxes which have local methods
 	template <class Vector, class BB>
 	Vector& solve(Vector& x, const BB& A, const Vector& b,
 		      const Method::Hybrid& m)
 	{
-		if (useBB(A)) return solve(x, A, b, Method::Blackbox(m));
-		else return solve(x, A, b, Method::Elimination(m));
+		return Protected::solveHybrid(x, A, b, m, typename FieldTraits<typename BB::Field>::categoryTag());
 	}
 
 	/**  @internal Blackbox method specialisation */
@@ -102,6 +102,12 @@ namespace LinBox
 #include "linbox/algorithms/cra-early-single.h"
 #include "linbox/randiter/random-prime.h"
 #include "linbox/algorithms/matrix-hom.h"
+#include "linbox/algorithms/massey-domain.h"
+#include "linbox/algorithms/valence-aat.h"
+#include "linbox/util/bounded-task-pool.h"
+
+#include <set>
+#include <random>
 
 namespace LinBox
 {
@@ -313,8 +319,97 @@ namespace LinBox
 				}
 			} while (im < bound);
 
+			reconstruct (val, Lv, Lm, im);
+			return;
+		}
+
+		/** Compute the valence of AAT over an integer ring, d the degree of
+		 * min_poly of AAT, as valence(val, d, A) but with the modular
+		 * computations on threads threads (0 for the default) and k primes
+		 * per traversal of A.  The integer A is stored once with word size
+		 * entries, and AAT is formed explicitly when cheaper than the
+		 * composition (see IntegerAAT).  The projections of the sequences
+		 * are drawn from seed, or from std::random_device when it is 0, so
+		 * that a given seed gives the same primes and residues whatever the
+		 * scheduling of the threads.  Falls back to valence(val, d, A) when
+		 * the entries of A do not fit.
+		 */
+		template <class Blackbox>
+		static void valenceParallel(Integer& val, size_t d, const Blackbox& A, size_t threads = 0, size_t k = 4,
+					    uint64_t seed = 0)
+		{
+			typedef Givaro::Modular<int32_t> Field;
+			typedef std::vector<Field::Element> Sequence;
+
+			const size_t length = 2 * d + 2;
+			IntegerAAT M (A, length);
+			if (! M. fits()) {
+				valence (val, d, A);
+				return;
+			}
+			if (threads == 0) threads = BoundedTaskPool::defaultThreads();
+			if (k == 0) k = 1;
+
+			PrimeIterator<IteratorCategories::HeuristicTag> rg(FieldTraits<Field>::bestBitSize(A.coldim()));
+			Givaro::ZRing<Integer> Z;
+			BlasVector<Givaro::ZRing<Integer> > Lv(Z), Lm(Z);
+			integer im = 1;
+			integer bound; M. cassini (bound); bound = pow (bound, (uint64_t)d); bound *= 2;
+			commentator().report (Commentator::LEVEL_IMPORTANT, INTERNAL_DESCRIPTION)
+			<< "Bound for valence: " << bound << ", AAT " << (M. isExplicit() ? "explicit" : "composed")
+			<< ", " << threads << " x " << k << " primes per round" << std::endl;
+
+			std::set<uint64_t> used;
+			std::mt19937_64 seeds (seed ? seed : (uint64_t)std::random_device{}());
+			BoundedTaskPool pool (threads);
+			do {
+				// primes and seeds are drawn here, the sequences on the pool
+				std::vector<std::vector<uint64_t> > primes (threads);
+				std::vector<std::vector<std::vector<uint64_t> > > s (threads);
+				for (size_t t = 0; t < threads; ++t) {
+					while (primes[t]. size() < k) {
+						++rg;
+						if (used. insert ((uint64_t)*rg). second)
+							primes[t]. push_back ((uint64_t)*rg);
+					}
+					const uint64_t ts = seeds();
+					pool. submit (0, [&M, &s, &primes, t, length, ts] () {
+						M. sequences (s[t], primes[t], length, ts);
+					});
+				}
+				pool. wait();
+
+				// Berlekamp/Massey on each sequence
+				for (size_t t = 0; t < threads; ++t)
+					for (size_t l = 0; l < k; ++l) {
+						Field F ((int32_t)primes[t][l]);
+						Sequence seq (length);
+						for (size_t i = 0; i < length; ++i)
+							F. init (seq[i], s[t][l][i]);
+						MasseyDomain<Field, Sequence> MD (&seq, F);
+						BlasVector<Field> phi (F);
+						unsigned long rk;
+						MD. minpoly (phi, rk, false);
+						if (phi. size() != d + 1) continue;
+						typename BlasVector<Field>::const_iterator p = phi. begin();
+						while (p != phi. end() && F. isZero (*p)) ++p;
+						im *= primes[t][l];
+						Lm. push_back (primes[t][l]); Lv. push_back (integer(*p));
+					}
+			} while (im < bound);
+
+			reconstruct (val, Lv, Lm, im);
+			commentator().report (Commentator::LEVEL_IMPORTANT, INTERNAL_DESCRIPTION)
+			<< "Integer valence =: " << val << " from " << Lm. size() << " primes" << std::endl;
+		}
+
+	protected:
+		// symmetric CRA of the residues Lv modulo Lm, im the product of Lm
+		static void reconstruct(Integer& val, const BlasVector<Givaro::ZRing<Integer> >& Lv,
+					const BlasVector<Givaro::ZRing<Integer> >& Lm, const integer& im)
+		{
 			val = 0;
-			BlasVector<Givaro::ZRing<Integer> >::iterator Lv_p, Lm_p; integer tmp, a, b, g;
+			BlasVector<Givaro::ZRing<Integer> >::const_iterator Lv_p, Lm_p; integer tmp, a, b, g;
 			for (Lv_p = Lv. begin(), Lm_p = Lm. begin(); Lv_p != Lv. end(); ++ Lv_p, ++ Lm_p) {
 				tmp = im / *Lm_p;
 				gcd (g, *Lm_p, tmp, a, b);
@@ -327,8 +422,6 @@ namespace LinBox
 			tmp = val - im;
 			if (abs(tmp) < abs(val))
 				val = tmp;
-
-			return;
 		}
 	};
 } //End of LinBox
@@ -0,0 +1,245 @@
+/* linbox/util/bounded-task-pool.h
+ *
+ * ========LICENCE========
+ * This file is part of the library LinBox.
+ *
+ * LinBox is free software: you can redistribute it and/or modify
+ * it under the terms of the  GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ * ========LICENCE========
+ */
+
+/*! @file util/bounded-task-pool.h
+ * @ingroup util
+ * @brief Pool of threads running jobs under a memory budget.
+ */
+
+#ifndef __LINBOX_util_bounded_task_pool_H
+#define __LINBOX_util_bounded_task_pool_H
+
+#include <cstddef>
+#include <deque>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <exception>
+#include <algorithm>
+#include <utility>
+
+#ifdef __LINBOX_USE_OPENMP
+#include <omp.h>
+#endif
+
+#include "linbox/linbox-config.h"
+#include "linbox/util/debug.h"
+
+namespace LinBox
+{
+
+	/** @brief Pool of threads running jobs under a memory budget.
+	 * \ingroup util
+	 *
+	 * Each job declares the bytes it will allocate, and starts only when
+	 * they fit in the budget together with those of the running jobs.
+	 * A job larger than the whole budget runs alone.  Jobs start in the
+	 * order they are submitted.  A running job whose needs grow calls
+	 * recharge().  The first exception thrown by a job is rethrown by
+	 * wait(), the jobs not yet started are then dropped.
+	 */
+	class BoundedTaskPool {
+	public:
+		typedef std::function<void ()> Job;
+
+		/**
+		 * @param threads  number of threads, 0 for the hardware (or OpenMP) default
+		 * @param budget   bytes, 0 for no bound
+		 */
+		BoundedTaskPool (size_t threads = 0, size_t budget = 0) :
+			_budget(budget), _used(0), _running(0), _tickets(0), _stop(false)
+		{
+			if (threads == 0)
+				threads = defaultThreads();
+			for (size_t t = 0; t < threads; ++t)
+				_workers.push_back(std::thread(&BoundedTaskPool::_worker, this));
+		}
+
+		~BoundedTaskPool ()
+		{
+			{
+				std::lock_guard<std::mutex> lock(_mutex);
+				_stop = true;
+			}
+			_wake.notify_all();
+			for (size_t t = 0; t < _workers.size(); ++t)
+				_workers[t].join();
+		}
+
+		static size_t defaultThreads ()
+		{
+#ifdef __LINBOX_USE_OPENMP
+			return (size_t) std::max(1, omp_get_max_threads());
+#else
+			return std::max(1u, std::thread::hardware_concurrency());
+#endif
+		}
+
+		size_t numThreads () const { return _workers.size(); }
+		size_t budget () const { return _budget; }
+
+		//! Queues f, which will allocate about bytes; returns its ticket for withdraw().
+		size_t submit (size_t bytes, Job f)
+		{
+			size_t ticket;
+			{
+				std::lock_guard<std::mutex> lock(_mutex);
+				ticket = _tickets++;
+				_jobs.push_back(_Entry(ticket, bytes, f));
+			}
+			_wake.notify_all();
+			return ticket;
+		}
+
+		/** Removes the job of ticket from the queue, if it has not
+		 * started, so that it no longer holds back the jobs behind it.
+		 * @return whether the job was removed
+		 */
+		bool withdraw (size_t ticket)
+		{
+			{
+				std::lock_guard<std::mutex> lock(_mutex);
+				std::deque<_Entry>::iterator it = _jobs.begin();
+				while (it != _jobs.end() && it->ticket != ticket)
+					++it;
+				if (it == _jobs.end())
+					return false;
+				_jobs.erase(it);
+			}
+			_wake.notify_all();
+			_done.notify_all();
+			return true;
+		}
+
+		//! Blocks until all the submitted jobs are done.
+		void wait ()
+		{
+			std::unique_lock<std::mutex> lock(_mutex);
+			while (!_jobs.empty() || _running)
+				_done.wait(lock);
+			if (_error) {
+				std::exception_ptr e = _error;
+				_error = std::exception_ptr();
+				std::rethrow_exception(e);
+			}
+		}
+
+		/** From a running job of this pool: its charge becomes bytes.
+		 * The job waits for bytes to fit as a starting job would, with
+		 * its former charge released, so that jobs growing at the same
+		 * time cannot wait for each other.
+		 */
+		void recharge (size_t bytes)
+		{
+			linbox_check(_current().first == this);
+			size_t *charge = _current().second;
+			std::unique_lock<std::mutex> lock(_mutex);
+			_used -= *charge;
+			*charge = 0;
+			_wake.notify_all();
+			while (!_fits(bytes))
+				_wake.wait(lock);
+			_used += bytes;
+			*charge = bytes;
+		}
+
+	protected:
+		struct _Entry {
+			size_t ticket;
+			size_t  bytes;
+			Job       run;
+			_Entry (size_t t, size_t b, const Job &f) : ticket(t), bytes(b), run(f) {}
+		};
+
+		// pool and charge of the job running on the calling thread
+		static std::pair<const BoundedTaskPool*, size_t*> &_current ()
+		{
+			static thread_local std::pair<const BoundedTaskPool*, size_t*> c (0, 0);
+			return c;
+		}
+
+		bool _fits (size_t bytes) const
+		{
+			return _budget == 0 || _used == 0 || _used + bytes <= _budget;
+		}
+
+		void _worker ()
+		{
+			std::unique_lock<std::mutex> lock(_mutex);
+			for (;;) {
+				while (!_stop && (_jobs.empty() || !_fits(_jobs.front().bytes)))
+					_wake.wait(lock);
+				if (_stop)
+					return;
+				_Entry job = _jobs.front();
+				_jobs.pop_front();
+				size_t charge = job.bytes;
+				_used += charge;
+				++_running;
+				lock.unlock();
+
+				_current() = std::make_pair(this, &charge);
+				try {
+					job.run();
+				}
+				catch (...) {
+					lock.lock();
+					if (!_error)
+						_error = std::current_exception();
+					_jobs.clear();
+					lock.unlock();
+				}
+
+				_current() = std::make_pair((const BoundedTaskPool*)0, (size_t*)0);
+				lock.lock();
+				_used -= charge;
+				--_running;
+				_wake.notify_all();
+				_done.notify_all();
+			}
+		}
+
+		const size_t                              _budget;
+		size_t                                      _used;
+		size_t                                   _running;
+		size_t                                   _tickets;
+		bool                                        _stop;
+		std::deque<_Entry>                          _jobs;
+		std::vector<std::thread>                 _workers;
+		std::exception_ptr                         _error;
+		std::mutex                                 _mutex;
+		std::condition_variable                     _wake; // a job or some budget is available
+		std::condition_variable                     _done; // a job has finished
+	};
+
+}
+
+#endif // __LINBOX_util_bounded_task_pool_H
+
+// Local Variables:
+// mode: C++
+// tab-width: 4
+// indent-tabs-mode: nil
+// c-basic-offset: 4
+// End:
+// vim:sts=4:sw=4:ts=4:et:sr:cino=>s,f0,{0,g0,(0,\:0,t0,+0,=s
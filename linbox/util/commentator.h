@@ -46,6 +46,12 @@
 #include <streambuf>
 #include <fstream>
 #include <cstring>
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <thread>
+#include <chrono>
 
 //#include "linbox/util/timer.h"
 #include "givaro/givtimer.h"
@@ -90,8 +96,8 @@ namespace LinBox
 	class ActivityState {
 	public:
 
-		ActivityState (void *act) :
-			_act (act)
+		ActivityState (void *act, size_t depth = 0) :
+			_act (act), _depth (depth)
 		{}
 
 	private:
@@ -99,6 +105,7 @@ namespace LinBox
 		friend class Commentator;
 
 		void *_act;
+		size_t _depth; // depth of the stack of a thread that does not report
 	};
 
 	/** @brief Give information to user during runtime.
@@ -148,6 +155,11 @@ namespace LinBox
 	 *
 	 * The commentator allows very precise control over what gets
 	 * printed. See the Configuration section below.
+	 *
+	 * The commentator may be called from any thread.  Only the thread
+	 * that constructed it prints; every other thread has an activity
+	 * stack of its own and its reports go to a null stream.  The
+	 * activities of all the threads can be traced, see startTrace ().
 	 */
 	class Commentator {
 	public:
@@ -291,6 +303,8 @@ namespace LinBox
 
 		ActivityState saveActivityState () const
 		{
+			if (! isReportingThread ())
+				return ActivityState (0, workerActivities ().size ());
 		       	return ActivityState (_activities.top ());
 		}
 
@@ -306,6 +320,58 @@ namespace LinBox
 
 		void restoreActivityState (ActivityState state);
 
+		//@} Activity stack restoration
+
+		/** @internal
+		 * @name Trace of the activities.
+		 *
+		 * While tracing, each activity of each thread is recorded,
+		 * at its stop, in a buffer of its thread, without locking.
+		 * writeTrace outputs them as complete events in the Chrome
+		 * trace event format, to be read by chrome://tracing or
+		 * Perfetto.  Out of tracing, an activity of a thread that does
+		 * not report only costs a push and a pop.
+		 */
+
+		//@{
+
+		/** @internal
+		 * Start recording, discarding the previous trace.
+		 * No other thread may be in an activity meanwhile.
+		 */
+		void startTrace ();
+
+		/** @internal
+		 * Stop recording; the activities started before stop
+		 * are still recorded.
+		 */
+		void stopTrace ()
+		{
+			_tracing.store (false, std::memory_order_relaxed);
+		}
+
+		bool isTracing () const
+		{
+			return _tracing.load (std::memory_order_relaxed);
+		}
+
+		/** @internal
+		 * Write the recorded activities, as trace event JSON.
+		 * The traced threads must have stopped their activities.
+		 */
+		std::ostream &writeTrace (std::ostream &os) const;
+
+		/** @internal
+		 * Whether the calling thread is the one that prints, the
+		 * thread that constructed the commentator.
+		 */
+		bool isReportingThread () const
+		{
+			return std::this_thread::get_id () == _owner;
+		}
+
+		//@} Trace of the activities
+
 		/** @internal
 		 * @name Configuration
 		*/
@@ -460,6 +526,7 @@ namespace LinBox
 				const char *msg_class,
 				const char *fn = (const char *) 0)
 		{
+			if (! isReportingThread ()) return false;
 		       	return isPrinted (_activities.size (), level, msg_class, fn);
 		}
 
@@ -576,6 +643,7 @@ namespace LinBox
 		 */
 		bool printed (long msglevel, const char *msgclass)
 		{
+			if (! isReportingThread ()) return false;
 			return isPrinted (_activities.size (), (MessageLevel) msglevel, msgclass);
 		}
 
@@ -625,6 +693,19 @@ namespace LinBox
 
 		typedef std::deque<StepsAndTime> Estimator;
 
+		typedef std::chrono::steady_clock Clock;
+
+		// Start of an activity, for the trace
+		struct TraceStamp {
+			TraceStamp () :
+				_generation (0)
+			{}
+
+			unsigned long            _generation;      // 0 if not traced
+			Clock::time_point        _begin;
+			std::string              _name;
+		};
+
 		struct Activity {
 			Activity (const char *desc, const char *fn, unsigned long len) :
 				_desc (desc), _fn (fn), _len (len), _progress (0)
@@ -636,10 +717,52 @@ namespace LinBox
 			unsigned long            _progress;
 		 Givaro::RealTimer                    _timer;
 			Estimator                _estimate;
+			TraceStamp               _stamp;
 		};
 
 		std::stack<Activity *>           _activities;      // Stack of activity structures
 
+		// Activity of a thread that does not report
+		struct WorkerActivity {
+			WorkerActivity (const char *fn) :
+				_fn (fn)
+			{}
+
+			const char              *_fn;
+			TraceStamp               _stamp;
+		};
+
+		// The stack of the calling thread, when it does not report
+		static std::vector<WorkerActivity> &workerActivities ();
+
+		// Trace events of one thread, appended only by this thread
+		struct TraceBuffer {
+			TraceBuffer (size_t tid, bool reporting) :
+				_tid (tid), _reporting (reporting)
+			{}
+
+			struct Event {
+				std::string              _name;
+				std::string              _fn;
+				Clock::time_point        _begin;
+				Clock::time_point        _end;
+			};
+
+			size_t                   _tid;
+			bool                     _reporting;
+			std::vector<Event>       _events;
+		};
+
+		// Starts the trace of an activity, if tracing
+		void traceStart (TraceStamp &stamp, const char *description);
+		// Records an activity whose trace was started, if still tracing
+		void traceStop (const TraceStamp &stamp, const char *fn);
+		// The buffer of the calling thread for the current trace
+		TraceBuffer *traceBuffer ();
+
+		void startWorkerActivity (const char *description, const char *fn);
+		void stopWorkerActivity ();
+
 		struct C_str_Less {
 			bool operator() (const char* x, const char * y) const {
 				return strcmp(x,y)<0;
@@ -662,6 +785,13 @@ namespace LinBox
 
 		std::string                      _iteration_str;     // String referring to current iteration -- HACK
 
+		std::thread::id                  _owner;           // Thread that prints
+		std::atomic<bool>                _tracing;
+		std::atomic<unsigned long>       _generation;      // Number of the current trace
+		Clock::time_point                _traceOrigin;
+		mutable std::mutex               _traceMutex;      // Guards the list of buffers
+		std::vector<std::unique_ptr<TraceBuffer> > _traceBuffers;
+
 		// Functions for the brief report
 		virtual void printActivityReport  (Activity &activity);
 		virtual void updateActivityReport (Activity &activity);
@@ -954,6 +1084,17 @@ namespace LinBox
 		void restoreActivityState (ActivityState state)
 		{}
 
+		inline void startTrace ()
+		{}
+		inline void stopTrace ()
+		{}
+		inline bool isTracing () const
+		{ return false; }
+		inline std::ostream &writeTrace (std::ostream &os) const
+		{ return os << "{\"traceEvents\":[]}" << std::endl; }
+		inline bool isReportingThread () const
+		{ return true; }
+
 		std::ofstream cnull;
 
 	private:
@@ -42,6 +42,7 @@
 #include <cstring>
 #include <cstdlib>
 #include <cstdio>
+#include <iomanip>
 
 #include "linbox/util/commentator.h"
 #include "linbox/util/debug.h"
@@ -92,6 +93,7 @@ namespace LinBox
 		, _estimationMethod (BEST_ESTIMATE), _format (OUTPUT_CONSOLE),
 		_show_timing (true), _show_progress (true), _show_est_time (true)
 		,_last_line_len(0)
+		, _owner (std::this_thread::get_id ()), _tracing (false), _generation (0)
 	{
 		//registerMessageClass (BRIEF_REPORT,         std::clog, 1, LEVEL_IMPORTANT);
 		registerMessageClass (BRIEF_REPORT,         _report, 1, LEVEL_IMPORTANT);
@@ -110,6 +112,7 @@ namespace LinBox
 		, _estimationMethod (BEST_ESTIMATE), _format (OUTPUT_CONSOLE),
 		_show_timing (true), _show_progress (true), _show_est_time (true)
 		,_last_line_len(0)
+		, _owner (std::this_thread::get_id ()), _tracing (false), _generation (0)
 	{
 		//registerMessageClass (BRIEF_REPORT,         out, 1, LEVEL_IMPORTANT);
 		registerMessageClass (BRIEF_REPORT,         out, 1, LEVEL_IMPORTANT);
@@ -136,6 +139,11 @@ namespace LinBox
 
 	void Commentator::start (const char *description, const char *fn, unsigned long len)
 	{
+		if (! isReportingThread ()) {
+			startWorkerActivity (description, fn);
+			return;
+		}
+
 		if (fn == (const char *) 0 && _activities.size () > 0)
 			fn = _activities.top ()->_fn;
 
@@ -150,6 +158,7 @@ namespace LinBox
 
 		_activities.push (new_act);
 
+		traceStart (new_act->_stamp, description);
 		new_act->_timer.start ();
 	}
 
@@ -162,6 +171,12 @@ namespace LinBox
 	{
 		std::ostringstream str;
 
+		if (! isReportingThread ()) {
+			if (isTracing ()) str << "Iteration " << iter;
+			startWorkerActivity (str.str ().c_str (), (const char *) 0);
+			return;
+		}
+
 		str << "Iteration " << iter << std::ends;
 
 		_iteration_str = str.str ();
@@ -173,6 +188,11 @@ namespace LinBox
 		double realtime; //, usertime, systime;
 		Activity *top_act;
 
+		if (! isReportingThread ()) {
+			stopWorkerActivity ();
+			return;
+		}
+
 		linbox_check (_activities.top () != (Activity *) 0);
 		linbox_check (msg != (const char *) 0);
 
@@ -202,6 +222,7 @@ namespace LinBox
 
 		fn = top_act->_fn;
 
+		traceStop (top_act->_stamp, fn);
 		_activities.pop ();
 
 		if (isPrinted (_activities.size (), LEVEL_IMPORTANT, BRIEF_REPORT, fn))
@@ -233,6 +254,8 @@ namespace LinBox
 
 	void Commentator::progress (long k, long len)
 	{
+		if (! isReportingThread ()) return;
+
 		linbox_check (_activities.top () != (Activity *) 0);
 
 		Activity *act = _activities.top ();
@@ -265,6 +288,12 @@ namespace LinBox
 	{
 		linbox_check (msg_class != (const char *) 0);
 
+		if (! isReportingThread ()) {
+			// a stream without buffer, that prints nothing
+			static thread_local std::ostream nowhere ((std::streambuf *) 0);
+			return nowhere;
+		}
+
 	    _report << "$$(" << _activities.size () << ", " << level << ", " << msg_class << ")";
 #if 0
 	    if (!isPrinted (_activities.size (), level, msg_class,
@@ -282,6 +311,8 @@ namespace LinBox
 	{
 		unsigned int i;
 
+		if (! isReportingThread ()) return;
+
 		for (i = 0; i < _activities.size (); ++i)
 			stream << "  ";
 	}
@@ -290,6 +321,13 @@ namespace LinBox
 	{
 		std::stack<Activity *> backup;
 
+		if (! isReportingThread ()) {
+			std::vector<WorkerActivity> &acts = workerActivities ();
+			if (state._depth < acts.size ())
+				acts.erase (acts.begin () + (long) state._depth, acts.end ());
+			return;
+		}
+
 		while (!_activities.empty () && _activities.top () != state._act) {
 			backup.push (_activities.top ());
 			_activities.pop ();
@@ -305,6 +343,137 @@ namespace LinBox
 		}
 	}
 
+	std::vector<Commentator::WorkerActivity> &Commentator::workerActivities ()
+	{
+		static thread_local std::vector<WorkerActivity> acts;
+		return acts;
+	}
+
+	void Commentator::startWorkerActivity (const char *description, const char *fn)
+	{
+		std::vector<WorkerActivity> &acts = workerActivities ();
+		if (fn == (const char *) 0 && acts.size () > 0)
+			fn = acts.back ()._fn;
+		acts.push_back (WorkerActivity (fn));
+		traceStart (acts.back ()._stamp, description);
+	}
+
+	void Commentator::stopWorkerActivity ()
+	{
+		std::vector<WorkerActivity> &acts = workerActivities ();
+		linbox_check (! acts.empty ());
+		traceStop (acts.back ()._stamp, acts.back ()._fn);
+		acts.pop_back ();
+	}
+
+	void Commentator::startTrace ()
+	{
+		{
+			std::lock_guard<std::mutex> lock (_traceMutex);
+			_traceBuffers.clear ();
+			_traceOrigin = Clock::now ();
+			++_generation;
+		}
+		_tracing.store (true, std::memory_order_release);
+		// the reporting thread first
+		if (isReportingThread ()) traceBuffer ();
+	}
+
+	void Commentator::traceStart (TraceStamp &stamp, const char *description)
+	{
+		if (! isTracing ()) {
+			stamp._generation = 0;
+			return;
+		}
+		stamp._generation = _generation.load (std::memory_order_acquire);
+		stamp._name = description;
+		stamp._begin = Clock::now ();
+	}
+
+	void Commentator::traceStop (const TraceStamp &stamp, const char *fn)
+	{
+		if (stamp._generation == 0 || stamp._generation != _generation.load (std::memory_order_acquire))
+			return;
+		TraceBuffer::Event e;
+		e._end = Clock::now ();
+		e._begin = stamp._begin;
+		e._name = stamp._name;
+		if (fn != (const char *) 0) e._fn = fn;
+		traceBuffer ()->_events.push_back (e);
+	}
+
+	Commentator::TraceBuffer *Commentator::traceBuffer ()
+	{
+		// the buffer of this thread for the last trace it wrote in
+		struct Cache {
+			const Commentator *_comm;
+			unsigned long      _generation;
+			TraceBuffer       *_buffer;
+		};
+		static thread_local Cache cache = { (const Commentator *) 0, 0, (TraceBuffer *) 0 };
+
+		const unsigned long g = _generation.load (std::memory_order_acquire);
+		if (cache._comm != this || cache._generation != g) {
+			std::lock_guard<std::mutex> lock (_traceMutex);
+			_traceBuffers.emplace_back (new TraceBuffer (_traceBuffers.size (), isReportingThread ()));
+			cache._comm = this;
+			cache._generation = g;
+			cache._buffer = _traceBuffers.back ().get ();
+		}
+		return cache._buffer;
+	}
+
+	// s as a JSON string
+	inline std::ostream &writeJSONString (std::ostream &os, const std::string &s)
+	{
+		os << '"';
+		for (size_t i = 0; i < s.size (); ++i) {
+			const unsigned char c = (unsigned char) s[i];
+			if (c == '"' || c == '\\')
+				os << '\\' << c;
+			else if (c < 0x20) {
+				char u[8];
+				std::snprintf (u, sizeof (u), "\\u%04x", c);
+				os << u;
+			}
+			else
+				os << c;
+		}
+		return os << '"';
+	}
+
+	std::ostream &Commentator::writeTrace (std::ostream &os) const
+	{
+		typedef std::chrono::duration<double, std::micro> Microseconds;
+		std::lock_guard<std::mutex> lock (_traceMutex);
+
+		const std::ios::fmtflags flags = os.flags ();
+		const std::streamsize precision = os.precision ();
+		os << std::fixed << std::setprecision (3);
+
+		os << "{\"traceEvents\":[";
+		const char *sep = "\n";
+		for (size_t b = 0; b < _traceBuffers.size (); ++b) {
+			const TraceBuffer &buf = *_traceBuffers[b];
+			os << sep << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << buf._tid
+			   << ",\"args\":{\"name\":\"" << (buf._reporting ? "reporting " : "worker ") << buf._tid << "\"}}";
+			sep = ",\n";
+			for (size_t k = 0; k < buf._events.size (); ++k) {
+				const TraceBuffer::Event &e = buf._events[k];
+				writeJSONString (os << sep << "{\"name\":", e._name);
+				writeJSONString (os << ",\"cat\":", e._fn.empty () ? std::string ("linbox") : e._fn);
+				os << ",\"ph\":\"X\",\"pid\":1,\"tid\":" << buf._tid
+				   << ",\"ts\":" << Microseconds (e._begin - _traceOrigin).count ()
+				   << ",\"dur\":" << Microseconds (e._end - e._begin).count () << '}';
+			}
+		}
+		os << "\n],\"displayTimeUnit\":\"ms\"}" << std::endl;
+
+		os.flags (flags);
+		os.precision (precision);
+		return os;
+	}
+
 	void Commentator::setMaxDepth (long depth)
 	{
 		MessageClass &briefReportClass = getMessageClass (BRIEF_REPORT);
@@ -379,6 +548,9 @@ namespace LinBox
 
 	bool Commentator::isPrinted (unsigned long depth, unsigned long level, const char *msg_class, const char *fn)
 	{
+		if (! isReportingThread ())
+			return false;
+
 		if (_messageClasses.find (msg_class) == _messageClasses.end ())
 			return false;
 
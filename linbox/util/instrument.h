@@ -0,0 +1,434 @@
+/* linbox/util/instrument.h
+ *
+ * ========LICENCE========
+ * This file is part of the library LinBox.
+ *
+ * LinBox is free software: you can redistribute it and/or modify
+ * it under the terms of the  GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ * ========LICENCE========
+ */
+
+/*! @file util/instrument.h
+ * @ingroup util
+ * @brief Named scopes measuring wall time, CPU time and hardware counters.
+ *
+ * A scope is declared in a kernel with
+ \code
+ LINBOX_INSTRUMENT_SCOPE ("blackbox apply");
+ \endcode
+ * and measures, when instruments() is enabled, until the end of the
+ * block.  The measures are summed per name over all the calls and
+ * threads, and instruments().write () prints them.
+ *
+ * Setting the environment variable LINBOX_INSTRUMENT to a comma
+ * separated list of \c wall, \c cpu, \c counters (or \c all) enables
+ * them at startup and prints the table on std::cerr at exit.  The
+ * counters (cycles, instructions, cache references and misses, branch
+ * misses) are read with perf_event on Linux; elsewhere, or when the
+ * kernel refuses them, they are not reported.
+ *
+ * Disabled, a scope costs one relaxed atomic load; defining
+ * LINBOX_DISABLE_INSTRUMENT removes the scopes entirely.
+ */
+
+#ifndef __LINBOX_util_instrument_H
+#define __LINBOX_util_instrument_H
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <string>
+#include <vector>
+#include <map>
+#include <unordered_map>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <unistd.h>
+#endif
+
+#if defined(__linux__) && !defined(LINBOX_NO_PERF_EVENT)
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <sys/ioctl.h>
+#define __LINBOX_HAVE_PERF_EVENT 1
+#endif
+
+#include "linbox/linbox-config.h"
+
+namespace LinBox
+{
+
+	/** @brief Hardware event counters of the calling thread.
+	 * \ingroup util
+	 *
+	 * The events are opened as one perf_event group, counting in user
+	 * space only, and read together.  available() is false where
+	 * perf_event is missing or not permitted; an event the processor
+	 * lacks reads as 0.
+	 */
+	class PerfCounters {
+	public:
+		enum Event {
+			CYCLES,
+			INSTRUCTIONS,
+			CACHE_REFERENCES,
+			CACHE_MISSES,
+			BRANCH_MISSES,
+			NB_EVENTS
+		};
+
+		static const char *name (size_t e)
+		{
+			static const char *names[NB_EVENTS] =
+				{ "cycles", "instructions", "cache-refs", "cache-misses", "branch-misses" };
+			return names[e];
+		}
+
+		PerfCounters () :
+			_count (0)
+		{
+			for (size_t e = 0; e < NB_EVENTS; ++e) {
+				_fd[e] = -1;
+				_slot[e] = -1;
+			}
+#ifdef __LINBOX_HAVE_PERF_EVENT
+			static const uint64_t config[NB_EVENTS] = {
+				PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS,
+				PERF_COUNT_HW_CACHE_REFERENCES, PERF_COUNT_HW_CACHE_MISSES,
+				PERF_COUNT_HW_BRANCH_MISSES };
+			for (size_t e = 0; e < NB_EVENTS; ++e) {
+				struct perf_event_attr attr;
+				memset (&attr, 0, sizeof (attr));
+				attr.size = sizeof (attr);
+				attr.type = PERF_TYPE_HARDWARE;
+				attr.config = config[e];
+				attr.disabled = (_fd[0] < 0) ? 1 : 0;
+				attr.exclude_kernel = 1;
+				attr.exclude_hv = 1;
+				attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+				const int leader = (_count == 0) ? -1 : _fd[0];
+				const int fd = (int) syscall (__NR_perf_event_open, &attr, 0, -1, leader, 0);
+				if (fd < 0) {
+					if (_count == 0 && e == CYCLES) return; // no perf_event at all
+					continue;
+				}
+				if (_count == 0) _fd[0] = fd; else _fd[e] = fd;
+				_slot[e] = (int) _count++;
+			}
+			ioctl (_fd[0], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+			ioctl (_fd[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+#endif
+		}
+
+		~PerfCounters ()
+		{
+#ifdef __LINBOX_HAVE_PERF_EVENT
+			for (size_t e = 0; e < NB_EVENTS; ++e)
+				if (_fd[e] >= 0) close (_fd[e]);
+#endif
+		}
+
+		bool available () const { return _count > 0; }
+
+		//! current values, scaled when the group was multiplexed
+		void read (uint64_t v[NB_EVENTS]) const
+		{
+			for (size_t e = 0; e < NB_EVENTS; ++e) v[e] = 0;
+#ifdef __LINBOX_HAVE_PERF_EVENT
+			if (! available ()) return;
+			uint64_t buf[3 + NB_EVENTS];
+			if (::read (_fd[0], buf, sizeof (buf)) < (ssize_t) ((3 + _count) * sizeof (uint64_t)))
+				return;
+			const double scale = (buf[2] > 0 && buf[2] < buf[1]) ? (double) buf[1] / (double) buf[2] : 1.;
+			for (size_t e = 0; e < NB_EVENTS; ++e)
+				if (_slot[e] >= 0)
+					v[e] = (uint64_t) ((double) buf[3 + _slot[e]] * scale);
+#endif
+		}
+
+	private:
+		PerfCounters (const PerfCounters &);
+		PerfCounters &operator= (const PerfCounters &);
+
+		int    _fd[NB_EVENTS];   // _fd[0] is the group leader
+		int    _slot[NB_EVENTS]; // rank of the event in a group read, or -1
+		size_t _count;
+	};
+
+	/** @brief Measures of the instrumented scopes.
+	 * \ingroup util
+	 *
+	 * There is one, instruments().  Each thread sums its measures in a
+	 * table of its own, without locking; write () and collect () merge
+	 * them, and should be called when the measured threads are done.
+	 */
+	class Instruments {
+	public:
+		//! what the scopes measure
+		enum Measure {
+			WALL     = 1,
+			CPU      = 2,
+			COUNTERS = 4,
+			ALL      = 7
+		};
+
+		struct Stats {
+			Stats () :
+				calls (0), wall (0.), cpu (0.), counted (0)
+			{
+				for (size_t e = 0; e < PerfCounters::NB_EVENTS; ++e) counters[e] = 0;
+			}
+
+			Stats &operator+= (const Stats &s)
+			{
+				calls += s.calls; wall += s.wall; cpu += s.cpu; counted += s.counted;
+				for (size_t e = 0; e < PerfCounters::NB_EVENTS; ++e) counters[e] += s.counters[e];
+				return *this;
+			}
+
+			uint64_t calls;
+			double   wall;     //!< seconds
+			double   cpu;      //!< seconds of the thread
+			uint64_t counted;  //!< calls measured by the counters
+			uint64_t counters[PerfCounters::NB_EVENTS];
+		};
+
+		//! the measures of one thread, by name
+		typedef std::unordered_map<const char *, Stats> Table;
+
+		Instruments () :
+			_measures (0), _generation (1), _dump (false)
+		{
+			const char *env = std::getenv ("LINBOX_INSTRUMENT");
+			if (env == (const char *) 0 || *env == 0) return;
+			const std::string s (env);
+			unsigned m = 0;
+			if (s.find ("wall") != std::string::npos) m |= WALL;
+			if (s.find ("cpu") != std::string::npos) m |= CPU;
+			if (s.find ("counters") != std::string::npos) m |= COUNTERS;
+			if (s.find ("all") != std::string::npos || m == 0) m = ALL;
+			enable (m);
+			_dump = true;
+		}
+
+		~Instruments ()
+		{
+			if (_dump) write (std::cerr);
+		}
+
+		void enable (unsigned measures = ALL) { _measures.store (measures, std::memory_order_relaxed); }
+		void disable () { _measures.store (0, std::memory_order_relaxed); }
+		unsigned measures () const { return _measures.load (std::memory_order_relaxed); }
+		bool isEnabled () const { return measures () != 0; }
+
+		//! print the table on std::cerr at exit
+		void dumpAtExit (bool dump = true) { _dump = dump; }
+
+		//! discards the measures; no scope may be open meanwhile
+		void clear ()
+		{
+			std::lock_guard<std::mutex> lock (_mutex);
+			_tables.clear ();
+			++_generation;
+		}
+
+		//! the measures of all threads, by name
+		std::map<std::string, Stats> collect () const
+		{
+			std::lock_guard<std::mutex> lock (_mutex);
+			std::map<std::string, Stats> all;
+			for (size_t t = 0; t < _tables.size (); ++t)
+				for (Table::const_iterator it = _tables[t]->begin (); it != _tables[t]->end (); ++it)
+					all[it->first] += it->second;
+			return all;
+		}
+
+		//! the measures, by decreasing wall time
+		std::ostream &write (std::ostream &os) const
+		{
+			const std::map<std::string, Stats> all = collect ();
+			std::vector<std::pair<std::string, Stats> > rows (all.begin (), all.end ());
+			std::sort (rows.begin (), rows.end (),
+				   [] (const std::pair<std::string, Stats> &a, const std::pair<std::string, Stats> &b)
+				   { return a.second.wall > b.second.wall; });
+			bool counted = false;
+			for (size_t r = 0; r < rows.size (); ++r)
+				counted = counted || rows[r].second.counted > 0;
+
+			const std::ios::fmtflags flags = os.flags ();
+			const std::streamsize precision = os.precision ();
+			os << std::left << std::setw (32) << "scope" << std::right
+			   << std::setw (10) << "calls" << std::setw (12) << "wall (s)" << std::setw (12) << "cpu (s)";
+			if (counted)
+				os << std::setw (16) << "cycles" << std::setw (16) << "instructions" << std::setw (7) << "IPC"
+				   << std::setw (14) << "cache-misses" << std::setw (8) << "miss%" << std::setw (14) << "branch-misses";
+			os << std::endl;
+			os << std::fixed;
+			for (size_t r = 0; r < rows.size (); ++r) {
+				const Stats &s = rows[r].second;
+				os << std::left << std::setw (32) << rows[r].first << std::right
+				   << std::setw (10) << s.calls << std::setprecision (4)
+				   << std::setw (12) << s.wall << std::setw (12) << s.cpu;
+				if (counted && s.counted > 0) {
+					const uint64_t *c = s.counters;
+					os << std::setw (16) << c[PerfCounters::CYCLES]
+					   << std::setw (16) << c[PerfCounters::INSTRUCTIONS] << std::setprecision (2)
+					   << std::setw (7) << (c[PerfCounters::CYCLES] ? (double) c[PerfCounters::INSTRUCTIONS] / (double) c[PerfCounters::CYCLES] : 0.)
+					   << std::setw (14) << c[PerfCounters::CACHE_MISSES] << std::setprecision (1)
+					   << std::setw (8) << (c[PerfCounters::CACHE_REFERENCES] ? 100. * (double) c[PerfCounters::CACHE_MISSES] / (double) c[PerfCounters::CACHE_REFERENCES] : 0.)
+					   << std::setw (14) << c[PerfCounters::BRANCH_MISSES];
+				}
+				os << std::endl;
+			}
+			os.flags (flags);
+			os.precision (precision);
+			return os;
+		}
+
+		//! the table of the calling thread
+		Table &table ()
+		{
+			struct Cache {
+				const Instruments *_owner;
+				unsigned long      _generation;
+				Table             *_table;
+			};
+			static thread_local Cache cache = { (const Instruments *) 0, 0, (Table *) 0 };
+			const unsigned long g = _generation.load (std::memory_order_acquire);
+			if (cache._owner != this || cache._generation != g) {
+				std::lock_guard<std::mutex> lock (_mutex);
+				_tables.emplace_back (new Table);
+				cache._owner = this;
+				cache._generation = g;
+				cache._table = _tables.back ().get ();
+			}
+			return *cache._table;
+		}
+
+		//! the counters of the calling thread, opened at its first call
+		static const PerfCounters &counters ()
+		{
+			static thread_local PerfCounters c;
+			return c;
+		}
+
+	private:
+		std::atomic<unsigned>                 _measures;
+		std::atomic<unsigned long>            _generation;
+		bool                                  _dump;
+		mutable std::mutex                    _mutex;    // guards the list of tables
+		std::vector<std::unique_ptr<Table> >  _tables;
+	};
+
+	//! The measures of the instrumented scopes
+	inline Instruments &instruments ()
+	{
+		static Instruments internal_static_instruments;
+		return internal_static_instruments;
+	}
+
+	/** @brief Measures its lifetime under a name, if instruments() is enabled.
+	 * \ingroup util
+	 *
+	 * The name must be a string of static storage, such as a literal.
+	 * Nested scopes are measured inclusively.
+	 */
+	class InstrumentScope {
+	public:
+		typedef std::chrono::steady_clock Clock;
+
+		explicit InstrumentScope (const char *name) :
+			_name (name), _measures (instruments ().measures ())
+		{
+			if (! _measures) return;
+			if (_measures & Instruments::COUNTERS)
+				Instruments::counters ().read (_counters);
+			if (_measures & Instruments::CPU)
+				_cpu = threadTime ();
+			if (_measures & Instruments::WALL)
+				_wall = Clock::now ();
+		}
+
+		~InstrumentScope ()
+		{
+			if (! _measures) return;
+			Instruments::Stats s;
+			s.calls = 1;
+			if (_measures & Instruments::WALL)
+				s.wall = std::chrono::duration<double> (Clock::now () - _wall).count ();
+			if (_measures & Instruments::CPU)
+				s.cpu = threadTime () - _cpu;
+			if ((_measures & Instruments::COUNTERS) && Instruments::counters ().available ()) {
+				uint64_t c[PerfCounters::NB_EVENTS];
+				Instruments::counters ().read (c);
+				for (size_t e = 0; e < PerfCounters::NB_EVENTS; ++e)
+					s.counters[e] = c[e] - _counters[e];
+				s.counted = 1;
+			}
+			instruments ().table ()[_name] += s;
+		}
+
+		//! CPU time of the calling thread, in seconds
+		static double threadTime ()
+		{
+#if defined(_POSIX_THREAD_CPUTIME) && (_POSIX_THREAD_CPUTIME >= 0)
+			struct timespec t;
+			clock_gettime (CLOCK_THREAD_CPUTIME_ID, &t);
+			return (double) t.tv_sec + 1e-9 * (double) t.tv_nsec;
+#else
+			return (double) std::clock () / CLOCKS_PER_SEC;
+#endif
+		}
+
+	private:
+		InstrumentScope (const InstrumentScope &);
+		InstrumentScope &operator= (const InstrumentScope &);
+
+		const char        *_name;
+		const unsigned     _measures;
+		Clock::time_point  _wall;
+		double             _cpu;
+		uint64_t           _counters[PerfCounters::NB_EVENTS];
+	};
+
+}
+
+#define __LINBOX_INSTRUMENT_CAT2(a, b) a##b
+#define __LINBOX_INSTRUMENT_CAT(a, b) __LINBOX_INSTRUMENT_CAT2(a, b)
+
+#ifdef LINBOX_DISABLE_INSTRUMENT
+#define LINBOX_INSTRUMENT_SCOPE(name)
+#else
+//! measures the rest of the enclosing block under name
+#define LINBOX_INSTRUMENT_SCOPE(name) \
+	LinBox::InstrumentScope __LINBOX_INSTRUMENT_CAT(linbox_instrument_scope_, __LINE__) (name)
+#endif
+
+#endif // __LINBOX_util_instrument_H
+
+// Local Variables:
+// mode: C++
+// tab-width: 4
+// indent-tabs-mode: nil
+// c-basic-offset: 4
+// End:
+// vim:sts=4:sw=4:ts=4:et:sr:cino=>s,f0,{0,g0,(0,\:0,t0,+0,=s
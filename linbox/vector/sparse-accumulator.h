@@ -0,0 +1,185 @@
+/* linbox/vector/sparse-accumulator.h
+ *
+ * ========LICENCE========
+ * This file is part of the library LinBox.
+ *
+ * LinBox is free software: you can redistribute it and/or modify
+ * it under the terms of the  GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ * ========LICENCE========
+ */
+
+/*! @file vector/sparse-accumulator.h
+ * @ingroup vector
+ * @brief Dense accumulator for sparse row operations.
+ *
+ * A sparse accumulator (SPA) holds one row being updated scattered in a
+ * dense array, with the list of its nonzero positions.  Row updates
+ * \f$v \gets v + a x\f$ then cost one access per entry of \f$x\f$,
+ * without the merge of two sorted sequences nor an allocation; the row
+ * is written back, sorted, once all updates are done.  The entries are
+ * FieldAXPY accumulators, so word-size modular fields reduce lazily.
+ */
+
+#ifndef __LINBOX_vector_sparse_accumulator_H
+#define __LINBOX_vector_sparse_accumulator_H
+
+#include <vector>
+#include <algorithm>
+
+#include "linbox/linbox-config.h"
+#include "linbox/util/debug.h"
+#include "linbox/util/field-axpy.h"
+
+namespace LinBox
+{
+
+	/** @brief Scattered dense accumulator for sparse sequence rows.
+	 * \ingroup vector
+	 *
+	 * Rows are sequences of (index, value) pairs sorted by index, as
+	 * the rows of SparseMatrix<Field, SparseMatrixFormat::SparseSeq>.
+	 * The accumulator is meant to be kept for a whole elimination:
+	 * scatter() only touches the positions of the row.
+	 */
+	template <class Field>
+	class SparseAccumulator {
+	public:
+		typedef typename Field::Element Element;
+
+		//! accumulator for rows of n entries
+		SparseAccumulator (const Field &F, size_t n = 0) :
+			_field (&F), _stamp (0), _updates (0)
+		{
+			resize (n);
+		}
+
+		const Field &field () const { return *_field; }
+
+		void resize (size_t n)
+		{
+			_acc.resize (n, FieldAXPY<Field> (field ()));
+			_mark.resize (n, 0);
+		}
+
+		size_t size () const { return _acc.size (); }
+
+		//! starts the update of the row v
+		template <class Vector>
+		void scatter (const Vector &v)
+		{
+			++_stamp;
+			_updates = 0;
+			_idx.clear ();
+			_fill.clear ();
+			for (size_t k = 0; k < v.size (); ++k) {
+				const size_t c = (size_t)v[k].first;
+				linbox_check (c < size ());
+				_acc[c].reset ();
+				_acc[c].accumulate (v[k].second);
+				_mark[c] = _stamp;
+				_idx.push_back (c);
+			}
+		}
+
+		//! row += a x, for the entries of x from position \p from on
+		template <class Vector>
+		void axpy (const Element &a, const Vector &x, size_t from = 0)
+		{
+			++_updates;
+			for (size_t k = from; k < x.size (); ++k) {
+				const size_t c = (size_t)x[k].first;
+				linbox_check (c < size ());
+				if (_mark[c] != _stamp) {
+					_mark[c] = _stamp;
+					_acc[c].reset ();
+					_fill.push_back (c);
+				}
+				_acc[c].mulacc (a, x[k].second);
+			}
+		}
+
+		//! sets the entry in column c to zero, e.g. below a pivot
+		void cancel (size_t c)
+		{
+			if (_mark[c] == _stamp)
+				_acc[c].reset ();
+		}
+
+		//! writes the row back in v, sorted, without its zeros
+		template <class Vector>
+		void gather (Vector &v)
+		{
+			gatherCount (v, (std::vector<size_t> *)0);
+		}
+
+		/** Same, updating the number of entries per column: decremented
+		 * for the entries which vanished, incremented for the fill-in.
+		 */
+		template <class Vector, class D>
+		void gather (Vector &v, D &columns)
+		{
+			gatherCount (v, &columns);
+		}
+
+	protected:
+		template <class Vector, class D>
+		void gatherCount (Vector &v, D *columns)
+		{
+			typedef typename Vector::value_type E;
+			typedef typename E::first_type E1;
+
+			// fill-in columns are sorted if they come from one row
+			if (_updates > 1)
+				std::sort (_fill.begin (), _fill.end ());
+
+			v.resize (_idx.size () + _fill.size ());
+			size_t a = 0, b = 0, j = 0;
+			Element t;
+			while ((a < _idx.size ()) || (b < _fill.size ())) {
+				const bool old = (b == _fill.size ())
+					|| ((a < _idx.size ()) && (_idx[a] < _fill[b]));
+				const size_t c = old ? _idx[a++] : _fill[b++];
+				_acc[c].get (t);
+				if (! field ().isZero (t))
+					v[j++] = E ((E1)c, t);
+				if (columns) {
+					if (old && field ().isZero (t))
+						--(*columns)[c];
+					else if (!old && !field ().isZero (t))
+						++(*columns)[c];
+				}
+			}
+			v.resize (j);
+		}
+
+		const Field                     *_field;
+		std::vector<FieldAXPY<Field> >     _acc;
+		std::vector<size_t>               _mark;
+		size_t                           _stamp;
+		size_t                         _updates; // axpy since scatter
+		std::vector<size_t>                _idx; // columns of the row
+		std::vector<size_t>               _fill; // new columns
+	};
+
+}
+
+#endif // __LINBOX_vector_sparse_accumulator_H
+
+// Local Variables:
+// mode: C++
+// tab-width: 4
+// indent-tabs-mode: nil
+// c-basic-offset: 4
+// End:
+// vim:sts=4:sw=4:ts=4:et:sr:cino=>s,f0,{0,g0,(0,\:0,t0,+0,=s
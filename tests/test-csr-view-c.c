@@ -0,0 +1,50 @@
+/* tests/test-csr-view-c.c
+ *
+ * ========LICENCE========
+ * This file is part of the library LinBox.
+ *
+ * LinBox is free software: you can redistribute it and/or modify
+ * it under the terms of the  GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ * ========LICENCE========
+ */
+
+/*! @file  tests/test-csr-view-c.c
+ * @ingroup tests
+ * @brief  The CSR part of the Sage interface, compiled as C.
+ * @test used by test-csr-view.C, which checks the descriptor built here.
+ */
+
+#include "interfaces/sage/linbox-sage.h"
+
+/* a linbox_csr_matrix of uint32_t values, described from C */
+struct linbox_csr_matrix test_csr_view_c_matrix (size_t rows, size_t cols, const size_t *start,
+						 const size_t *colid, const uint32_t *values)
+{
+	struct linbox_csr_matrix A;
+	A.rows = rows;
+	A.cols = cols;
+	A.start = start;
+	A.colid = colid;
+	A.values = values;
+	A.type = LINBOX_CSR_UINT32;
+	return A;
+}
+
+/* Local Variables: */
+/* mode: C */
+/* tab-width: 4 */
+/* indent-tabs-mode: nil */
+/* c-basic-offset: 4 */
+/* End: */
+/* vim:sts=4:sw=4:ts=4:et:sr:cino=>s,f0,{0,g0,(0,\:0,t0,+0,=s */
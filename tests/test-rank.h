@@ -39,7 +39,6 @@ bool testZeroAndIdentRank (const Field &F, size_t n, unsigned int iterations = 1
 
 #include "linbox/linbox-config.h"
 
-#define LINBOX_USE_BLACKBOX_THRESHOLD 100
 #define LINBOX_COO_TRANSPOSE 100 /*  this is supposed to be triggerd half the time */
 #define LINBOX_CSR_TRANSPOSE 100 /*  this is supposed to be triggerd half the time */
 #define LINBOX_ELL_TRANSPOSE 100 /*  this is supposed to be triggerd half the time */
@@ -108,13 +107,26 @@ bool testRankMethods(const typename BlackBox::Field & F, size_t n, size_t m, uns
 		equalRank = equalRank and rank_blackbox == rank_elimination;
 #endif
 
-#if 0
-		Method::Hybrid MH;
-		LinBox::rank (rank_hybrid, A, MH);
-		commentator().report (Commentator::LEVEL_IMPORTANT, INTERNAL_ERROR)
-			<< "hybrid rank " << rank_hybrid << endl;
-		equalRank = equalRank and rank_hybrid == rank_elimination;
-#endif
+		// each path of Method::Hybrid, forced by its cost constants
+		const HybridCosts costs = HybridCosts::machine();
+		const HybridDecision::Path paths[3] = {
+			HybridDecision::BLACKBOX, HybridDecision::SPARSE_ELIMINATION, HybridDecision::DENSE_ELIMINATION };
+		for (size_t p = 0; p < 3; ++p) {
+			unsigned long rank_hybrid;
+			HybridCosts::use (HybridCosts::forcing (paths[p]));
+			Method::Hybrid MH;
+			LinBox::rank (rank_hybrid, A, MH);
+			const HybridDecision &D = HybridDispatcher::last ();
+			commentator().report ()
+				<< endl << "hybrid rank by " << D.name () << " " << rank_hybrid << endl;
+			equalRank = equalRank and rank_hybrid == rank_elimination;
+			// dense elimination is only available over small prime fields
+			if (D.path != paths[p] and (paths[p] != HybridDecision::DENSE_ELIMINATION or hybridBlasField (F))) {
+				commentator().report () << "ERROR: hybrid did not take the forced path" << endl;
+				ret = false;
+			}
+		}
+		HybridCosts::use (costs);
 #if 0
 		unsigned long rank_Wiedemann;
 		Method::Wiedemann MW;  // rank soln needs fixing for this.